@@ -0,0 +1,111 @@
+#include "Arena.h"
+#include <cstdint>
+
+/*
+* @brief RXgN^
+* @param[in] blockSize xɊmۂubÑTCY
+*/
+Arena::Arena(size_t blockSize)
+	: m_pHead(nullptr)
+	, m_blockSize(blockSize)
+	, m_allocNum(0)
+	, m_usedSize(0)
+{
+}
+
+/*
+* @brief fXgN^
+*/
+Arena::~Arena()
+{
+	Clear();
+}
+
+/*
+* @brief ̈m
+* @param[in] size mۂTCY
+* @param[in] align ACg(2ׂ̂
+* @return mۂ̈
+*/
+void* Arena::Alloc(size_t size, size_t align)
+{
+	if (size == 0) { size = 1; }
+
+	// ݂̃ubNɎ܂邩mF
+	if (m_pHead)
+	{
+		uintptr_t base = reinterpret_cast<uintptr_t>(m_pHead + 1);
+		uintptr_t top = (base + m_pHead->used + align - 1) & ~(uintptr_t)(align - 1);
+		if (top + size <= base + m_pHead->size)
+		{
+			m_usedSize += size;
+			m_pHead->used = top + size - base;
+			return reinterpret_cast<void*>(top);
+		}
+	}
+
+	// VubNm(WTCY傫ꍇ͐p̃ubN
+	size_t blockSize = size + align > m_blockSize ? size + align : m_blockSize;
+	Block* pBlock = AllocBlock(blockSize);
+	uintptr_t base = reinterpret_cast<uintptr_t>(pBlock + 1);
+	uintptr_t top = (base + align - 1) & ~(uintptr_t)(align - 1);
+	pBlock->used = top + size - base;
+	m_usedSize += size;
+	return reinterpret_cast<void*>(top);
+}
+
+/*
+* @brief mۍςݗׂ̈ĉ
+*/
+void Arena::Clear()
+{
+	while (m_pHead)
+	{
+		Block* pNext = m_pHead->pNext;
+		::operator delete(m_pHead);
+		m_pHead = pNext;
+	}
+	m_usedSize = 0;
+}
+
+/*
+* @brief q[vmۂubN̐
+*/
+size_t Arena::GetAllocNum() const
+{
+	return m_allocNum;
+}
+
+/*
+* @brief gp̃TCY
+*/
+size_t Arena::GetUsedSize() const
+{
+	return m_usedSize;
+}
+
+/*
+* @brief ubN̊m
+* @param[in] size f[^̃TCY
+* @return mۂubN
+*/
+Arena::Block* Arena::AllocBlock(size_t size)
+{
+	Block* pBlock = reinterpret_cast<Block*>(::operator new(sizeof(Block) + size));
+	pBlock->size = size;
+	pBlock->used = 0;
+
+	// c̏ȂubN擪ɎcȂ悤A傫ubN͌ւȂ
+	if (m_pHead && size > m_blockSize)
+	{
+		pBlock->pNext = m_pHead->pNext;
+		m_pHead->pNext = pBlock;
+	}
+	else
+	{
+		pBlock->pNext = m_pHead;
+		m_pHead = pBlock;
+	}
+	++m_allocNum;
+	return pBlock;
+}
@@ -0,0 +1,55 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <cstddef>
+#include <new>
+
+/*
+* @brief ǂݍݏȂǂňꎞIɎgp̈܂Ƃ߂ĊmۂAP[^[
+*  ʂ̉͂łAj(Clear)ɂ܂Ƃ߂ĉ
+*/
+class Arena
+{
+public:
+	Arena(size_t blockSize = 256 * 1024);
+	~Arena();
+
+	// ̈m(g͖
+	void* Alloc(size_t size, size_t align = alignof(std::max_align_t));
+	template<class T> T* Alloc(size_t num);
+	// mۍςݗׂ̈ĉ
+	void Clear();
+
+	// q[vmۂubN̐
+	size_t GetAllocNum() const;
+	// gp̃TCY
+	size_t GetUsedSize() const;
+
+private:
+	struct Block
+	{
+		Block*	pNext;	// OɊmۂubN
+		size_t	size;	// f[^̃TCY
+		size_t	used;	// gpς݃TCY
+	};
+	Block* AllocBlock(size_t size);
+
+private:
+	Block*	m_pHead;		// ݊蓖Ē̃ubN
+	size_t	m_blockSize;	// W̃ubNTCY
+	size_t	m_allocNum;		// q[v̊mۉ
+	size_t	m_usedSize;		// gp̃TCY
+};
+
+/*
+* @brief ^ẅ̗m
+* @param[in] num vf
+* @return mۂ̈(RXgN^͌Ă΂Ȃ̂ŒPȌ^̂
+*/
+template<class T>
+T* Arena::Alloc(size_t num)
+{
+	return reinterpret_cast<T*>(Alloc(sizeof(T) * num, alignof(T)));
+}
+
+#endif // __ARENA_H__
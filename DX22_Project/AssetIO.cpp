@@ -0,0 +1,238 @@
+#include "AssetIO.h"
+#include <assimp/MemoryIOWrapper.h>
+#include <algorithm>
+
+// staticoϐ`
+std::map<std::string, std::weak_ptr<AssetIOSystem::File>>	AssetIOSystem::m_files;
+std::map<std::string, AssetIOSystem::FilePtr>				AssetIOSystem::m_memoryFiles;
+std::mutex													AssetIOSystem::m_mutex;
+
+/*
+* @brief }bv̈QƂXg[
+*  j܂ŗ̈̎QƂAŌ̃Xg[jꂽ_Ń}bv
+*/
+class AssetIOSystem::Stream : public Assimp::MemoryIOStream
+{
+public:
+	Stream(const FilePtr& file)
+		: Assimp::MemoryIOStream(reinterpret_cast<const uint8_t*>(file->pData), file->size, false)
+		, m_file(file)
+	{
+	}
+
+private:
+	FilePtr m_file;
+};
+
+/*
+* @brief RXgN^
+*/
+AssetIOSystem::AssetIOSystem()
+{
+}
+
+/*
+* @brief fXgN^
+*  }bv̓Xg[QƂĂ邽߁Ał͉Ȃ
+*/
+AssetIOSystem::~AssetIOSystem()
+{
+}
+
+/*
+* @brief t@C̑݊mF
+* @param[in] pFile t@CpX
+* @return ݂true
+*/
+bool AssetIOSystem::Exists(const char* pFile) const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_memoryFiles.find(MakeKey(pFile)) != m_memoryFiles.end()) { return true; }
+	}
+	DWORD attr = GetFileAttributesA(pFile);
+	return attr != INVALID_FILE_ATTRIBUTES && !(attr & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+/*
+* @brief pX̋؂蕶
+*/
+char AssetIOSystem::getOsSeparator() const
+{
+	return '\\';
+}
+
+/*
+* @brief t@CJ
+* @param[in] pFile t@CpX
+* @param[in] pMode ǂݍ݃[h(݂͔Ή
+* @return ǂݍݗp̃Xg[
+*/
+Assimp::IOStream* AssetIOSystem::Open(const char* pFile, const char* pMode)
+{
+	if (strchr(pMode, 'w') || strchr(pMode, 'a')) { return nullptr; }
+
+	// o^ς݁A͑̃Xg[}bṽt@CTAȂ΃}bv
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::string key = MakeKey(pFile);
+	FilePtr file;
+	std::map<std::string, FilePtr>::iterator memIt = m_memoryFiles.find(key);
+	if (memIt != m_memoryFiles.end())
+	{
+		file = memIt->second;
+	}
+	else
+	{
+		file = m_files[key].lock();
+		if (!file)
+		{
+			file = MapFile(key);
+			if (!file)
+			{
+				m_files.erase(key);
+				return nullptr;
+			}
+			m_files[key] = file;
+		}
+	}
+
+	// }bvς݂̗̈̂܂܎QƂ(Rs[Ȃ
+	return new Stream(file);
+}
+
+/*
+* @brief t@C
+*  ɎQƂĂXg[Ȃ΃}bv
+* @param[in] pFile Openō쐬Xg[
+*/
+void AssetIOSystem::Close(Assimp::IOStream* pFile)
+{
+	delete pFile;
+
+	// ς݂̃t@Cꗗ菜
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, std::weak_ptr<File>>::iterator it = m_files.begin();
+	while (it != m_files.end())
+	{
+		if (it->second.expired())
+			it = m_files.erase(it);
+		else
+			++it;
+	}
+}
+
+/*
+* @brief ̃f[^t@CƂēo^
+* @param[in] file o^t@CpX
+* @param[in] pData f[^
+* @param[in] size f[^TCY
+*/
+void AssetIOSystem::AddMemoryFile(const char* file, const void* pData, size_t size)
+{
+	FilePtr entry = std::make_shared<File>();
+	entry->pData = pData;
+	entry->size = size;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_memoryFiles[MakeKey(file)] = entry;
+}
+
+/*
+* @brief o^̉
+*  ǂݍݒ̃Xg[́A܂ŎQƒ̗̈gpł
+* @param[in] file t@CpX
+*/
+void AssetIOSystem::ReleaseFile(const char* file)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::string key = MakeKey(file);
+	m_memoryFiles.erase(key);
+	m_files.erase(key);
+}
+
+/*
+* @brief St@C̓o^̉
+*/
+void AssetIOSystem::ReleaseAll()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_memoryFiles.clear();
+	m_files.clear();
+}
+
+/*
+* @brief LbV̌L[쐬
+*  ؂蕶Ƒ啶̈Ⴂz
+* @param[in] file t@CpX
+* @return L[
+*/
+std::string AssetIOSystem::MakeKey(const char* file)
+{
+	std::string key = file;
+	std::replace(key.begin(), key.end(), '/', '\\');
+	std::transform(key.begin(), key.end(), key.begin(), [](char c) {
+		return static_cast<char>(tolower(static_cast<unsigned char>(c)));
+	});
+	return key;
+}
+
+/*
+* @brief t@CɃ}bv
+* @param[in] key t@CpX
+* @return }bvt@C(snullptr
+*/
+AssetIOSystem::FilePtr AssetIOSystem::MapFile(const std::string& key)
+{
+	static const char empty = '\0';
+
+	FilePtr file = std::make_shared<File>();
+	file->hFile = CreateFileA(key.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file->hFile == INVALID_HANDLE_VALUE) { return nullptr; }
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file->hFile, &size)) { return nullptr; }
+
+	// t@C̓}bvłȂ̂ŁAf[^ƂĈ
+	if (size.QuadPart == 0)
+	{
+		file->pData = &empty;
+		return file;
+	}
+
+	file->hMapping = CreateFileMappingA(file->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!file->hMapping) { return nullptr; }
+	file->pData = MapViewOfFile(file->hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!file->pData) { return nullptr; }
+	file->size = static_cast<size_t>(size.QuadPart);
+	return file;
+}
+
+/*
+* @brief RXgN^
+*/
+AssetIOSystem::File::File()
+	: hFile(INVALID_HANDLE_VALUE)
+	, hMapping(NULL)
+	, pData(nullptr)
+	, size(0)
+{
+}
+
+/*
+* @brief fXgN^
+*  }bvt@C̉(o^̃f[^͌Ăяoŉ
+*/
+AssetIOSystem::File::~File()
+{
+	if (hMapping)
+	{
+		if (pData)
+			UnmapViewOfFile(pData);
+		CloseHandle(hMapping);
+	}
+	if (hFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(hFile);
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef __ASSET_IO_H__
+#define __ASSET_IO_H__
+
+#include <Windows.h>
+#undef max
+#undef min
+#include <assimp/IOSystem.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*
+* @brief assimpp̃t@Co
+*  t@C}bvēǂݍ݁AJĂXg[̊Ԃ͓}bvg܂킷
+*  }bv̓Xg[ƂɎQƂ𐔂AŌ̃Xg[_ŉ(t@CbNȂ
+*  (ɓt@CJĂAOS̃LbVɎcĂeQƂ邽ߍēǂݍ݂ɂ͂ȂȂ
+*  Importer::SetIOHandlerɓnImporterŔj邽߁Aǂݍ݂Ƃnewō쐬
+*/
+class AssetIOSystem : public Assimp::IOSystem
+{
+public:
+	AssetIOSystem();
+	~AssetIOSystem();
+
+	bool Exists(const char* pFile) const override;
+	char getOsSeparator() const override;
+	Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override;
+	void Close(Assimp::IOStream* pFile) override;
+
+	// ̃f[^t@CƂēo^(AZbgpbNWJς݂̃f[^Ȃ
+	// f[^̉͌Ăяoōs(ReleaseFileAReleaseAlľAJĂXg[ȂȂĂ
+	static void AddMemoryFile(const char* file, const void* pData, size_t size);
+	// o^̉(ǂݍݒ̃Xg[΁A}bv͂̃Xg[܂Ŏc
+	static void ReleaseFile(const char* file);
+	static void ReleaseAll();
+
+private:
+	// }bvt@C(jɉ
+	struct File
+	{
+		HANDLE		hFile;		// t@Cnh(o^̏ꍇINVALID_HANDLE_VALUE
+		HANDLE		hMapping;	// }bsOnh
+		const void*	pData;		// f[^擪
+		size_t		size;		// f[^TCY
+
+		File();
+		~File();
+	};
+	using FilePtr = std::shared_ptr<File>;
+	class Stream;
+
+	static std::string MakeKey(const char* file);
+	static FilePtr MapFile(const std::string& key);
+
+private:
+	static std::map<std::string, std::weak_ptr<File>>	m_files;		// }bṽt@C(Xg[QƂĂԂ̂
+	static std::map<std::string, FilePtr>				m_memoryFiles;	// o^̃t@C
+	static std::mutex									m_mutex;		// ̔r
+};
+
+#endif // __ASSET_IO_H__
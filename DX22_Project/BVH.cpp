@@ -0,0 +1,459 @@
+#include "BVH.h"
+#include <future>
+#include <algorithm>
+#include <float.h>
+
+const uint32_t BVH::NONE;
+
+BVH::BVH()
+{
+}
+BVH::~BVH()
+{
+}
+
+void BVH::Build(const std::vector<DirectX::BoundingBox>& boxes)
+{
+	uint32_t num = static_cast<uint32_t>(boxes.size());
+	m_objMin.resize(num);
+	m_objMax.resize(num);
+	m_centers.resize(num);
+	for (uint32_t i = 0; i < num; ++i)
+	{
+		DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&boxes[i].Center);
+		DirectX::XMVECTOR extents = DirectX::XMLoadFloat3(&boxes[i].Extents);
+		DirectX::XMStoreFloat3(&m_objMin[i], DirectX::XMVectorSubtract(center, extents));
+		DirectX::XMStoreFloat3(&m_objMax[i], DirectX::XMVectorAdd(center, extents));
+		m_centers[i] = boxes[i].Center;
+	}
+	Rebuild();
+}
+
+void BVH::Rebuild()
+{
+	uint32_t num = static_cast<uint32_t>(m_centers.size());
+	m_nodes.clear();
+	m_indices.resize(num);
+	for (uint32_t i = 0; i < num; ++i)
+		m_indices[i] = i;
+	if (num == 0) { return; }
+
+	m_nodes.reserve(num * 2);
+	BuildNode(0, num, 0, &m_nodes);
+	Link();
+}
+
+void BVH::Clear()
+{
+	m_nodes.clear();
+	m_indices.clear();
+	m_objMin.clear();
+	m_objMax.clear();
+	m_centers.clear();
+	m_parents.clear();
+	m_objLeaf.clear();
+}
+
+// ͈͓̃IuWFNg̋EƁAS͈̔͂vZ
+void BVH::CalcBounds(uint32_t begin, uint32_t end, DirectX::XMVECTOR* pMin, DirectX::XMVECTOR* pMax,
+	DirectX::XMVECTOR* pCMin, DirectX::XMVECTOR* pCMax)
+{
+	DirectX::XMVECTOR vMin = DirectX::XMVectorReplicate(FLT_MAX);
+	DirectX::XMVECTOR vMax = DirectX::XMVectorReplicate(-FLT_MAX);
+	DirectX::XMVECTOR cMin = vMin;
+	DirectX::XMVECTOR cMax = vMax;
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		uint32_t obj = m_indices[i];
+		vMin = DirectX::XMVectorMin(vMin, DirectX::XMLoadFloat3(&m_objMin[obj]));
+		vMax = DirectX::XMVectorMax(vMax, DirectX::XMLoadFloat3(&m_objMax[obj]));
+		DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&m_centers[obj]);
+		cMin = DirectX::XMVectorMin(cMin, center);
+		cMax = DirectX::XMVectorMax(cMax, center);
+	}
+	*pMin = vMin;
+	*pMax = vMax;
+	*pCMin = cMin;
+	*pCMax = cMax;
+}
+
+// \ʐ(̔
+static float HalfArea(DirectX::FXMVECTOR vMin, DirectX::FXMVECTOR vMax)
+{
+	DirectX::XMFLOAT3 size;
+	DirectX::XMStoreFloat3(&size, DirectX::XMVectorMax(DirectX::XMVectorSubtract(vMax, vMin), DirectX::XMVectorZero()));
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+// pNodes̖[begin,end)̃IuWFNg܂ރm[hǉ
+// (pNodes̔ԍpNodes̐擪0ƂlɂȂ
+void BVH::BuildNode(uint32_t begin, uint32_t end, int depth, std::vector<Node>* pNodes)
+{
+	uint32_t self = static_cast<uint32_t>(pNodes->size());
+	pNodes->push_back(Node());
+
+	DirectX::XMVECTOR vMin, vMax, cMin, cMax;
+	CalcBounds(begin, end, &vMin, &vMax, &cMin, &cMax);
+	DirectX::XMStoreFloat3(&(*pNodes)[self].min, vMin);
+	DirectX::XMStoreFloat3(&(*pNodes)[self].max, vMax);
+
+	uint32_t num = end - begin;
+	(*pNodes)[self].offset = begin;
+	(*pNodes)[self].count = num;
+	if (num <= LEAF_MAX || depth >= MAX_DEPTH) { return; }
+
+	// S͈̔͂łLŕ
+	DirectX::XMFLOAT3 cMinF, cMaxF;
+	DirectX::XMStoreFloat3(&cMinF, cMin);
+	DirectX::XMStoreFloat3(&cMaxF, cMax);
+	float extent[3] = { cMaxF.x - cMinF.x, cMaxF.y - cMinF.y, cMaxF.z - cMinF.z };
+	int axis = 0;
+	if (extent[1] > extent[axis]) axis = 1;
+	if (extent[2] > extent[axis]) axis = 2;
+	float axisMin = (&cMinF.x)[axis];
+	uint32_t mid = begin + num / 2;
+	if (extent[axis] <= 0.0f)
+	{
+		// ׂēʒułΔŕ
+	}
+	else
+	{
+		// r֐U蕪
+		struct Bin
+		{
+			DirectX::XMVECTOR min, max;
+			uint32_t count;
+		};
+		Bin bins[BIN_NUM];
+		for (uint32_t i = 0; i < BIN_NUM; ++i)
+		{
+			bins[i].min = DirectX::XMVectorReplicate(FLT_MAX);
+			bins[i].max = DirectX::XMVectorReplicate(-FLT_MAX);
+			bins[i].count = 0;
+		}
+		float scale = BIN_NUM / extent[axis];
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			uint32_t obj = m_indices[i];
+			uint32_t bin = std::min(static_cast<uint32_t>(((&m_centers[obj].x)[axis] - axisMin) * scale), BIN_NUM - 1);
+			bins[bin].min = DirectX::XMVectorMin(bins[bin].min, DirectX::XMLoadFloat3(&m_objMin[obj]));
+			bins[bin].max = DirectX::XMVectorMax(bins[bin].max, DirectX::XMLoadFloat3(&m_objMax[obj]));
+			++bins[bin].count;
+		}
+
+		// EݐςĊeʒũRXgvZ
+		float rightCost[BIN_NUM];
+		DirectX::XMVECTOR accMin = DirectX::XMVectorReplicate(FLT_MAX);
+		DirectX::XMVECTOR accMax = DirectX::XMVectorReplicate(-FLT_MAX);
+		uint32_t accNum = 0;
+		for (uint32_t i = BIN_NUM - 1; i > 0; --i)
+		{
+			accMin = DirectX::XMVectorMin(accMin, bins[i].min);
+			accMax = DirectX::XMVectorMax(accMax, bins[i].max);
+			accNum += bins[i].count;
+			rightCost[i] = accNum ? HalfArea(accMin, accMax) * accNum : 0.0f;
+		}
+		accMin = DirectX::XMVectorReplicate(FLT_MAX);
+		accMax = DirectX::XMVectorReplicate(-FLT_MAX);
+		accNum = 0;
+		float bestCost = FLT_MAX;
+		uint32_t bestSplit = 0;
+		for (uint32_t i = 0; i < BIN_NUM - 1; ++i)
+		{
+			accMin = DirectX::XMVectorMin(accMin, bins[i].min);
+			accMax = DirectX::XMVectorMax(accMax, bins[i].max);
+			accNum += bins[i].count;
+			float cost = (accNum ? HalfArea(accMin, accMax) * accNum : 0.0f) + rightCost[i + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplit = i;
+			}
+		}
+
+		// ȂΗtɂ(ꍇ͕𑱂
+		float leafCost = HalfArea(vMin, vMax) * num;
+		if (bestCost >= leafCost && num <= LEAF_MAX * 4) { return; }
+
+		// ʒuŕёւ
+		uint32_t* pMid = std::partition(&m_indices[begin], &m_indices[0] + end, [&](uint32_t obj) {
+			uint32_t bin = std::min(static_cast<uint32_t>(((&m_centers[obj].x)[axis] - axisMin) * scale), BIN_NUM - 1);
+			return bin <= bestSplit;
+		});
+		mid = static_cast<uint32_t>(pMid - &m_indices[0]);
+		if (mid == begin || mid == end)
+			mid = begin + num / 2;
+	}
+
+	// qm[h̍쐬
+	(*pNodes)[self].count = 0;
+	if (num >= PARALLEL_MIN && depth < PARALLEL_DEPTH)
+	{
+		// EʁXɍ\zĘA(ёւ͈͂dȂȂߓɏł
+		std::vector<Node> left, right;
+		std::future<void> task = std::async(std::launch::async, [&]() {
+			BuildNode(begin, mid, depth + 1, &left);
+		});
+		BuildNode(mid, end, depth + 1, &right);
+		task.get();
+
+		uint32_t leftBase = static_cast<uint32_t>(pNodes->size());
+		uint32_t rightBase = leftBase + static_cast<uint32_t>(left.size());
+		for (size_t i = 0; i < left.size(); ++i)
+		{
+			if (left[i].count == 0) left[i].offset += leftBase;
+			pNodes->push_back(left[i]);
+		}
+		for (size_t i = 0; i < right.size(); ++i)
+		{
+			if (right[i].count == 0) right[i].offset += rightBase;
+			pNodes->push_back(right[i]);
+		}
+		(*pNodes)[self].offset = rightBase;
+	}
+	else
+	{
+		BuildNode(begin, mid, depth + 1, pNodes);
+		(*pNodes)[self].offset = static_cast<uint32_t>(pNodes->size());
+		BuildNode(mid, end, depth + 1, pNodes);
+	}
+}
+
+// eAt̎QƂ쐬
+void BVH::Link()
+{
+	m_parents.assign(m_nodes.size(), NONE);
+	m_objLeaf.assign(m_centers.size(), NONE);
+	for (uint32_t i = 0; i < m_nodes.size(); ++i)
+	{
+		const Node& node = m_nodes[i];
+		if (node.count > 0)
+		{
+			for (uint32_t j = 0; j < node.count; ++j)
+				m_objLeaf[m_indices[node.offset + j]] = i;
+		}
+		else
+		{
+			m_parents[i + 1] = i;
+			m_parents[node.offset] = i;
+		}
+	}
+}
+
+void BVH::Refit(uint32_t index, const DirectX::BoundingBox& box)
+{
+	if (index >= m_centers.size()) { return; }
+	DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&box.Center);
+	DirectX::XMVECTOR extents = DirectX::XMLoadFloat3(&box.Extents);
+	DirectX::XMStoreFloat3(&m_objMin[index], DirectX::XMVectorSubtract(center, extents));
+	DirectX::XMStoreFloat3(&m_objMax[index], DirectX::XMVectorAdd(center, extents));
+	m_centers[index] = box.Center;
+
+	// te֌ċEXV(ωȂȂΏI
+	uint32_t node = m_objLeaf[index];
+	while (node != NONE)
+	{
+		Node& n = m_nodes[node];
+		DirectX::XMVECTOR vMin, vMax;
+		if (n.count > 0)
+		{
+			DirectX::XMVECTOR cMin, cMax;
+			CalcBounds(n.offset, n.offset + n.count, &vMin, &vMax, &cMin, &cMax);
+		}
+		else
+		{
+			const Node& l = m_nodes[node + 1];
+			const Node& r = m_nodes[n.offset];
+			vMin = DirectX::XMVectorMin(DirectX::XMLoadFloat3(&l.min), DirectX::XMLoadFloat3(&r.min));
+			vMax = DirectX::XMVectorMax(DirectX::XMLoadFloat3(&l.max), DirectX::XMLoadFloat3(&r.max));
+		}
+		if (DirectX::XMVector3Equal(vMin, DirectX::XMLoadFloat3(&n.min)) &&
+			DirectX::XMVector3Equal(vMax, DirectX::XMLoadFloat3(&n.max)))
+		{
+			break;
+		}
+		DirectX::XMStoreFloat3(&n.min, vMin);
+		DirectX::XMStoreFloat3(&n.max, vMax);
+		node = m_parents[node];
+	}
+}
+
+void BVH::QueryFrustum(const DirectX::XMFLOAT4* pPlanes, std::vector<uint32_t>* pOut)
+{
+	pOut->clear();
+	if (m_nodes.empty()) { return; }
+
+	DirectX::XMVECTOR planes[6], absPlanes[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		planes[i] = DirectX::XMLoadFloat4(&pPlanes[i]);
+		absPlanes[i] = DirectX::XMVectorAbs(planes[i]);
+	}
+
+	// Sɓ̃m[h͈ȍ~̔ȗ
+	struct Entry { uint32_t node; bool inside; };
+	Entry stack[MAX_DEPTH + 2];
+	int stackNum = 0;
+	stack[stackNum++] = { 0, false };
+	while (stackNum > 0)
+	{
+		Entry entry = stack[--stackNum];
+		const Node& node = m_nodes[entry.node];
+
+		bool inside = entry.inside;
+		if (!inside)
+		{
+			DirectX::XMVECTOR vMin = DirectX::XMLoadFloat3(&node.min);
+			DirectX::XMVECTOR vMax = DirectX::XMLoadFloat3(&node.max);
+			DirectX::XMVECTOR center = DirectX::XMVectorSetW(
+				DirectX::XMVectorScale(DirectX::XMVectorAdd(vMin, vMax), 0.5f), 1.0f);
+			DirectX::XMVECTOR extents = DirectX::XMVectorScale(DirectX::XMVectorSubtract(vMax, vMin), 0.5f);
+			bool outside = false;
+			inside = true;
+			for (int i = 0; i < 6 && !outside; ++i)
+			{
+				float dist = DirectX::XMVectorGetX(DirectX::XMVector4Dot(planes[i], center));
+				float radius = DirectX::XMVectorGetX(DirectX::XMVector3Dot(absPlanes[i], extents));
+				if (dist < -radius) outside = true;
+				else if (dist < radius) inside = false;
+			}
+			if (outside) { continue; }
+		}
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = 0; i < node.count; ++i)
+				pOut->push_back(m_indices[node.offset + i]);
+		}
+		else
+		{
+			stack[stackNum++] = { node.offset, inside };
+			stack[stackNum++] = { entry.node + 1, inside };
+		}
+	}
+}
+
+void BVH::QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<uint32_t>* pOut)
+{
+	pOut->clear();
+	if (m_nodes.empty()) { return; }
+
+	DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&sphere.Center);
+	float radiusSq = sphere.Radius * sphere.Radius;
+
+	uint32_t stack[MAX_DEPTH + 2];
+	int stackNum = 0;
+	stack[stackNum++] = 0;
+	while (stackNum > 0)
+	{
+		const Node& node = m_nodes[stack[--stackNum]];
+		uint32_t nodeIndex = static_cast<uint32_t>(&node - &m_nodes[0]);
+
+		// AABB̍ŋߓ_Ƃ̋Ŕ
+		DirectX::XMVECTOR closest = DirectX::XMVectorClamp(center,
+			DirectX::XMLoadFloat3(&node.min), DirectX::XMLoadFloat3(&node.max));
+		float distSq = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(closest, center)));
+		if (distSq > radiusSq) { continue; }
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = 0; i < node.count; ++i)
+			{
+				uint32_t obj = m_indices[node.offset + i];
+				closest = DirectX::XMVectorClamp(center,
+					DirectX::XMLoadFloat3(&m_objMin[obj]), DirectX::XMLoadFloat3(&m_objMax[obj]));
+				distSq = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(closest, center)));
+				if (distSq <= radiusSq)
+					pOut->push_back(obj);
+			}
+		}
+		else
+		{
+			stack[stackNum++] = node.offset;
+			stack[stackNum++] = nodeIndex + 1;
+		}
+	}
+}
+
+// AABBƃČ(Xu@ApDist֋o
+// maxDist𒴂ꍇ͌Ȃ̂Ƃ
+static bool RayBox(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR invDir,
+	DirectX::FXMVECTOR vMin, DirectX::GXMVECTOR vMax, float maxDist, float* pDist)
+{
+	DirectX::XMVECTOR t1 = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(vMin, origin), invDir);
+	DirectX::XMVECTOR t2 = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(vMax, origin), invDir);
+	DirectX::XMFLOAT3 tNear, tFar;
+	DirectX::XMStoreFloat3(&tNear, DirectX::XMVectorMin(t1, t2));
+	DirectX::XMStoreFloat3(&tFar, DirectX::XMVectorMax(t1, t2));
+	float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+	float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDist));
+	if (!(enter <= exit)) { return false; }
+	*pDist = enter;
+	return true;
+}
+
+uint32_t BVH::Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float maxDist, float* pDist)
+{
+	if (m_nodes.empty()) { return NONE; }
+
+	DirectX::XMVECTOR invDir = DirectX::XMVectorReciprocal(dir);
+	uint32_t hit = NONE;
+	float hitDist = maxDist;
+
+	uint32_t stack[MAX_DEPTH + 2];
+	int stackNum = 0;
+	float rootDist;
+	if (RayBox(origin, invDir, DirectX::XMLoadFloat3(&m_nodes[0].min), DirectX::XMLoadFloat3(&m_nodes[0].max), hitDist, &rootDist))
+		stack[stackNum++] = 0;
+	while (stackNum > 0)
+	{
+		uint32_t nodeIndex = stack[--stackNum];
+		const Node& node = m_nodes[nodeIndex];
+		if (node.count > 0)
+		{
+			for (uint32_t i = 0; i < node.count; ++i)
+			{
+				uint32_t obj = m_indices[node.offset + i];
+				float dist;
+				if (!RayBox(origin, invDir,
+					DirectX::XMLoadFloat3(&m_objMin[obj]), DirectX::XMLoadFloat3(&m_objMax[obj]), hitDist, &dist)) { continue; }
+				// łΐɌD
+				if (hit == NONE || dist < hitDist)
+				{
+					hit = obj;
+					hitDist = dist;
+				}
+			}
+			continue;
+		}
+
+		// ߂̎qɒׂ(ォς񂾕ɏ
+		uint32_t child[2] = { nodeIndex + 1, node.offset };
+		float dist[2];
+		bool isHit[2];
+		for (int i = 0; i < 2; ++i)
+		{
+			const Node& c = m_nodes[child[i]];
+			isHit[i] = RayBox(origin, invDir, DirectX::XMLoadFloat3(&c.min), DirectX::XMLoadFloat3(&c.max), hitDist, &dist[i]);
+		}
+		if (isHit[0] && isHit[1] && dist[0] > dist[1])
+		{
+			std::swap(child[0], child[1]);
+		}
+		if (isHit[1]) stack[stackNum++] = child[1];
+		if (isHit[0]) stack[stackNum++] = child[0];
+	}
+
+	if (pDist && hit != NONE)
+		*pDist = hitDist;
+	return hit;
+}
+
+const std::vector<BVH::Node>& BVH::GetNodes()
+{
+	return m_nodes;
+}
+uint32_t BVH::GetObjectNum()
+{
+	return static_cast<uint32_t>(m_centers.size());
+}
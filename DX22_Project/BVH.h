@@ -0,0 +1,71 @@
+#ifndef __BVH_H__
+#define __BVH_H__
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <vector>
+#include <stdint.h>
+
+// ÓIIuWFNgp̋E{[Kw(BVH)
+// SAH(\ʐσq[XeBbN)ŕAʂ̊Kw͕Xbhō\z
+// m[h͐[Dň̔zׁ֕A̎q͒AE̎q͔ԍŎQƂ
+class BVH
+{
+public:
+	static const uint32_t NONE = 0xffffffff;	// YȂ
+
+	// \z̃m[h(32byte
+	struct Node
+	{
+		DirectX::XMFLOAT3	min;
+		uint32_t				offset;	// t: 擪̃IuWFNgʒu / : E̎q̃m[hԍ
+		DirectX::XMFLOAT3	max;
+		uint32_t				count;	// t: IuWFNg / : 0
+	};
+
+public:
+	BVH();
+	~BVH();
+
+	// \z(IuWFNgԍboxes̕я
+	void Build(const std::vector<DirectX::BoundingBox>& boxes);
+	// ݂̋Eō\z
+	void Rebuild();
+	// IuWFNg̋EXVA܂܂m[h̋Ee֌čXV
+	// (ړʂ傫ꍇ͖؂̎邽߁AKXRebuilds
+	void Refit(uint32_t index, const DirectX::BoundingBox& box);
+	void Clear();
+
+	// ƌIuWFNgo(ʂFrustumCull::MakePlanesō쐬
+	void QueryFrustum(const DirectX::XMFLOAT4* pPlanes, std::vector<uint32_t>* pOut);
+	// ƌIuWFNgo
+	void QuerySphere(const DirectX::BoundingSphere& sphere, std::vector<uint32_t>* pOut);
+	// CƍŏɌIuWFNgԂ(ȂNONE
+	uint32_t Raycast(DirectX::FXMVECTOR origin, DirectX::FXMVECTOR dir, float maxDist, float* pDist = nullptr);
+
+	const std::vector<Node>& GetNodes();
+	uint32_t GetObjectNum();
+
+private:
+	void BuildNode(uint32_t begin, uint32_t end, int depth, std::vector<Node>* pNodes);
+	void Link();
+	void CalcBounds(uint32_t begin, uint32_t end, DirectX::XMVECTOR* pMin, DirectX::XMVECTOR* pMax,
+		DirectX::XMVECTOR* pCMin, DirectX::XMVECTOR* pCMax);
+
+private:
+	static const uint32_t	LEAF_MAX		= 4;	// tɊ܂߂IuWFNg̍ő吔
+	static const uint32_t	BIN_NUM			= 16;	// SAH̕␔
+	static const uint32_t	PARALLEL_MIN	= 4096;	// ʃXbhō\zIuWFNg̉
+	static const int	PARALLEL_DEPTH	= 3;	// ʃXbhō\z[(ő2^3Xbh
+	static const int	MAX_DEPTH		= 48;	// ؂̍ő̐[(Tp̃X^bN̑傫
+
+	std::vector<Node>				m_nodes;
+	std::vector<uint32_t>				m_indices;		// tQƂIuWFNgԍ
+	std::vector<DirectX::XMFLOAT3>	m_objMin;		// IuWFNg̋E
+	std::vector<DirectX::XMFLOAT3>	m_objMax;
+	std::vector<DirectX::XMFLOAT3>	m_centers;		// IuWFNg̒S
+	std::vector<uint32_t>				m_parents;		// m[h̐e
+	std::vector<uint32_t>				m_objLeaf;		// IuWFNg܂܂t
+};
+
+#endif // __BVH_H__
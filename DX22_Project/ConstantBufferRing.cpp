@@ -0,0 +1,202 @@
+#include "ConstantBufferRing.h"
+#include <string.h>
+#include <mutex>
+
+// [J[Xbh̐؂oAWvp
+static std::mutex g_ringLock;
+
+//--- ÓIo
+ID3D11Buffer*				ConstantBufferRing::m_pBuffer = nullptr;
+UINT						ConstantBufferRing::m_size = 0;
+UINT						ConstantBufferRing::m_offset = 0;
+UINT						ConstantBufferRing::m_generation = 0;
+bool						ConstantBufferRing::m_discard = true;
+char*						ConstantBufferRing::m_pMapped = nullptr;
+UINT						ConstantBufferRing::m_mapOffset = 0;
+bool						ConstantBufferRing::m_recording = false;
+ConstantBufferRing::Stats	ConstantBufferRing::m_stats;
+std::vector<ConstantBufferRing::DiscardCallback>	ConstantBufferRing::m_discardCallbacks;
+
+HRESULT ConstantBufferRing::Init(UINT size)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+
+	// 萔obt@̈ʒuwƁANO_OVERWRITEłMapɑΉĂ邩
+	ID3D11Device* pDevice = GetDevice();
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	HRESULT hr = pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	if (FAILED(hr) || !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+		return S_OK;	// Ή̊ł̓OgȂ
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	hr = pDevice->CreateBuffer(&desc, nullptr, &m_pBuffer);
+	if (FAILED(hr)) { return hr; }
+	m_size = desc.ByteWidth;
+	m_offset = 0;
+	m_discard = true;
+	m_pMapped = nullptr;
+	m_recording = false;
+	return S_OK;
+}
+void ConstantBufferRing::Uninit()
+{
+	m_recording = false;
+	Flush();
+	SAFE_RELEASE(m_pBuffer);
+	m_size = 0;
+}
+
+void ConstantBufferRing::BeginFrame()
+{
+	m_recording = false;
+	Flush();
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_offset = 0;
+	m_discard = true;
+}
+
+bool ConstantBufferRing::IsEnabled()
+{
+	return m_pBuffer != nullptr;
+}
+
+bool ConstantBufferRing::Write(const void* pData, UINT size, Block* pBlock)
+{
+	// 1Őݒł傫(4096萔)𒴂͈̂Ȃ
+	UINT allocSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	if (!m_pBuffer || allocSize > m_size || allocSize > D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16)
+		return false;
+
+	UINT offset;
+	UINT generation = m_generation;
+	if (IsRecordingThread())
+	{
+		// L^͌ĂяõXbhŊJ͈͂֏
+		// mۂƑ̃Xbh񂾗̈悪邽߁Aꍇ͎gȂ
+		std::lock_guard<std::mutex> lock(g_ringLock);
+		if (!m_recording || !m_pMapped || m_offset + allocSize > m_size)
+			return false;
+		offset = m_offset;
+		m_offset += allocSize;
+		++m_stats.writeNum;
+		m_stats.uploadBytes += size;
+	}
+	else
+	{
+		// A񂾔͈͂m肵Ămۂ(`撆̗̈̓hCoێ
+		if (m_offset + allocSize > m_size)
+		{
+			Flush();
+			m_offset = 0;
+			m_discard = true;
+		}
+		if (!m_pMapped && !MapRing())
+			return false;
+		offset = m_offset;
+		m_offset += allocSize;
+		++m_stats.writeNum;
+		m_stats.uploadBytes += size;
+	}
+	memcpy(m_pMapped + offset, pData, size);
+
+	pBlock->pBuffer = m_pBuffer;
+	pBlock->firstConstant = offset / 16;
+	pBlock->numConstants = allocSize / 16;
+	pBlock->generation = m_generation;
+
+	// mۂꍇ́Aݒ肵܂܂̒萔ݒ
+	if (generation != m_generation)
+		CallDiscardCallbacks();
+	return true;
+}
+
+void ConstantBufferRing::Flush()
+{
+	// L^͊eXbh̕`ł͊m肵Ȃ(EndRecordingŊm肷
+	if (!m_pMapped || m_recording) { return; }
+	GetContext()->UnmapRange(m_pBuffer, 0, m_mapOffset, m_offset - m_mapOffset);
+	m_pMapped = nullptr;
+}
+
+void ConstantBufferRing::BeginRecording()
+{
+	if (!m_pBuffer) { return; }
+	// L^͈ĂmۂȂ߁Ac肪؂ĂΐɊmۂ
+	if (m_offset > m_size / 2)
+	{
+		Flush();
+		m_offset = 0;
+		m_discard = true;
+	}
+	UINT generation = m_generation;
+	if (!m_pMapped && !MapRing())
+		return;
+	if (generation != m_generation)
+		CallDiscardCallbacks();
+	m_recording = true;
+}
+void ConstantBufferRing::EndRecording()
+{
+	m_recording = false;
+	Flush();
+}
+
+bool ConstantBufferRing::IsValid(const Block& block)
+{
+	return block.pBuffer && block.pBuffer == m_pBuffer && block.generation == m_generation;
+}
+
+void ConstantBufferRing::AddFallback(UINT size)
+{
+	std::lock_guard<std::mutex> lock(g_ringLock);
+	++m_stats.fallbackNum;
+	m_stats.uploadBytes += size;
+}
+
+void ConstantBufferRing::AddDiscardCallback(DiscardCallback func)
+{
+	m_discardCallbacks.push_back(func);
+}
+void ConstantBufferRing::RemoveDiscardCallback(DiscardCallback func)
+{
+	for (auto it = m_discardCallbacks.begin(); it != m_discardCallbacks.end(); ++it)
+	{
+		if (*it == func)
+		{
+			m_discardCallbacks.erase(it);
+			return;
+		}
+	}
+}
+
+const ConstantBufferRing::Stats& ConstantBufferRing::GetStats()
+{
+	return m_stats;
+}
+
+bool ConstantBufferRing::MapRing()
+{
+	D3D11_MAP type = m_discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(GetContext()->Map(m_pBuffer, 0, type, 0, &mapped)))
+		return false;
+	if (m_discard)
+	{
+		m_discard = false;
+		++m_generation;
+		++m_stats.discardNum;
+	}
+	m_pMapped = static_cast<char*>(mapped.pData);
+	m_mapOffset = m_offset;
+	++m_stats.mapNum;
+	return true;
+}
+void ConstantBufferRing::CallDiscardCallbacks()
+{
+	for (size_t i = 0; i < m_discardCallbacks.size(); ++i)
+		m_discardCallbacks[i]();
+}
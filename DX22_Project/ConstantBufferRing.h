@@ -0,0 +1,87 @@
+#ifndef __CONSTANT_BUFFER_RING_H__
+#define __CONSTANT_BUFFER_RING_H__
+
+#include "DirectX.h"
+#include <vector>
+
+// `悲Ƃ̒萔ރOobt@
+// t[̊JnɈxWRITE_DISCARDŊmۂAȍ~NO_OVERWRITE256bytePʂɐ؂oď
+// 񂾈ʒu*SetConstantBuffers1Ŏw肵Đݒ肷
+// Map͏݂̂тł͂ȂA`(Flush)܂ł݂̏܂Ƃ߂1Ƃ
+// [J[Xbhł̋L^(BeginRecording`EndRecording)͌ĂяõXbhŊJ܂܂ɂAeXbh珑
+// D3D11.1̋@\(萔obt@̈ʒuwANO_OVERWRITE)gȂł͖ƂȂA
+// eVF[_[obt@ւUpdateSubresourceŏ
+// L^Ɉꍇ́Aݍς݂̗̈mۂȂߓlɃOgȂ
+class ConstantBufferRing
+{
+public:
+	// ]̏Wv(t[
+	struct Stats
+	{
+		UINT	writeNum;		// Oւ̏݉
+		UINT	fallbackNum;	// OgȂ݉
+		UINT	discardNum;		// mۂ(t[rňꍇ܂
+		UINT	mapNum;			// Map̉
+		UINT64	uploadBytes;	// ](؂o傫ł͂Ȃۂ̒萔̑傫
+	};
+
+	// 񂾗̈
+	struct Block
+	{
+		ID3D11Buffer*	pBuffer;
+		UINT			firstConstant;	// 16byteP
+		UINT			numConstants;
+		UINT			generation;		// mۂтɕςԍ(قȂΏݒ
+	};
+
+	// mۂۂɌĂяo(ʒuw肵Đݒ肵܂܂̒萔ݒ
+	using DiscardCallback = void(*)();
+
+	// 萔`
+	static const UINT ALIGNMENT = 256;	// ؂o̒P(D3D11.1̈ʒuw̒P
+
+public:
+	static HRESULT Init(UINT size = 4 * 1024 * 1024);
+	static void Uninit();
+
+	// t[̊Jn(Wv̔jƊmۂ
+	static void BeginFrame();
+
+	// Og邩
+	static bool IsEnabled();
+	// 萔݁A񂾗̈Ԃ
+	static bool Write(const void* pData, UINT size, Block* pBlock);
+	// 񂾔͈͂m肷(`̑OɌĂяo
+	static void Flush();
+	// [J[Xbhł̋L^̊JnƏI(ĂяõXbhŌĂяo
+	static void BeginRecording();
+	static void EndRecording();
+	// 񂾗̈悪܂L
+	static bool IsValid(const Block& block);
+	// Og킸ɓ]ʂ̏Wv
+	static void AddFallback(UINT size);
+	// mۂۂ̏̓o^A
+	static void AddDiscardCallback(DiscardCallback func);
+	static void RemoveDiscardCallback(DiscardCallback func);
+
+	static const Stats& GetStats();
+
+private:
+	// ݂̈ʒȕ݂Jn
+	static bool MapRing();
+	static void CallDiscardCallbacks();
+
+private:
+	static ID3D11Buffer*	m_pBuffer;
+	static UINT				m_size;
+	static UINT				m_offset;		// ɐ؂oʒu
+	static UINT				m_generation;
+	static bool				m_discard;		// ݂̏Ŋmۂ
+	static char*			m_pMapped;		// Map̏ݐ(MapłȂnullptr
+	static UINT				m_mapOffset;	// Mapɏ񂾔͈͂̐擪
+	static bool				m_recording;	// [J[XbhŋL^
+	static Stats			m_stats;
+	static std::vector<DiscardCallback>	m_discardCallbacks;
+};
+
+#endif // __CONSTANT_BUFFER_RING_H__
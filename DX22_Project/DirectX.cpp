@@ -4,6 +4,11 @@
 //--- O[oϐ
 ID3D11Device*			g_pDevice;
 ID3D11DeviceContext*	g_pContext;
+RenderContextD3D11*		g_pD3DContext;
+RenderContextRecord*	g_pRecordContext;
+RenderContextCache*		g_pStateCache;
+RenderContext*			g_pRenderContext;
+thread_local RenderContext*	g_pThreadContext = nullptr;
 IDXGISwapChain*			g_pSwapChain;
 RenderTarget*			g_pRTV;
 DepthStencil*			g_pDSV;
@@ -16,9 +21,25 @@ ID3D11Device* GetDevice()
 {
 	return g_pDevice;
 }
-ID3D11DeviceContext* GetContext()
+RenderContext* GetContext()
 {
-	return g_pContext;
+	return g_pThreadContext ? g_pThreadContext : g_pRenderContext;
+}
+RenderContextRecord* GetRecordContext()
+{
+	return g_pRecordContext;
+}
+RenderContextCache* GetStateCache()
+{
+	return g_pStateCache;
+}
+void SetThreadContext(RenderContext* pContext)
+{
+	g_pThreadContext = pContext;
+}
+bool IsRecordingThread()
+{
+	return g_pThreadContext != nullptr;
 }
 IDXGISwapChain* GetSwapChain()
 {
@@ -33,6 +54,8 @@ DepthStencil* GetDefaultDSV()
 	return g_pDSV;
 }
 
+HRESULT InitDirectXState(UINT width, UINT height);
+
 HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 {
 	HRESULT	hr = E_FAIL;
@@ -78,6 +101,36 @@ HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 	D3D_DRIVER_TYPE driverType;
 	D3D_FEATURE_LEVEL featureLevel;
 
+	// wbhX
+	// `@\ȂNULLhCoŃfoCX쐬AR}h͋L^̂ݍs
+	// (fobOC[SDK̓ĂȂvł͍쐬Ɏs邽ߎgȂ
+	// NULLhCogȂłWARP(CPU)ō쐬
+	if (!hWnd)
+	{
+		D3D_DRIVER_TYPE headlessTypes[] =
+		{
+			D3D_DRIVER_TYPE_NULL,
+			D3D_DRIVER_TYPE_WARP,
+		};
+		for (UINT i = 0; i < ARRAYSIZE(headlessTypes); ++i)
+		{
+			hr = D3D11CreateDevice(
+				NULL, headlessTypes[i], NULL, 0,
+				featureLevels, numFeatureLevels, D3D11_SDK_VERSION,
+				&g_pDevice, &featureLevel, &g_pContext);
+			if (SUCCEEDED(hr)) {
+				break;
+			}
+		}
+		if (FAILED(hr)) {
+			return hr;
+		}
+		g_pRecordContext = new RenderContextRecord();
+		g_pStateCache = new RenderContextCache(g_pRecordContext);
+		g_pRenderContext = g_pStateCache;
+		return InitDirectXState(width, height);
+	}
+
 	for (UINT driverTypeIndex = 0; driverTypeIndex < numDriverTypes; ++driverTypeIndex)
 	{
 		driverType = driverTypes[driverTypeIndex];
@@ -101,10 +154,25 @@ HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 	if (FAILED(hr)) {
 		return hr;
 	}
+	g_pD3DContext = new RenderContextD3D11(g_pContext);
+	g_pStateCache = new RenderContextCache(g_pD3DContext);
+	g_pRenderContext = g_pStateCache;
+
+	return InitDirectXState(width, height);
+}
+
+// foCX쐬̋ʂ̏
+HRESULT InitDirectXState(UINT width, UINT height)
+{
+	HRESULT hr;
 
 	//--- _[^[Qbgݒ
 	g_pRTV = new RenderTarget();
-	if (FAILED(hr = g_pRTV->CreateFromScreen()))
+	if (g_pSwapChain)
+		hr = g_pRTV->CreateFromScreen();
+	else
+		hr = g_pRTV->Create(DXGI_FORMAT_R8G8B8A8_UNORM, width, height);
+	if (FAILED(hr))
 		return hr;
 	g_pDSV = new DepthStencil();
 	if (FAILED(hr = g_pDSV->Create(g_pRTV->GetWidth(), g_pRTV->GetHeight(), false)))
@@ -169,6 +237,7 @@ HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 	samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
 	samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
 	samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+	samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;	// ~bv}bvׂĎgp
 	for (int i = 0; i < SAMPLER_MAX; ++i)
 	{
 		samplerDesc.Filter = filter[i];
@@ -193,6 +262,10 @@ void UninitDirectX()
 		SAFE_RELEASE(g_pRasterizerState[i]);
 	if(g_pContext)
 		g_pContext->ClearState();
+	g_pRenderContext = nullptr;
+	SAFE_DELETE(g_pStateCache);
+	SAFE_DELETE(g_pRecordContext);
+	SAFE_DELETE(g_pD3DContext);
 	SAFE_RELEASE(g_pContext);
 	if(g_pSwapChain)
 		g_pSwapChain->SetFullscreenState(false, NULL);
@@ -202,25 +275,29 @@ void UninitDirectX()
 
 void BeginDrawDirectX()
 {
+	g_pStateCache->ResetStats();
+	if (g_pRecordContext)
+		g_pRecordContext->Clear();
 	float color[4] = { 0.8f, 0.9f, 1.0f, 1.0f };
 	g_pRTV->Clear(color);
 	g_pDSV->Clear();
 }
 void EndDrawDirectX()
 {
-	g_pSwapChain->Present(0, 0);
+	if (g_pSwapChain)
+		g_pSwapChain->Present(0, 0);
 }
 
 
 
 void SetRenderTargets(UINT num, RenderTarget** ppViews, DepthStencil* pView)
 {
-	static ID3D11RenderTargetView* rtvs[4];
+	ID3D11RenderTargetView* rtvs[4];
 
 	if (num > 4) num = 4;
 	for (UINT i = 0; i < num; ++i)
 		rtvs[i] = ppViews[i]->GetView();
-	g_pContext->OMSetRenderTargets(num, rtvs, pView ? pView->GetView() : nullptr);
+	GetContext()->OMSetRenderTargets(num, rtvs, pView ? pView->GetView() : nullptr);
 
 	// r[|[g̐ݒ
 	D3D11_VIEWPORT vp;
@@ -230,26 +307,26 @@ void SetRenderTargets(UINT num, RenderTarget** ppViews, DepthStencil* pView)
 	vp.Height = (float)ppViews[0]->GetHeight();
 	vp.MinDepth = 0.0f;
 	vp.MaxDepth = 1.0f;
-	g_pContext->RSSetViewports(1, &vp);
+	GetContext()->RSSetViewports(1, &vp);
 }
 
 void SetCullingMode(D3D11_CULL_MODE cull)
 {
 	switch (cull)
 	{
-	case D3D11_CULL_NONE: g_pContext->RSSetState(g_pRasterizerState[0]); break;
-	case D3D11_CULL_FRONT: g_pContext->RSSetState(g_pRasterizerState[1]); break;
-	case D3D11_CULL_BACK: g_pContext->RSSetState(g_pRasterizerState[2]); break;
+	case D3D11_CULL_NONE: GetContext()->RSSetState(g_pRasterizerState[0]); break;
+	case D3D11_CULL_FRONT: GetContext()->RSSetState(g_pRasterizerState[1]); break;
+	case D3D11_CULL_BACK: GetContext()->RSSetState(g_pRasterizerState[2]); break;
 	}
 }
 void SetBlendMode(BlendMode blend)
 {
 	if (blend < 0 || blend >= BLEND_MAX) return;
 	FLOAT blendFactor[4] = { D3D11_BLEND_ZERO, D3D11_BLEND_ZERO, D3D11_BLEND_ZERO, D3D11_BLEND_ZERO };
-	g_pContext->OMSetBlendState(g_pBlendState[blend], blendFactor, 0xffffffff);
+	GetContext()->OMSetBlendState(g_pBlendState[blend], blendFactor, 0xffffffff);
 }
 void SetSamplerState(SamplerState state)
 {
 	if (state < 0 || state >= SAMPLER_MAX) return;
-	g_pContext->PSSetSamplers(0, 1, &g_pSamplerState[state]);
+	GetContext()->PSSetSamplers(0, 1, &g_pSamplerState[state]);
 }
\ No newline at end of file
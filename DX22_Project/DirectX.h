@@ -2,6 +2,7 @@
 #define __DIRECTX_H__
 
 #include <d3d11.h>
+#include "RenderContext.h"
 
 #pragma comment(lib, "d3d11.lib")
 
@@ -31,11 +32,20 @@ enum SamplerState
 };
 
 ID3D11Device* GetDevice();
-ID3D11DeviceContext* GetContext();
+RenderContext* GetContext();
+// wbhX̋L^(EBhEꍇnullptr
+RenderContextRecord* GetRecordContext();
+RenderContextCache* GetStateCache();
+// ĂяoXbhłGetContext̔sւ(nullptrŌɖ߂
+// [J[XbhRenderContextList֋L^ۂɎgp
+void SetThreadContext(RenderContext* pContext);
+// ĂяoXbh̔s悪ւĂ邩(foCXReLXg𒼐ڎgȂ
+bool IsRecordingThread();
 IDXGISwapChain* GetSwapChain();
 RenderTarget* GetDefaultRTV();
 DepthStencil* GetDefaultDSV();
 
+// hWndNULLw肷ƃEBhEȂwbhX(`͋L^̂
 HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen);
 void UninitDirectX();
 void BeginDrawDirectX();
@@ -0,0 +1,183 @@
+#include "FrustumCull.h"
+#include <chrono>
+#include <string.h>
+#include <math.h>
+
+// OIuWFNg̔a(K̊OƔ肳
+static const float DISABLE_RADIUS = -1.0e30f;
+
+FrustumCull::FrustumCull()
+	: m_num(0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	DirectX::XMFLOAT4X4 identity;
+	DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+	SetFrustum(identity);
+}
+FrustumCull::~FrustumCull()
+{
+}
+
+uint32_t FrustumCull::Add(const DirectX::BoundingSphere& sphere)
+{
+	uint32_t index = m_num++;
+	if (m_blocks.size() * 4 < m_num)
+	{
+		// 󂫗vf͏OԂɂĂ
+		Block block;
+		memset(&block, 0, sizeof(block));
+		block.r = DirectX::XMFLOAT4(DISABLE_RADIUS, DISABLE_RADIUS, DISABLE_RADIUS, DISABLE_RADIUS);
+		m_blocks.push_back(block);
+	}
+	Set(index, sphere);
+	return index;
+}
+uint32_t FrustumCull::Add(const DirectX::BoundingBox& box)
+{
+	uint32_t index = Add(DirectX::BoundingSphere());
+	Set(index, box);
+	return index;
+}
+void FrustumCull::Set(uint32_t index, const DirectX::BoundingSphere& sphere)
+{
+	// ͂AABBƂĈ
+	DirectX::XMFLOAT3 extents(sphere.Radius, sphere.Radius, sphere.Radius);
+	Write(index, sphere.Center, extents, sphere.Radius);
+}
+void FrustumCull::Set(uint32_t index, const DirectX::BoundingBox& box)
+{
+	// AABB͂ދ̔a
+	const DirectX::XMFLOAT3& e = box.Extents;
+	float radius = sqrtf(e.x * e.x + e.y * e.y + e.z * e.z);
+	Write(index, box.Center, box.Extents, radius);
+}
+void FrustumCull::Disable(uint32_t index)
+{
+	if (index >= m_num) { return; }
+	Block& block = m_blocks[index / 4];
+	(&block.r.x)[index % 4] = DISABLE_RADIUS;
+}
+void FrustumCull::Clear()
+{
+	m_blocks.clear();
+	m_num = 0;
+}
+uint32_t FrustumCull::GetNum()
+{
+	return m_num;
+}
+
+void FrustumCull::Write(uint32_t index, const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents, float radius)
+{
+	if (index >= m_num) { return; }
+	Block& block = m_blocks[index / 4];
+	uint32_t lane = index % 4;
+	(&block.x.x)[lane] = center.x;
+	(&block.y.x)[lane] = center.y;
+	(&block.z.x)[lane] = center.z;
+	(&block.ex.x)[lane] = extents.x;
+	(&block.ey.x)[lane] = extents.y;
+	(&block.ez.x)[lane] = extents.z;
+	(&block.r.x)[lane] = radius;
+}
+
+void FrustumCull::SetFrustum(DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj)
+{
+	MakePlanes(DirectX::XMMatrixMultiply(view, proj), m_planes);
+}
+void FrustumCull::SetFrustum(const DirectX::XMFLOAT4X4& viewProj)
+{
+	MakePlanes(DirectX::XMLoadFloat4x4(&viewProj), m_planes);
+}
+
+// r[~vWFNVs̗񂩂6ʂ쐬(D3D̐[x0`1
+void FrustumCull::MakePlanes(DirectX::FXMMATRIX viewProj, DirectX::XMFLOAT4* pPlanes)
+{
+	DirectX::XMMATRIX mat = DirectX::XMMatrixTranspose(viewProj);
+	DirectX::XMVECTOR planes[6] = {
+		DirectX::XMVectorAdd(mat.r[3], mat.r[0]),		// 
+		DirectX::XMVectorSubtract(mat.r[3], mat.r[0]),	// E
+		DirectX::XMVectorAdd(mat.r[3], mat.r[1]),		// 
+		DirectX::XMVectorSubtract(mat.r[3], mat.r[1]),	// 
+		mat.r[2],										// O
+		DirectX::XMVectorSubtract(mat.r[3], mat.r[2]),	// 
+	};
+	for (int i = 0; i < 6; ++i)
+	{
+		DirectX::XMStoreFloat4(&pPlanes[i], DirectX::XMPlaneNormalize(planes[i]));
+	}
+}
+
+uint32_t FrustumCull::Cull(std::vector<uint32_t>* pVisible)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	pVisible->clear();
+	pVisible->reserve(m_num);
+
+	// ʂ̊evf4[֓WJ
+	DirectX::XMVECTOR px[6], py[6], pz[6], pw[6];
+	DirectX::XMVECTOR ax[6], ay[6], az[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		DirectX::XMVECTOR plane = DirectX::XMLoadFloat4(&m_planes[i]);
+		px[i] = DirectX::XMVectorSplatX(plane);
+		py[i] = DirectX::XMVectorSplatY(plane);
+		pz[i] = DirectX::XMVectorSplatZ(plane);
+		pw[i] = DirectX::XMVectorSplatW(plane);
+		ax[i] = DirectX::XMVectorAbs(px[i]);
+		ay[i] = DirectX::XMVectorAbs(py[i]);
+		az[i] = DirectX::XMVectorAbs(pz[i]);
+	}
+
+	uint32_t blockNum = static_cast<uint32_t>(m_blocks.size());
+	for (uint32_t i = 0; i < blockNum; ++i)
+	{
+		const Block& block = m_blocks[i];
+		DirectX::XMVECTOR x = DirectX::XMLoadFloat4(&block.x);
+		DirectX::XMVECTOR y = DirectX::XMLoadFloat4(&block.y);
+		DirectX::XMVECTOR z = DirectX::XMLoadFloat4(&block.z);
+		DirectX::XMVECTOR ex = DirectX::XMLoadFloat4(&block.ex);
+		DirectX::XMVECTOR ey = DirectX::XMLoadFloat4(&block.ey);
+		DirectX::XMVECTOR ez = DirectX::XMLoadFloat4(&block.ez);
+		DirectX::XMVECTOR r = DirectX::XMLoadFloat4(&block.r);
+
+		// OꂽIuWFNg͍ŏOƂ
+		DirectX::XMVECTOR outside = DirectX::XMVectorLess(r, DirectX::XMVectorZero());
+		for (int j = 0; j < 6; ++j)
+		{
+			// Sƕʂ̋
+			DirectX::XMVECTOR dist = DirectX::XMVectorMultiplyAdd(px[j], x,
+				DirectX::XMVectorMultiplyAdd(py[j], y,
+				DirectX::XMVectorMultiplyAdd(pz[j], z, pw[j])));
+			// AABB𕽖ʂ̖@֓eaƋ̔ȁŔ
+			DirectX::XMVECTOR boxRadius = DirectX::XMVectorMultiplyAdd(ax[j], ex,
+				DirectX::XMVectorMultiplyAdd(ay[j], ey, DirectX::XMVectorMultiply(az[j], ez)));
+			DirectX::XMVECTOR radius = DirectX::XMVectorMin(boxRadius, r);
+			outside = DirectX::XMVectorOrInt(outside,
+				DirectX::XMVectorLess(dist, DirectX::XMVectorNegate(radius)));
+		}
+
+		// 4ƂOłΏo͂Ȃ
+		if (DirectX::XMVector4EqualInt(outside, DirectX::XMVectorTrueInt())) { continue; }
+
+		uint32_t mask[4];
+		DirectX::XMStoreInt4(mask, outside);
+		uint32_t base = i * 4;
+		for (uint32_t j = 0; j < 4; ++j)
+		{
+			if (!mask[j] && base + j < m_num)
+				pVisible->push_back(base + j);
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	m_stats.objectNum = m_num;
+	m_stats.visibleNum = static_cast<uint32_t>(pVisible->size());
+	m_stats.time = std::chrono::duration<float, std::milli>(end - start).count();
+	return m_stats.visibleNum;
+}
+
+const FrustumCull::Stats& FrustumCull::GetStats()
+{
+	return m_stats;
+}
@@ -0,0 +1,67 @@
+#ifndef __FRUSTUM_CULL_H__
+#define __FRUSTUM_CULL_H__
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <vector>
+#include <stdint.h>
+
+// JO
+// [hԂ̋E(+AABB)4܂Ƃ߂\̔z(SoA)ŕێA
+// 6ʂƂ̔4IuWFNgɍsāA\IuWFNg̔ԍo͂
+class FrustumCull
+{
+public:
+	// ̏Wv
+	struct Stats
+	{
+		uint32_t	objectNum;	// 肵IuWFNg
+		uint32_t	visibleNum;	// \IuWFNg
+		float		time;		// ɂ(~b
+	};
+
+public:
+	FrustumCull();
+	~FrustumCull();
+
+	// E̓o^(߂l͓o^ԍACull̏o͂̔ԍɂȂ
+	uint32_t Add(const DirectX::BoundingSphere& sphere);
+	uint32_t Add(const DirectX::BoundingBox& box);
+	// o^ς݂̋E̍XV
+	void Set(uint32_t index, const DirectX::BoundingSphere& sphere);
+	void Set(uint32_t index, const DirectX::BoundingBox& box);
+	// 肩珜O(ԍ͋l߂Ȃ
+	void Disable(uint32_t index);
+	void Clear();
+	uint32_t GetNum();
+
+	// ̐ݒ(]uĂȂr[AvWFNVs
+	void SetFrustum(DirectX::FXMMATRIX view, DirectX::CXMMATRIX proj);
+	void SetFrustum(const DirectX::XMFLOAT4X4& viewProj);
+
+	// 肵āA\IuWFNg̔ԍpVisible֏o
+	uint32_t Cull(std::vector<uint32_t>* pVisible);
+	const Stats& GetStats();
+
+	// ̕(@͓
+	static void MakePlanes(DirectX::FXMMATRIX viewProj, DirectX::XMFLOAT4* pPlanes);
+
+private:
+	// 4IuWFNg̋E
+	struct Block
+	{
+		DirectX::XMFLOAT4 x, y, z;		// S
+		DirectX::XMFLOAT4 ex, ey, ez;	// AABB̔a
+		DirectX::XMFLOAT4 r;			// ̔a
+	};
+
+	void Write(uint32_t index, const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents, float radius);
+
+private:
+	std::vector<Block>	m_blocks;
+	uint32_t				m_num;
+	DirectX::XMFLOAT4	m_planes[6];
+	Stats				m_stats;
+};
+
+#endif // __FRUSTUM_CULL_H__
@@ -1,15 +1,20 @@
 #include "Geometory.h"
+#include <string.h>
 
 MeshBuffer* Geometory::m_pBox;
 MeshBuffer* Geometory::m_pCylinder;
 MeshBuffer* Geometory::m_pSphere;
-MeshBuffer* Geometory::m_pLines;
 Shader* Geometory::m_pVS;
 Shader* Geometory::m_pPS;
 Shader* Geometory::m_pLineShader[2];
+Shader* Geometory::m_pShapeVS;
 DirectX::XMFLOAT4X4 Geometory::m_WVP[3];
-void* Geometory::m_pLineVtx;
-int Geometory::m_lineCnt = 0;
+std::atomic<Geometory::Batch*> Geometory::m_pBatches(nullptr);
+std::atomic<UINT> Geometory::m_batchGeneration(0);
+ID3D11Buffer* Geometory::m_pRingBuffer;
+UINT Geometory::m_ringSize = 0;
+UINT Geometory::m_ringOffset = 0;
+UINT Geometory::m_ringMapSize = 0;
 
 void Geometory::Init()
 {
@@ -21,16 +26,27 @@ void Geometory::Init()
 	MakeVS();
 	MakePS();
 	MakeLineShader();
-	MakeLine();
+	MakeShapeShader();
+	++m_batchGeneration;
+	ReserveRing(RING_SIZE_MIN);
 }
 void Geometory::Uninit()
 {
-	SAFE_DELETE_ARRAY(m_pLineVtx);
+	Batch* pBatch = m_pBatches.exchange(nullptr);
+	while (pBatch)
+	{
+		Batch* pNext = pBatch->pNext;
+		delete pBatch;
+		pBatch = pNext;
+	}
+	++m_batchGeneration;
+	SAFE_RELEASE(m_pRingBuffer);
+	m_ringSize = 0;
+	SAFE_DELETE(m_pShapeVS);
 	SAFE_DELETE(m_pLineShader[1]);
 	SAFE_DELETE(m_pLineShader[0]);
 	SAFE_DELETE(m_pPS);
 	SAFE_DELETE(m_pVS);
-	SAFE_DELETE(m_pLines);
 	SAFE_DELETE(m_pSphere);
 	SAFE_DELETE(m_pCylinder);
 	SAFE_DELETE(m_pBox);
@@ -51,22 +67,171 @@ void Geometory::SetProjection(DirectX::XMFLOAT4X4 proj)
 
 void Geometory::AddLine(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end, DirectX::XMFLOAT4 color)
 {
-	if (m_lineCnt < MAX_LINE_NUM)
-	{
-		LineVertex* pVtx = reinterpret_cast<LineVertex*>(m_pLineVtx);
-		pVtx[m_lineCnt * 2 + 0] = { start.x, start.y, start.z, color.x, color.y, color.z, color.w};
-		pVtx[m_lineCnt * 2 + 1] = { end.x, end.y, end.z, color.x, color.y, color.z, color.w };
-		++m_lineCnt;
-	}
+	std::vector<LineVertex>& lines = GetThreadBatch()->lines;
+	lines.push_back({ start.x, start.y, start.z, color.x, color.y, color.z, color.w });
+	lines.push_back({ end.x, end.y, end.z, color.x, color.y, color.z, color.w });
 }
 void Geometory::DrawLines()
 {
+	// SXbh̒_v
+	UINT vtxNum = 0;
+	for (Batch* pBatch = m_pBatches.load(std::memory_order_acquire); pBatch; pBatch = pBatch->pNext)
+		vtxNum += static_cast<UINT>(pBatch->lines.size());
+	if (vtxNum == 0) { return; }
+
+	// gp͈͂̂ݏ
+	UINT start = 0;
+	LineVertex* pDst = static_cast<LineVertex*>(MapRing(sizeof(LineVertex), vtxNum, &start));
+	for (Batch* pBatch = m_pBatches.load(std::memory_order_acquire); pBatch; pBatch = pBatch->pNext)
+	{
+		std::vector<LineVertex>& lines = pBatch->lines;
+		if (pDst && !lines.empty())
+		{
+			memcpy(pDst, lines.data(), sizeof(LineVertex) * lines.size());
+			pDst += lines.size();
+		}
+		lines.clear();
+	}
+	if (!pDst) { return; }
+	UnmapRing();
+
 	m_pLineShader[0]->WriteBuffer(0, m_WVP);
 	m_pLineShader[0]->Bind();
 	m_pLineShader[1]->Bind();
-	m_pLines->Write(m_pLineVtx);
-	m_pLines->Draw(m_lineCnt * 2);
-	m_lineCnt = 0;
+	RenderContext* pContext = GetContext();
+	UINT stride = sizeof(LineVertex);
+	UINT offset = 0;
+	pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+	pContext->IASetVertexBuffers(0, 1, &m_pRingBuffer, &stride, &offset);
+	ConstantBufferRing::Flush();
+	pContext->Draw(vtxNum, start);
+}
+
+void Geometory::AddBox(const DirectX::XMFLOAT4X4& world, DirectX::XMFLOAT4 color)
+{
+	AddShape(SHAPE_BOX, world, color);
+}
+void Geometory::AddCylinder(const DirectX::XMFLOAT4X4& world, DirectX::XMFLOAT4 color)
+{
+	AddShape(SHAPE_CYLINDER, world, color);
+}
+void Geometory::AddSphere(const DirectX::XMFLOAT4X4& world, DirectX::XMFLOAT4 color)
+{
+	AddShape(SHAPE_SPHERE, world, color);
+}
+void Geometory::AddShape(ShapeKind kind, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4& color)
+{
+	ShapeInstance inst = { world, color };
+	GetThreadBatch()->shapes[kind].push_back(inst);
+}
+void Geometory::DrawShapes()
+{
+	MeshBuffer* pMeshes[SHAPE_MAX] = { m_pBox, m_pCylinder, m_pSphere };
+	bool isBind = false;
+	for (int kind = 0; kind < SHAPE_MAX; ++kind)
+	{
+		// SXbh̐v
+		UINT num = 0;
+		for (Batch* pBatch = m_pBatches.load(std::memory_order_acquire); pBatch; pBatch = pBatch->pNext)
+			num += static_cast<UINT>(pBatch->shapes[kind].size());
+		if (num == 0) { continue; }
+
+		// ނƂɃO֑ď݁A܂Ƃ߂ĕ`
+		UINT start = 0;
+		ShapeInstance* pDst = pMeshes[kind] ?
+			static_cast<ShapeInstance*>(MapRing(sizeof(ShapeInstance), num, &start)) : nullptr;
+		for (Batch* pBatch = m_pBatches.load(std::memory_order_acquire); pBatch; pBatch = pBatch->pNext)
+		{
+			std::vector<ShapeInstance>& shapes = pBatch->shapes[kind];
+			if (pDst && !shapes.empty())
+			{
+				memcpy(pDst, shapes.data(), sizeof(ShapeInstance) * shapes.size());
+				pDst += shapes.size();
+			}
+			shapes.clear();
+		}
+		if (!pDst) { continue; }
+		UnmapRing();
+
+		if (!isBind)
+		{
+			m_pShapeVS->WriteBuffer(0, m_WVP);
+			m_pShapeVS->Bind();
+			m_pLineShader[1]->Bind();
+			isBind = true;
+		}
+		pMeshes[kind]->DrawInstanced(m_pRingBuffer, sizeof(ShapeInstance), num, start);
+	}
+}
+
+// ĂяoXbh̒ǉ
+// ʂ̃XbhƓɒǉĂAXg̐擪̍ւ݂̂œo^
+Geometory::Batch* Geometory::GetThreadBatch()
+{
+	thread_local Batch* pBatch = nullptr;
+	thread_local UINT generation = 0;
+	UINT current = m_batchGeneration.load(std::memory_order_acquire);
+	if (pBatch && generation == current)
+		return pBatch;
+
+	pBatch = new Batch();
+	generation = current;
+	pBatch->pNext = m_pBatches.load(std::memory_order_relaxed);
+	while (!m_pBatches.compare_exchange_weak(pBatch->pNext, pBatch,
+		std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+	return pBatch;
+}
+
+void* Geometory::MapRing(UINT stride, UINT num, UINT* pStart)
+{
+	UINT size = stride * num;
+	if (FAILED(ReserveRing(size))) { return nullptr; }
+
+	// Ȍ݂ɑď݁A肫ȂΊmۂĐ擪
+	UINT start = (m_ringOffset + stride - 1) / stride;
+	D3D11_MAP type = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (static_cast<UINT64>(start) * stride + size > m_ringSize)
+	{
+		type = D3D11_MAP_WRITE_DISCARD;
+		start = 0;
+	}
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(GetContext()->Map(m_pRingBuffer, 0, type, 0, &mapped))) { return nullptr; }
+	m_ringOffset = start * stride + size;
+	m_ringMapSize = size;
+	*pStart = start;
+	return static_cast<char*>(mapped.pData) + start * stride;
+}
+void Geometory::UnmapRing()
+{
+	GetContext()->UnmapRange(m_pRingBuffer, 0, m_ringOffset - m_ringMapSize, m_ringMapSize);
+}
+
+// Oobt@size肫傫ɂ
+HRESULT Geometory::ReserveRing(UINT size)
+{
+	if (m_pRingBuffer && size <= m_ringSize) { return S_OK; }
+
+	UINT ringSize = m_ringSize > RING_SIZE_MIN ? m_ringSize : RING_SIZE_MIN;
+	while (ringSize < size)
+		ringSize *= 2;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = ringSize;
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	ID3D11Buffer* pBuffer = nullptr;
+	HRESULT hr = GetDevice()->CreateBuffer(&desc, nullptr, &pBuffer);
+	if (FAILED(hr)) { return hr; }
+
+	SAFE_RELEASE(m_pRingBuffer);
+	m_pRingBuffer = pBuffer;
+	m_ringSize = ringSize;
+	m_ringOffset = ringSize;	// 쐬DISCARDŏ܂
+	return S_OK;
 }
 
 void Geometory::DrawBox()
@@ -199,16 +364,37 @@ float4 main(PS_IN pin) : SV_TARGET0 {
 	m_pLineShader[1] = new PixelShader();
 	m_pLineShader[1]->Compile(PSCode);
 }
-void Geometory::MakeLine()
-{
-	m_pLineVtx = new LineVertex[MAX_LINE_NUM * 2];
-	m_lineCnt = 0;
-	MeshBuffer::Description desc = {};
-	desc.pVtx = m_pLineVtx;
-	desc.vtxCount = MAX_LINE_NUM * 2;
-	desc.vtxSize = sizeof(LineVertex);
-	desc.topology = D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
-	desc.isWrite = true;
-	m_pLines = new MeshBuffer();
-	m_pLines->Create(desc);
-}
\ No newline at end of file
+void Geometory::MakeShapeShader()
+{
+	const char* VSCode = R"EOT(
+struct VS_IN {
+	float3 pos : POSITION0;
+	float4 world0 : INSTANCE0;
+	float4 world1 : INSTANCE1;
+	float4 world2 : INSTANCE2;
+	float4 world3 : INSTANCE3;
+	float4 color : INSTANCE4;
+};
+struct VS_OUT {
+	float4 pos : SV_POSITION;
+	float4 color : COLOR0;
+};
+cbuffer Matrix : register(b0) {
+	float4x4 world;
+	float4x4 view;
+	float4x4 proj;
+};
+VS_OUT main(VS_IN vin) {
+	VS_OUT vout;
+	float4x4 instWorld = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+	vout.pos = float4(vin.pos, 1.0f);
+	vout.pos = mul(vout.pos, instWorld);
+	vout.pos = mul(vout.pos, view);
+	vout.pos = mul(vout.pos, proj);
+	vout.color = vin.color;
+	return vout;
+})EOT";
+
+	m_pShapeVS = new VertexShader();
+	m_pShapeVS->Compile(VSCode);
+}
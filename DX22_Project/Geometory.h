@@ -4,6 +4,8 @@
 #include <DirectXMath.h>
 #include "Shader.h"
 #include "MeshBuffer.h"
+#include <vector>
+#include <atomic>
 
 class Geometory
 {
@@ -18,6 +20,19 @@ private:
 		float pos[3];
 		float uv[2];
 	};
+	// `̃CX^XƂ̃f[^(_VF[_[INSTANCE0`4ɑΉ
+	struct ShapeInstance
+	{
+		DirectX::XMFLOAT4X4 world;
+		DirectX::XMFLOAT4 color;
+	};
+	enum ShapeKind
+	{
+		SHAPE_BOX,
+		SHAPE_CYLINDER,
+		SHAPE_SPHERE,
+		SHAPE_MAX
+	};
 public:
 	static void Init();
 	static void Uninit();
@@ -26,9 +41,21 @@ public:
 	static void SetView(DirectX::XMFLOAT4X4 view);
 	static void SetProjection(DirectX::XMFLOAT4X4 proj);
 
+	// ̒ǉ(ǂ̃XbhłĂяoȀȂ
 	static void AddLine(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end,
 		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+	// ǉꂽ܂Ƃ߂ĕ`(`XbhŌĂяoA1t[ɉxĂяoĂ悢
+	// ̃XbhłAddLine͌ĂяoOɏIĂ
 	static void DrawLines();
+	// `̒ǉ(ǂ̃XbhłĂяoAworld͓]uɐݒ肷
+	static void AddBox(const DirectX::XMFLOAT4X4& world,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+	static void AddCylinder(const DirectX::XMFLOAT4X4& world,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+	static void AddSphere(const DirectX::XMFLOAT4X4& world,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+	// ǉꂽ`ނƂ1̃CX^X`ŕ`(DrawLinesƓ`XbhŌĂяo
+	static void DrawShapes();
 	static void DrawBox();
 	static void DrawCylinder();
 	static void DrawSphere();
@@ -37,7 +64,13 @@ private:
 	static void MakeVS();
 	static void MakePS();
 	static void MakeLineShader();
-	static void MakeLine();
+	static void MakeShapeShader();
+	static void AddShape(ShapeKind kind, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4& color);
+	// A`ŋL郊Oobt@ւ̏
+	// stride̔{̈ʒunummۂďݐԂ(pStartɂ͐擪̗vfԍ
+	static void* MapRing(UINT stride, UINT num, UINT* pStart);
+	static void UnmapRing();
+	static HRESULT ReserveRing(UINT size);
 
 private:
 	static void MakeBox();
@@ -45,19 +78,34 @@ private:
 	static void MakeSphere();
 
 private:
-	static const int MAX_LINE_NUM = 1000;
+	// XbhƂɒǉꂽA`
+	// ߂ĒǉXbhō쐬ăXg̐擪֒ǉAUninit܂ŕێ
+	struct Batch
+	{
+		std::vector<LineVertex> lines;
+		std::vector<ShapeInstance> shapes[SHAPE_MAX];
+		Batch* pNext;
+	};
+	static Batch* GetThreadBatch();
+
+private:
+	static const UINT RING_SIZE_MIN = 64 * 1024;	// Oobt@̍ŏ̑傫
 	static const int CIRCLE_DETAIL = 16;
 private:
 	static MeshBuffer* m_pBox;
 	static MeshBuffer* m_pCylinder;
 	static MeshBuffer* m_pSphere;
-	static MeshBuffer* m_pLines;
 	static Shader* m_pVS;
 	static Shader* m_pPS;
 	static Shader* m_pLineShader[2];
+	static Shader* m_pShapeVS;	// sNZVF[_[͐Ƌ
 	static DirectX::XMFLOAT4X4 m_WVP[3];
-	static void* m_pLineVtx;
-	static int m_lineCnt;
+	static std::atomic<Batch*> m_pBatches;
+	static std::atomic<UINT> m_batchGeneration;	// InitAUninit̂тɕςAXbhێĂ郊Xg蒼
+	static ID3D11Buffer* m_pRingBuffer;	// ̒_A`̃CX^Xf[^(ȂȂΑ傫
+	static UINT m_ringSize;
+	static UINT m_ringOffset;	// ɏވʒu(NO_OVERWRITEŒǋLADISCARD
+	static UINT m_ringMapSize;	// MapRingŏ܂Ă傫
 };
 
 #endif // __GEOMETORY_H__
\ No newline at end of file
@@ -3,10 +3,16 @@
 #include "DirectX.h"
 #include "Geometory.h"
 #include "Sprite.h"
+#include "SpriteBatch.h"
 #include "Input.h"
 #include "SceneGame.h"
 #include "Defines.h"
 #include "ShaderList.h"
+#include "AssetIO.h"
+#include "RenderQueue.h"
+#include "RenderJobs.h"
+#include "ConstantBufferRing.h"
+#include "TextureStream.h"
 
 //--- O[oϐ
 SceneGame* g_pGame;
@@ -17,12 +23,18 @@ HRESULT Init(HWND hWnd, UINT width, UINT height)
 	// DirectX
 	hr = InitDirectX(hWnd, width, height, false);
 	if (FAILED(hr)) { return hr; }
+	hr = ConstantBufferRing::Init();
+	if (FAILED(hr)) { return hr; }
 
 	// @\
 	Geometory::Init();
 	Sprite::Init();
+	SpriteBatch::Init();
+	RenderQueue::Init();
+	RenderJobs::Init();
 	InitInput();
 	ShaderList::Init();
+	TextureStream::Init();
 
 	// V[쐬
 	g_pGame = new SceneGame();
@@ -33,22 +45,30 @@ HRESULT Init(HWND hWnd, UINT width, UINT height)
 void Uninit()
 {
 	delete g_pGame;
+	AssetIOSystem::ReleaseAll();
+	TextureStream::Uninit();
 	ShaderList::Uninit();
 	UninitInput();
+	RenderJobs::Uninit();
+	RenderQueue::Uninit();
+	SpriteBatch::Uninit();
 	Sprite::Uninit();
 	Geometory::Uninit();
+	ConstantBufferRing::Uninit();
 	UninitDirectX();
 }
 
 void Update()
 {
 	UpdateInput();
+	TextureStream::Update();
 	g_pGame->Update();
 }
 
 void Draw()
 {
 	BeginDrawDirectX();
+	ConstantBufferRing::BeginFrame();
 
 	// ̕\
 #ifdef _DEBUG
@@ -112,6 +132,14 @@ void Draw()
 #endif
 
 	g_pGame->Draw();
+	RenderQueue::Flush();
+
+	// V[ŒǉꂽfobO\
+	Geometory::DrawShapes();
+	Geometory::DrawLines();
+
+	// UIȂǂ̃XvCg͍Ōɂ܂Ƃ߂ĕ`
+	SpriteBatch::Flush();
 	EndDrawDirectX();
 }
 
@@ -1,4 +1,5 @@
 #include "MeshBuffer.h"
+#include "ConstantBufferRing.h"
 
 MeshBuffer::MeshBuffer()
 	: m_pVtxBuffer(NULL), m_pIdxBuffer(NULL), m_desc{}
@@ -6,39 +7,33 @@ MeshBuffer::MeshBuffer()
 }
 MeshBuffer::~MeshBuffer()
 {
-	SAFE_DELETE_ARRAY(m_desc.pIdx);
-	SAFE_DELETE_ARRAY(m_desc.pVtx);
 	SAFE_RELEASE(m_pIdxBuffer);
 	SAFE_RELEASE(m_pVtxBuffer);
 }
 
 HRESULT MeshBuffer::Create(const Description& desc)
 {
-	HRESULT hr = E_FAIL;
-
-	// _obt@쐬
-	hr = CreateVertexBuffer(desc.pVtx, desc.vtxSize, desc.vtxCount, desc.isWrite);
+	HRESULT hr = CreateBuffer(desc);
 	if (FAILED(hr)) { return hr; }
 
-	// CfbNXobt@쐬
-	if (desc.pIdx) {
-		hr = CreateIndexBuffer(desc.pIdx, desc.idxSize, desc.idxCount);
-		if (FAILED(hr)) { return hr; }
-	}
-
 	// obt@̃Rs[
 	m_desc = desc;
+	m_desc.pVtx = nullptr;
+	m_desc.pIdx = nullptr;
+	if (desc.isGPUOnly) { return hr; }
 
 	// _ACfbNX̏Rs[
-	rsize_t vtxMemSize = desc.vtxSize * desc.vtxCount;
-	void* pVtx = new char[vtxMemSize];
-	memcpy_s(pVtx, vtxMemSize, desc.pVtx, vtxMemSize);
-	m_desc.pVtx = pVtx;
-	if (m_desc.pIdx) {
-		rsize_t idxMemSize = desc.idxSize * desc.idxCount;
-		void* pIdx = new char[idxMemSize];
-		memcpy_s(pIdx, idxMemSize, desc.pIdx, idxMemSize);
-		m_desc.pIdx = pIdx;
+	const char* pVtx = reinterpret_cast<const char*>(desc.pVtx);
+	std::shared_ptr<std::vector<char>> pVtxCopy = std::make_shared<std::vector<char>>(
+		pVtx, pVtx + desc.vtxSize * desc.vtxCount);
+	m_desc.pVtx = pVtxCopy->data();
+	m_pVtxData = pVtxCopy;
+	if (desc.pIdx) {
+		const char* pIdx = reinterpret_cast<const char*>(desc.pIdx);
+		std::shared_ptr<std::vector<char>> pIdxCopy = std::make_shared<std::vector<char>>(
+			pIdx, pIdx + desc.idxSize * desc.idxCount);
+		m_desc.pIdx = pIdxCopy->data();
+		m_pIdxData = pIdxCopy;
 	}
 
 	return hr;
@@ -47,12 +42,13 @@ HRESULT MeshBuffer::Create(const Description& desc)
 
 void MeshBuffer::Draw(int count)
 {
-	ID3D11DeviceContext* pContext = GetContext();
+	RenderContext* pContext = GetContext();
 	UINT stride = m_desc.vtxSize;
 	UINT offset = 0;
 
 	pContext->IASetPrimitiveTopology(m_desc.topology);
 	pContext->IASetVertexBuffers(0, 1, &m_pVtxBuffer, &stride, &offset);
+	ConstantBufferRing::Flush();
 
 	// `
 	if (m_desc.idxCount > 0)
@@ -74,13 +70,38 @@ void MeshBuffer::Draw(int count)
 
 }
 
+// CX^XƂ̃f[^𒸓_Xbg1ɐݒ肵ăCX^X`
+void MeshBuffer::DrawInstanced(ID3D11Buffer* pInstance, UINT instanceSize, UINT instanceNum, UINT startInstance)
+{
+	RenderContext* pContext = GetContext();
+	ID3D11Buffer* pBuffers[] = { m_pVtxBuffer, pInstance };
+	UINT strides[] = { m_desc.vtxSize, instanceSize };
+	UINT offsets[] = { 0, 0 };
+
+	pContext->IASetPrimitiveTopology(m_desc.topology);
+	pContext->IASetVertexBuffers(0, 2, pBuffers, strides, offsets);
+	ConstantBufferRing::Flush();
+
+	// `
+	if (m_desc.idxCount > 0)
+	{
+		DXGI_FORMAT format = m_desc.idxSize == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+		pContext->IASetIndexBuffer(m_pIdxBuffer, format, 0);
+		pContext->DrawIndexedInstanced(m_desc.idxCount, instanceNum, 0, 0, startInstance);
+	}
+	else
+	{
+		pContext->DrawInstanced(m_desc.vtxCount, instanceNum, 0, startInstance);
+	}
+}
+
 HRESULT MeshBuffer::Write(void* pVtx)
 {
 	if (!m_desc.isWrite) { return E_FAIL; }
 
 	HRESULT hr;
 	ID3D11Device* pDevice = GetDevice();
-	ID3D11DeviceContext* pContext = GetContext();
+	RenderContext* pContext = GetContext();
 	D3D11_MAPPED_SUBRESOURCE mapResource;
 
 	// f[^Rs[
@@ -94,11 +115,38 @@ HRESULT MeshBuffer::Write(void* pVtx)
 	return hr;
 }
 
+// CPUɕێĂ钸_ACfbNX
+// (蔻̍\zȂǂŃf[^svɂȂ_ŌĂяo
+void MeshBuffer::ReleaseData()
+{
+	m_pVtxData.reset();
+	m_pIdxData.reset();
+	m_desc.pVtx = nullptr;
+	m_desc.pIdx = nullptr;
+}
+
 MeshBuffer::Description MeshBuffer::GetDesc()
 {
 	return m_desc;
 }
 
+HRESULT MeshBuffer::CreateBuffer(const Description& desc)
+{
+	HRESULT hr = E_FAIL;
+
+	// _obt@쐬
+	hr = CreateVertexBuffer(desc.pVtx, desc.vtxSize, desc.vtxCount, desc.isWrite);
+	if (FAILED(hr)) { return hr; }
+
+	// CfbNXobt@쐬
+	if (desc.pIdx) {
+		hr = CreateIndexBuffer(desc.pIdx, desc.idxSize, desc.idxCount);
+		if (FAILED(hr)) { return hr; }
+	}
+
+	return hr;
+}
+
 HRESULT MeshBuffer::CreateVertexBuffer(const void* pVtx, UINT size, UINT count, bool isWrite)
 {
 	//--- 쐬obt@̏
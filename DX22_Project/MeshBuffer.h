@@ -2,6 +2,8 @@
 #define __MESH_BUFFER_H__
 
 #include "DirectX.h"
+#include <memory>
+#include <vector>
 
 class MeshBuffer
 {
@@ -16,18 +18,24 @@ public:
 		UINT idxSize;
 		UINT idxCount;
 		D3D11_PRIMITIVE_TOPOLOGY topology;
+		bool isGPUOnly;	// GPUւ̓]CPŨf[^ێȂ
 	};
 public:
 	MeshBuffer();
 	~MeshBuffer();
 
 	HRESULT Create(const Description& desc);
+	template<class Vtx, class Idx>
+	HRESULT Create(const Description& desc, std::vector<Vtx>&& vtx, std::vector<Idx>&& idx);
 	void Draw(int count = 0);
+	void DrawInstanced(ID3D11Buffer* pInstance, UINT instanceSize, UINT instanceNum, UINT startInstance = 0);
 	HRESULT Write(void* pVtx);
+	void ReleaseData();
 
 	Description GetDesc();
 
 private:
+	HRESULT CreateBuffer(const Description& desc);
 	HRESULT CreateVertexBuffer(const void* pIdx, UINT size, UINT count, bool isWrite);
 	HRESULT CreateIndexBuffer(const void* pVtx, UINT size, UINT count);
 
@@ -35,7 +43,49 @@ private:
 	ID3D11Buffer* m_pVtxBuffer;
 	ID3D11Buffer* m_pIdxBuffer;
 	Description m_desc;
+	std::shared_ptr<void> m_pVtxData;	// CPU̒_f[^
+	std::shared_ptr<void> m_pIdxData;	// CPŨCfbNXf[^
 
 };
 
-#endif // __MESH_BUFFER_H__
\ No newline at end of file
+// _ECfbNXz̏L󂯎ăobt@쐬
+// (desc̃f[^֘A̍ڂ͔z񂩂ݒ肵Az̓Rs[ɓֈړ
+template<class Vtx, class Idx>
+HRESULT MeshBuffer::Create(const Description& desc, std::vector<Vtx>&& vtx, std::vector<Idx>&& idx)
+{
+	Description data = desc;
+	data.pVtx = vtx.data();
+	data.vtxSize = sizeof(Vtx);
+	data.vtxCount = static_cast<UINT>(vtx.size());
+	data.pIdx = idx.empty() ? nullptr : idx.data();
+	data.idxSize = sizeof(Idx);
+	data.idxCount = static_cast<UINT>(idx.size());
+
+	HRESULT hr = CreateBuffer(data);
+	if (FAILED(hr)) { return hr; }
+	m_desc = data;
+
+	// GPUpł΁A]ς݂̃f[^̏ŉ
+	if (desc.isGPUOnly)
+	{
+		std::vector<Vtx>().swap(vtx);
+		std::vector<Idx>().swap(idx);
+		m_desc.pVtx = nullptr;
+		m_desc.pIdx = nullptr;
+		return hr;
+	}
+
+	// z񂲂ƏLڂ(|C^͈ړςȂ
+	std::shared_ptr<std::vector<Vtx>> pVtx = std::make_shared<std::vector<Vtx>>(std::move(vtx));
+	m_desc.pVtx = pVtx->data();
+	m_pVtxData = pVtx;
+	if (m_desc.pIdx)
+	{
+		std::shared_ptr<std::vector<Idx>> pIdx = std::make_shared<std::vector<Idx>>(std::move(idx));
+		m_desc.pIdx = pIdx->data();
+		m_pIdxData = pIdx;
+	}
+	return hr;
+}
+
+#endif // __MESH_BUFFER_H__
@@ -1,9 +1,16 @@
 #include "Model.h"
+#include "AssetIO.h"
+#include "SkinWeight.h"
 #include "DirectXTex/TextureLoad.h"
+#include "TextureStream.h"
 #include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstring>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <assimp/config.h>
 
 #ifdef _DEBUG
 #include "Geometory.h"
@@ -29,10 +36,15 @@
 #endif
 #endif
 
+// ShaderList̃sNZVF[_[Ɠzũ}eA̒萔obt@
+static const char* MATERIAL_BUFFER_NAME = "Material";
+
 // staticoϐ`
 VertexShader*	Model::m_pDefVS		= nullptr;
 PixelShader*	Model::m_pDefPS		= nullptr;
 unsigned int	Model::m_shaderRef	= 0;
+ID3D11Buffer*	Model::m_pInstanceBuffer	= nullptr;
+UINT			Model::m_instanceMax		= 0;
 #ifdef _DEBUG
 std::string		Model::m_errorStr	= "";
 #endif
@@ -52,6 +64,38 @@ DirectX::XMMATRIX GetMatrixFromAssimpMatrix(aiMatrix4x4 M)
 	);
 }
 
+/*
+* @brief ̃nbVlvZ(FNV-1a
+* @param[in] str 
+* @return nbVl
+*/
+size_t GetNameHash(const char* str)
+{
+	size_t hash = static_cast<size_t>(14695981039346656037ULL);
+	while (*str)
+	{
+		hash ^= static_cast<unsigned char>(*str);
+		hash *= static_cast<size_t>(1099511628211ULL);
+		++str;
+	}
+	return hash;
+}
+
+/*
+* @brief assimp̃m[h𐔂
+* @param[in] pNode n߂m[h
+* @return q܂߂m[h
+*/
+UINT CountAssimpNode(const aiNode* pNode)
+{
+	UINT num = 1;
+	for (UINT i = 0; i < pNode->mNumChildren; ++i)
+	{
+		num += CountAssimpNode(pNode->mChildren[i]);
+	}
+	return num;
+}
+
 /*
 * @brief ftHg̃VF[_[쐬
 * @param[out] vs _VF[_[i[
@@ -105,6 +149,12 @@ float4 main(PS_IN pin) : SV_TARGET
 Model::Model()
 	: m_loadScale(1.0f)
 	, m_loadFlip(None)
+	, m_loadGPUOnly(false)
+	, m_pLoadArena(nullptr)
+	, m_requestFrame(UINT_MAX)
+#ifdef _DEBUG
+	, m_loadAllocNum(0)
+#endif
 	, m_playNo(ANIME_NONE)
 	, m_blendNo(ANIME_NONE)
 	, m_parametric{ANIME_NONE, ANIME_NONE}
@@ -133,6 +183,8 @@ Model::~Model()
 	{
 		delete m_pDefPS;
 		delete m_pDefVS;
+		SAFE_RELEASE(m_pInstanceBuffer);
+		m_instanceMax = 0;
 	}
 }
 
@@ -152,6 +204,7 @@ void Model::Reset()
 	while (matIt != m_materials.end())
 	{
 		if (matIt->pTexture) delete matIt->pTexture;
+		SAFE_RELEASE(matIt->pBuffer);
 		++matIt;
 	}
 }
@@ -177,9 +230,10 @@ void Model::SetPixelShader(PixelShader* ps)
 * @param[in] file ǂݍރft@Cւ̃pX
 * @param[in] scale f̃TCYύX
 * @param[in] flip ]ݒ
+* @param[in] gpuOnly ]CPU̒_f[^j(蔻ȂǂŎgꍇfalse
 * @return ǂݍ݌
 */
-bool Model::Load(const char* file, float scale, Flip flip)
+bool Model::Load(const char* file, float scale, Flip flip, bool gpuOnly)
 {
 #ifdef _DEBUG
 	m_errorStr = "";
@@ -188,6 +242,7 @@ bool Model::Load(const char* file, float scale, Flip flip)
 
 	// assimp̐ݒ
 	Assimp::Importer importer;
+	importer.SetIOHandler(new AssetIOSystem());	// ImporterŔj
 	int flag = 0;
 	flag |= aiProcess_Triangulate;
 	flag |= aiProcess_FlipUVs;
@@ -205,6 +260,7 @@ bool Model::Load(const char* file, float scale, Flip flip)
 	// ǂݍݎ̐ݒۑ
 	m_loadScale = scale;
 	m_loadFlip = flip;
+	m_loadGPUOnly = gpuOnly;
 
 	// fBNg̓ǂݎ
 	std::string directory = file;
@@ -216,6 +272,10 @@ bool Model::Load(const char* file, float scale, Flip flip)
 	}
 	directory = directory.substr(0, directory.find_last_of('\\') + 1);
 
+	// ǂݍݒ̈ꎞf[^͂܂Ƃ߂ĊmۂAǂݍݏIɂ܂Ƃ߂ĉ
+	Arena arena;
+	m_pLoadArena = &arena;
+
 	// m[h̍쐬
 	MakeBoneNodes(pScene);
 	// bV쐬
@@ -223,16 +283,22 @@ bool Model::Load(const char* file, float scale, Flip flip)
 	// }eA̍쐬
 	MakeMaterial(pScene, directory);
 
+#ifdef _DEBUG
+	m_loadAllocNum = arena.GetAllocNum();
+#endif
+	m_pLoadArena = nullptr;
 	return true;
 }
 
 /*
 * @brief `
 * @param[in] order `揇
-* @param[in] func bV`R[obN
+* @param[in] func bV`R[obN(w肵Ȃꍇ̓}eAݒ
 */
 void Model::Draw(const std::vector<UINT>* order, std::function<void(int)> func)
 {
+	RequestDrawTextures();
+
 	// VF[_[ݒ
 	m_pVS->Bind();
 	m_pPS->Bind();
@@ -261,7 +327,7 @@ void Model::Draw(const std::vector<UINT>* order, std::function<void(int)> func)
 		}
 		else
 		{
-			m_pPS->SetTexture(0, m_materials[m_meshes[meshNo].materialID].pTexture);
+			BindMaterial(m_materials[m_meshes[meshNo].materialID]);
 		}
 
 		// `
@@ -269,6 +335,158 @@ void Model::Draw(const std::vector<UINT>* order, std::function<void(int)> func)
 	}
 }
 
+/*
+* @brief CX^X`
+*  bVƂɈxDrawIndexedInstancedőSCX^X`悷
+* @param[in] pInstances CX^XƂ̃f[^
+* @param[in] num CX^X
+* @param[in] func `R[obN(DrawƓl
+*/
+void Model::DrawInstanced(const InstanceData* pInstances, UINT num, std::function<void(int)> func)
+{
+	if (num == 0) { return; }
+	RequestDrawTextures();
+
+	// ]悪Ȃ΍蒼
+	if (m_instanceMax < num)
+	{
+		SAFE_RELEASE(m_pInstanceBuffer);
+		m_instanceMax = 0;
+		UINT size = 1024;
+		while (size < num)
+			size <<= 1;
+
+		D3D11_BUFFER_DESC bufDesc = {};
+		bufDesc.ByteWidth		= sizeof(InstanceData) * size;
+		bufDesc.Usage			= D3D11_USAGE_DYNAMIC;
+		bufDesc.BindFlags		= D3D11_BIND_VERTEX_BUFFER;
+		bufDesc.CPUAccessFlags	= D3D11_CPU_ACCESS_WRITE;
+		if (FAILED(GetDevice()->CreateBuffer(&bufDesc, nullptr, &m_pInstanceBuffer))) { return; }
+		m_instanceMax = size;
+	}
+
+	// CX^Xf[^̓]
+	RenderContext* pContext = GetContext();
+	D3D11_MAPPED_SUBRESOURCE mapResource;
+	if (FAILED(pContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource))) { return; }
+	memcpy(mapResource.pData, pInstances, sizeof(InstanceData) * num);
+	pContext->Unmap(m_pInstanceBuffer, 0);
+
+	// VF[_[ݒ
+	m_pVS->Bind();
+	m_pPS->Bind();
+
+	// `
+	for (UINT i = 0; i < m_meshes.size(); ++i)
+	{
+		if (func)
+		{
+			func(i);
+		}
+		else
+		{
+			BindMaterial(m_materials[m_meshes[i].materialID]);
+		}
+		m_meshes[i].pMesh->DrawInstanced(m_pInstanceBuffer, sizeof(InstanceData), num);
+	}
+}
+
+/*
+* @brief `L[ւ̒ǉ
+*  bVƂɕ`vǉARenderQueue::Flushł܂Ƃ߂ĕёւĕ`悷
+* @param[in] world [hs(ShaderList::SetWorldƓ]uς
+* @param[in] depth J̋(ёւɎgp
+* @param[in] layer `惌C[
+* @param[in] transparent Ƃĉ`悷邩
+* @param[in] func `撼Ȍ(paramɂ̓bVԍn
+*  w肵Ȃꍇ̓}eÃeNX`ݒ
+* @param[in] pArg funcɓnCӂ̃f[^
+*/
+void Model::Submit(const DirectX::XMFLOAT4X4& world, float depth, UINT layer, bool transparent, RenderQueue::DrawCallback func, void* pArg)
+{
+	RequestDrawTextures();
+	bool useMaterial = m_pPS->HasBuffer(0, MATERIAL_BUFFER_NAME);
+	for (UINT i = 0; i < m_meshes.size(); ++i)
+	{
+		const Mesh& mesh = m_meshes[i];
+		const Material& material = m_materials[mesh.materialID];
+		RenderQueue::Item item;
+		item.pVS		= m_pVS;
+		item.pPS		= m_pPS;
+		item.pMesh		= mesh.pMesh;
+		item.pTexture	= material.pTexture;
+		item.pMaterial	= useMaterial ? material.pBuffer : nullptr;
+		item.callback	= func;
+		item.pArg		= pArg;
+		item.param		= i;
+		item.world		= world;
+		// 萔obt@ȂΕ`撼Oɏ
+		if (!func && useMaterial && !material.pBuffer)
+		{
+			item.callback	= BindMaterialCallback;
+			item.pArg		= this;
+		}
+
+		// }eA̓fƂɈقȂ̂ƂĈ
+		RenderQueue::Submit(item, &material, depth, layer, transparent);
+	}
+}
+
+/*
+* @brief }eA̐ݒ
+*  萔obt@Material(b0)錾sNZVF[_[(ShaderListȂ)ɂ̂ݐݒ肵A
+*  ȊÕVF[_[b0͗pŏ񂾓ê܂܂ɂ
+* @param[in] material ݒ肷}eA
+*/
+void Model::BindMaterial(const Material& material)
+{
+	if (m_pPS->HasBuffer(0, MATERIAL_BUFFER_NAME))
+	{
+		if (material.pBuffer)
+		{
+			m_pPS->SetBuffer(0, material.pBuffer);
+		}
+		else
+		{
+			// 萔obt@쐬łȂꍇ͓e
+			DirectX::XMFLOAT4 param[3];
+			MakeMaterialParam(material, param);
+			m_pPS->WriteBuffer(0, param);
+		}
+	}
+	m_pPS->SetTexture(0, material.pTexture);
+}
+void Model::BindMaterialCallback(void* pArg, UINT meshNo)
+{
+	Model* pModel = static_cast<Model*>(pArg);
+	pModel->BindMaterial(pModel->m_materials[pModel->m_meshes[meshNo].materialID]);
+}
+
+/*
+* @brief eNX`̕Kvȑ傫ʒm
+* @param[in] screenSize ʏ̂悻̑傫(sNZ
+*/
+void Model::RequestTextures(float screenSize)
+{
+	m_requestFrame = TextureStream::GetFrame();
+	for (UINT i = 0; i < m_materials.size(); ++i)
+	{
+		if (m_materials[i].pTexture)
+			TextureStream::Request(m_materials[i].pTexture, screenSize);
+	}
+}
+
+/*
+* @brief `掞̃eNX`̒ʒm
+*  t[RequestTexturesĂ΂ĂȂ΁Ȃ傫KvȂ̂ƂĒʒm
+*  (`悳ꂽt[L^A`悳ĂȂeNX`ǂo
+*/
+void Model::RequestDrawTextures()
+{
+	if (m_requestFrame != TextureStream::GetFrame())
+		RequestTextures(FLT_MAX);
+}
+
 /*
 * @brief bV擾
 * @param[in] index bVԍ
@@ -291,6 +509,23 @@ uint32_t Model::GetMeshNum()
 	return static_cast<uint32_t>(m_meshes.size());
 }
 
+/*
+* @brief fŜ̋E{bNX擾
+*  (ǂݍݎ̃XP[A]KpfԂł̒l
+*/
+const DirectX::BoundingBox& Model::GetBounds()
+{
+	return m_bounds;
+}
+
+/*
+* @brief fŜ̋E擾
+*/
+const DirectX::BoundingSphere& Model::GetBoundingSphere()
+{
+	return m_boundingSphere;
+}
+
 /*
 * @brief }eA擾
 * @param[in] index }eAԍ
@@ -342,10 +577,36 @@ const Model::Animation* Model::GetAnimation(AnimeNo no)
 }
 
 
+/*
+* @brief Aj[V擾
+*/
+uint32_t Model::GetAnimationNum()
+{
+	return static_cast<uint32_t>(m_animes.size());
+}
+
+/*
+* @brief OAj[Vԍ
+* @param[in] name Aj[V(͊gqt@C
+* @return YAj[Vԍ(ȂANIME_NONE
+*/
+Model::AnimeNo Model::FindAnimation(const char* name)
+{
+	AnimeNames::iterator it = m_animeNames.find(name);
+	if (it != m_animeNames.end())
+	{
+		return it->second;
+	}
+	return ANIME_NONE;
+}
+
+
 /*
 * @brief Aj[Vǂݍ
+*  t@ĈׂẴAj[Vo^AOŌł悤ɂ
+*  (Aj[V̂قAt@C(gqȂ)Ő擪̃Aj[Vł
 * @param[in] file ǂݍރAj[Vt@Cւ̃pX
-* @return Ŋ蓖ĂꂽAj[Vԍ
+* @return Ŋ蓖ĂꂽAj[Vԍ(ꍇ͐擪̔ԍ
 */
 Model::AnimeNo Model::AddAnimation(const char* file)
 {
@@ -354,10 +615,19 @@ Model::AnimeNo Model::AddAnimation(const char* file)
 #endif
 
 	// assimp̐ݒ
+	// Aj[V̂ݎgp̂ŁAbV}eAȂǂ͓ǂݍ܂ȂAǂݍݒɔj
 	Assimp::Importer importer;
+	importer.SetIOHandler(new AssetIOSystem());	// ImporterŔj
+	importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_MATERIALS, false);
+	importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_TEXTURES, false);
+	importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_CAMERAS, false);
+	importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_LIGHTS, false);
+	importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_WEIGHTS, false);
+	importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS,
+		aiComponent_MESHES | aiComponent_MATERIALS | aiComponent_TEXTURES |
+		aiComponent_LIGHTS | aiComponent_CAMERAS);
 	int flag = 0;
-	flag |= aiProcess_Triangulate;
-	flag |= aiProcess_FlipUVs;
+	flag |= aiProcess_RemoveComponent;
 	if (m_loadFlip == Flip::XFlip)  flag |= aiProcess_MakeLeftHanded;
 
 	// assimpœǂݍ
@@ -379,10 +649,41 @@ Model::AnimeNo Model::AddAnimation(const char* file)
 		return ANIME_NONE;
 	}
 
-	// Aj[Vf[^m
-	aiAnimation* assimpAnime = pScene->mAnimations[0];
-	m_animes.push_back(Animation());
-	Animation& anime = m_animes.back();
+	// t@C(gqȂ)̎擾
+	std::string fileName = file;
+	size_t find = fileName.find_last_of("/\\");
+	if (find != std::string::npos)
+		fileName = fileName.substr(find + 1);
+	fileName = fileName.substr(0, fileName.find_last_of('.'));
+
+	// t@C̃Aj[Vׂēo^
+	AnimeNo first = static_cast<AnimeNo>(m_animes.size());
+	m_animes.reserve(m_animes.size() + pScene->mNumAnimations);
+	for (UINT i = 0; i < pScene->mNumAnimations; ++i)
+	{
+		AnimeNo no = static_cast<AnimeNo>(m_animes.size());
+		m_animes.push_back(Animation());
+		MakeAnimation(pScene->mAnimations[i], &m_animes.back());
+
+		// O̓o^(̃Aj[Vΐɓo^D
+		if (pScene->mAnimations[i]->mName.length > 0)
+			m_animeNames.insert(AnimeNames::value_type(pScene->mAnimations[i]->mName.data, no));
+	}
+	m_animeNames.insert(AnimeNames::value_type(fileName, first));
+
+	// AjԍԂ
+	return first;
+}
+
+/*
+* @brief Aj[V̕ϊ쐬
+* @param[in] ptr assimp̃Aj[V
+* @param[out] pAnime i[
+*/
+void Model::MakeAnimation(const void* ptr, Animation* pAnime)
+{
+	const aiAnimation* assimpAnime = reinterpret_cast<const aiAnimation*>(ptr);
+	Animation& anime = *pAnime;
 
 	// Aj[Vݒ
 	float animeFrame = static_cast<float>(assimpAnime->mTicksPerSecond);
@@ -394,19 +695,14 @@ Model::AnimeNo Model::AddAnimation(const char* file)
 		// Ή`l({[)T
 		uint32_t channelIdx = static_cast<uint32_t>(channelIt - anime.channels.begin());
 		aiNodeAnim* assimpChannel = assimpAnime->mChannels[channelIdx];
-		Model::Nodes::iterator nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-			[assimpChannel](Node& node) {
-				return node.name == assimpChannel->mNodeName.data;
-			});
-		if (nodeIt == m_nodes.end())
+		channelIt->index = FindNode(assimpChannel->mNodeName.data);
+		if (channelIt->index == INDEX_NONE)
 		{
-			channelIt->index = INDEX_NONE;
 			++ channelIt;
 			continue;
 		}
 
 		// eL[̒lݒ
-		channelIt->index = static_cast<NodeIndex>(nodeIt - m_nodes.begin());
 		Timeline& timeline = channelIt->timeline;
 
 		// xXMVECTOR^Ŋi[
@@ -500,9 +796,6 @@ Model::AnimeNo Model::AddAnimation(const char* file)
 
 		++ channelIt;
 	}
-
-	// AjԍԂ
-	return static_cast<AnimeNo>(m_animes.size() - 1);
 }
 
 /*
@@ -759,11 +1052,9 @@ void Model::DrawBone()
 		Geometory::AddLine(parent, pos, DirectX::XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f));
 
 		// qm[h̕`
-		auto it = m_nodes[idx].children.begin();
-		while (it != m_nodes[idx].children.end())
+		for (UINT i = 0; i < m_nodes[idx].childNum; ++i)
 		{
-			FuncDrawBone(*it, pos);
-			++it;
+			FuncDrawBone(m_children[m_nodes[idx].childStart + i], pos);
 		}
 	};
 
@@ -772,48 +1063,84 @@ void Model::DrawBone()
 	Geometory::DrawLines();
 }
 
+/*
+* @brief O̓ǂݍ݂ňꎞ̈悪q[vmۂ
+*/
+size_t Model::GetLoadAllocNum()
+{
+	return m_loadAllocNum;
+}
+
 #endif
 
 
 void Model::MakeBoneNodes(const void* ptr)
 {
-	// ċAAssimp̃m[hǂݎ
-	std::function<NodeIndex(aiNode*, NodeIndex, DirectX::XMMATRIX mat)> FuncAssimpNodeConvert =
-		[&FuncAssimpNodeConvert, this](aiNode* assimpNode, NodeIndex parent, DirectX::XMMATRIX mat)
+	const aiScene* pScene = reinterpret_cast<const aiScene*>(ptr);
+
+	// m[hɐāAz̊mۂxōς܂
+	UINT assimpNodeNum = CountAssimpNode(pScene->mRootNode);
+	m_nodes.clear();
+	m_nodes.reserve(assimpNodeNum);
+	m_children.clear();
+	m_children.reserve(assimpNodeNum);
+
+	// ̃m[hςރX^bN([DŁAqvf̏ԒʂɎo
+	struct Stack
+	{
+		aiNode*		assimpNode;	// ϊm[h
+		NodeIndex	parent;		// em[h
+		UINT		slot;		// em[h̉Ԗڂ̎q
+	};
+	Stack* pStack = m_pLoadArena->Alloc<Stack>(assimpNodeNum);
+	UINT stackNum = 0;
+	pStack[stackNum++] = { pScene->mRootNode, INDEX_NONE, 0 };
+
+	// Assimp̃m[hǂݎ
+	while (stackNum > 0)
 	{
-		DirectX::XMMATRIX transform = GetMatrixFromAssimpMatrix(assimpNode->mTransformation);
-		std::string name = assimpNode->mName.data;
-		if (name.find("$AssimpFbx") != std::string::npos)
+		Stack cur = pStack[--stackNum];
+
+		// Assimp}ԃm[h́Aϊs񂾂pœǂݔ΂
+		DirectX::XMMATRIX mat = DirectX::XMMatrixIdentity();
+		while (strstr(cur.assimpNode->mName.data, "$AssimpFbx") && cur.assimpNode->mNumChildren > 0)
 		{
-			mat = transform * mat;
-			return FuncAssimpNodeConvert(assimpNode->mChildren[0], parent, mat);
+			mat = GetMatrixFromAssimpMatrix(cur.assimpNode->mTransformation) * mat;
+			cur.assimpNode = cur.assimpNode->mChildren[0];
 		}
-		else
+
+		// Assimp̃m[hfNX֊i[
+		NodeIndex nodeIndex = static_cast<NodeIndex>(m_nodes.size());
+		m_nodes.emplace_back();
+		Node& node = m_nodes.back();
+		node.name = cur.assimpNode->mName.data;
+		node.parent = cur.parent;
+		node.childStart = static_cast<UINT>(m_children.size());
+		node.childNum = cur.assimpNode->mNumChildren;
+		node.mat = mat;
+		m_children.resize(m_children.size() + node.childNum);
+		if (cur.parent != INDEX_NONE)
 		{
-			// Assimp̃m[hfNX֊i[
-			Node node;
-			node.name = assimpNode->mName.data;
-			node.parent = parent;
-			node.children.resize(assimpNode->mNumChildren);
-			node.mat = mat;
-
-			// m[hXgɒǉ
-			m_nodes.push_back(node);
-			NodeIndex nodeIndex = static_cast<NodeIndex>(m_nodes.size() - 1);
-
-			// qvflɕϊ
-			for (UINT i = 0; i < assimpNode->mNumChildren; ++i)
-			{
-				m_nodes[nodeIndex].children[i] = FuncAssimpNodeConvert(
-					assimpNode->mChildren[i], nodeIndex, DirectX::XMMatrixIdentity());
-			}
-			return nodeIndex;
+			m_children[m_nodes[cur.parent].childStart + cur.slot] = nodeIndex;
 		}
-	};
 
-	// m[h쐬
-	m_nodes.clear();
-	FuncAssimpNodeConvert(reinterpret_cast<const aiScene*>(ptr)->mRootNode, INDEX_NONE, DirectX::XMMatrixIdentity());
+		// qvflɕϊ(擪̎qo悤tɐς
+		for (UINT i = cur.assimpNode->mNumChildren; i > 0; --i)
+		{
+			pStack[stackNum++] = { cur.assimpNode->mChildren[i - 1], nodeIndex, i - 1 };
+		}
+	}
+
+	// {[̌쐬
+	m_nodeNames.resize(m_nodes.size());
+	for (UINT i = 0; i < m_nodes.size(); ++i)
+	{
+		m_nodeNames[i].hash = GetNameHash(m_nodes[i].name.c_str());
+		m_nodeNames[i].index = static_cast<NodeIndex>(i);
+	}
+	std::sort(m_nodeNames.begin(), m_nodeNames.end(), [](const NodeName& a, const NodeName& b) {
+		return a.hash != b.hash ? a.hash < b.hash : a.index < b.index;
+	});
 
 	// Aj[VvZ̈ɁAm[h̏f[^쐬
 	Transform init = {
@@ -836,16 +1163,6 @@ void Model::MakeWeight(const void* ptr, int meshIdx)
 	Mesh& mesh = m_meshes[meshIdx];
 	if (assimpMesh->HasBones())
 	{
-		// bV̒_̈쐬
-		struct WeightPair
-		{
-			unsigned int idx;
-			float weight;
-		};
-		std::vector<std::vector<WeightPair>> weights;
-		weights.resize(mesh.vertices.size());
-
-
 		// bVɊ蓖ĂĂ{[̈m
 		mesh.bones.resize(assimpMesh->mNumBones);
 		for (auto boneIt = mesh.bones.begin(); boneIt != mesh.bones.end(); ++boneIt)
@@ -853,20 +1170,14 @@ void Model::MakeWeight(const void* ptr, int meshIdx)
 			UINT boneIdx = static_cast<UINT>(boneIt - mesh.bones.begin());
 			aiBone* assimpBone = assimpMesh->mBones[boneIdx];
 			// \zς݂̃{[m[hYm[h擾
-			std::string boneName = assimpBone->mName.data;
-			auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-				[boneName](const Node& val) {
-				return val.name == boneName;
-			});
+			boneIt->index = FindNode(assimpBone->mName.data);
 			// bVɊ蓖ĂĂ{[Am[hɑ݂Ȃ
-			if (nodeIt == m_nodes.end())
+			if (boneIt->index == INDEX_NONE)
 			{
-				boneIt->index = INDEX_NONE;
 				continue;
 			}
 
 			// bṼ{[ƃm[h̕RÂ
-			boneIt->index = static_cast<NodeIndex>(nodeIt - m_nodes.begin());
 			boneIt->invOffset = GetMatrixFromAssimpMatrix(assimpBone->mOffsetMatrix);
 			boneIt->invOffset.r[3].m128_f32[0] *= m_loadScale;
 			boneIt->invOffset.r[3].m128_f32[1] *= m_loadScale;
@@ -875,68 +1186,51 @@ void Model::MakeWeight(const void* ptr, int meshIdx)
 				DirectX::XMMatrixScaling(m_loadFlip == ZFlipUseAnime ? -1.0f : 1.0f, 1.0f, 1.0f) *
 				boneIt->invOffset * 
 				DirectX::XMMatrixScaling(1.f / m_loadScale, 1.f / m_loadScale, 1.f / m_loadScale);
+		}
 
-			// EFCg̐ݒ
-			UINT weightNum = assimpBone->mNumWeights;
-			for (UINT i = 0; i < weightNum; ++i)
-			{
-				aiVertexWeight weight = assimpBone->mWeights[i];
-				weights[weight.mVertexId].push_back({boneIdx, weight.mWeight});
-			}
+		// _Ƃ̃EFCg쐬(m[hɑ݂Ȃ{[͖
+		bool* pBoneValid = m_pLoadArena->Alloc<bool>(assimpMesh->mNumBones);
+		for (UINT i = 0; i < assimpMesh->mNumBones; ++i)
+		{
+			pBoneValid[i] = mesh.bones[i].index != INDEX_NONE;
 		}
+		const SkinWeight::Weight* pWeights = SkinWeight::Make(m_pLoadArena, assimpMesh, pBoneValid);
 
 		// 擾Ă_EFCgݒ
-		for (int i = 0; i < weights.size(); ++i)
+		for (UINT i = 0; i < mesh.vertices.size(); ++i)
 		{
-			if (weights[i].size() >= 4)
-			{
-				std::sort(weights[i].begin(), weights[i].end(), [](WeightPair& a, WeightPair& b) {
-					return a.weight > b.weight;
-				});
-				// EFCg4ɍ킹ĐK
-				float total = 0.0f;
-				for (int j = 0; j < 4; ++j)
-					total += weights[i][j].weight;
-				for (int j = 0; j < 4; ++j)
-					weights[i][j].weight /= total;
-			}
-			for (int j = 0; j < weights[i].size() && j < 4; ++j)
-			{
-				mesh.vertices[i].index[j] = weights[i][j].idx;
-				mesh.vertices[i].weight[j] = weights[i][j].weight;
-			}
+			memcpy(mesh.vertices[i].weight, pWeights[i].weight, sizeof(pWeights[i].weight));
+			memcpy(mesh.vertices[i].index, pWeights[i].index, sizeof(pWeights[i].index));
 		}
 	}
 	else
 	{
 		// bV̐em[hgXtH[ƂČvZ
-		std::string nodeName = assimpMesh->mName.data;
-		auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-			[nodeName](const Node& val) {
-				return val.name == nodeName;
-			});
-		if (nodeIt == m_nodes.end())
+		NodeIndex nodeIndex = FindNode(assimpMesh->mName.data);
+		if (nodeIndex == INDEX_NONE)
 		{
 			return;	// {[f[^Ȃ
 		}
 
-		// bVłȂem[hċAT
-		std::function<int(int)> FuncFindNode =
-			[&FuncFindNode, this, pScene](NodeIndex parent)
+		// bVłȂem[hT
+		NodeIndex parent = m_nodes[nodeIndex].parent;
+		while (parent != INDEX_NONE)
 		{
-			std::string name = m_nodes[parent].name;
-			for (UINT i = 0; i < pScene->mNumMeshes; ++i)
+			UINT i = 0;
+			while (i < pScene->mNumMeshes && m_nodes[parent].name != pScene->mMeshes[i]->mName.data)
 			{
-				if (name == pScene->mMeshes[i]->mName.data)
-				{
-					return FuncFindNode(m_nodes[parent].parent);
-				}
+				++i;
 			}
-			return parent;
-		};
+			if (i == pScene->mNumMeshes) { break; }
+			parent = m_nodes[parent].parent;
+		}
+		if (parent == INDEX_NONE)
+		{
+			return;	// {[f[^Ȃ
+		}
 
 		Bone bone;
-		bone.index = FuncFindNode(nodeIt->parent);
+		bone.index = parent;
 		bone.invOffset = DirectX::XMMatrixInverse(nullptr, m_nodes[bone.index].mat);
 		for (auto vtxIt = mesh.vertices.begin(); vtxIt != mesh.vertices.end(); ++vtxIt)
 		{
@@ -948,6 +1242,28 @@ void Model::MakeWeight(const void* ptr, int meshIdx)
 	}
 }
 
+/*
+* @brief O{[ԍ
+* @param[in] name {[
+* @return Y{[ԍ(ȂINDEX_NONE
+*/
+Model::NodeIndex Model::FindNode(const char* name)
+{
+	size_t hash = GetNameHash(name);
+	auto it = std::lower_bound(m_nodeNames.begin(), m_nodeNames.end(), hash,
+		[](const NodeName& val, size_t hash) {
+			return val.hash < hash;
+		});
+	while (it != m_nodeNames.end() && it->hash == hash)
+	{
+		if (m_nodes[it->index].name == name)
+		{
+			return it->index;
+		}
+		++it;
+	}
+	return INDEX_NONE;
+}
 
 
 bool Model::AnimeNoCheck(AnimeNo no)
@@ -1074,11 +1390,9 @@ void Model::CalcBones(NodeIndex index, const DirectX::XMMATRIX parent)
 	node.mat = (S * R * T) * parent;
 
 	// qvf̎pXV
-	Children::iterator it = node.children.begin();
-	while (it != node.children.end())
+	for (UINT i = 0; i < node.childNum; ++i)
 	{
-		CalcBones(*it, node.mat);
-		++it;
+		CalcBones(m_children[node.childStart + i], node.mat);
 	}
 }
 
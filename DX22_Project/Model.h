@@ -6,9 +6,14 @@
 #define __MODEL_H__
 
 #include <DirectXMath.h>
+#include <DirectXCollision.h>
 #include <vector>
+#include <map>
+#include <string>
 #include "Shader.h"
 #include "MeshBuffer.h"
+#include "Arena.h"
+#include "RenderQueue.h"
 #include <functional>
 
 class Model
@@ -75,11 +80,20 @@ private:
 	{
 		std::string			name;		// {[
 		NodeIndex			parent;		// e{[
-		Children			children;	// q{[
+		UINT				childStart;	// q{[(m_children̊Jnʒu
+		UINT				childNum;	// q{[̐
 		DirectX::XMMATRIX	mat;		// ϊs
 	};
 	using Nodes = std::vector<Node>;
 
+	// {[̌
+	struct NodeName
+	{
+		size_t		hash;	// {[̃nbVl
+		NodeIndex	index;	// {[ԍ
+	};
+	using NodeNames = std::vector<NodeName>;
+
 	
 public:
 	// _
@@ -104,16 +118,28 @@ public:
 	using Bones = std::vector<Bone>;
 
 	// bV
+	// _ƃCfbNX͓ǂݍ݌MeshBufferֈړ邽߁A
+	// ǂݍ݌̎QƂpMesh->GetDesc()s
 	struct Mesh
 	{
-		Vertices		vertices;
-		Indices			indices;
-		unsigned int	materialID;
-		Bones			bones;
-		MeshBuffer*		pMesh;
+		Vertices				vertices;
+		Indices					indices;
+		unsigned int			materialID;
+		Bones					bones;
+		MeshBuffer*				pMesh;
+		DirectX::BoundingBox	bounds;		// E{bNX(oCh|[Y
+		DirectX::BoundingSphere	sphere;		// E(oCh|[Y
 	};
 	using Meshes = std::vector<Mesh>;
 
+	// CX^X`̌ʃf[^
+	// (_VF[_[INSTANCE0`4ɑΉAworld͓]uɐݒ肷
+	struct InstanceData
+	{
+		DirectX::XMFLOAT4X4	world;	// [hs
+		DirectX::XMFLOAT4	tint;	// _J[ւ̏ZF
+	};
+
 	// }eA
 	struct Material
 	{
@@ -121,6 +147,7 @@ public:
 		DirectX::XMFLOAT4	ambient;	// (Ã̕J[
 		DirectX::XMFLOAT4	specular;	// ʔˌ(镔̃J[
 		Texture* pTexture;	// eNX`
+		ID3D11Buffer* pBuffer;	// L܂Ƃ߂萔obt@(ǂݍݎɍ쐬AύXsA쐬łȂnullptr
 	};
 	using Materials = std::vector<Material>;
 
@@ -134,6 +161,7 @@ public:
 		Channels	channels;	// ϊ
 	};
 	using Animations = std::vector<Animation>;
+	using AnimeNames = std::map<std::string, AnimeNo>;	// Aj[VƔԍ̑Ή
 
 public:
 	Model();
@@ -141,8 +169,16 @@ public:
 	void Reset();
 	void SetVertexShader(VertexShader* vs);
 	void SetPixelShader(PixelShader* ps);
-	bool Load(const char* file, float scale = 1.0f, Flip flip = Flip::None);
+	bool Load(const char* file, float scale = 1.0f, Flip flip = Flip::None, bool gpuOnly = false);
 	void Draw(const std::vector<UINT>* order = nullptr, std::function<void(int)> func = nullptr);
+	// CX^X`(_VF[_[̓CX^XΉ̂̂ݒ肵Ă
+	void DrawInstanced(const InstanceData* pInstances, UINT num, std::function<void(int)> func = nullptr);
+	// `L[֒ǉ(`RenderQueue::Flushōs
+	void Submit(const DirectX::XMFLOAT4X4& world, float depth, UINT layer = 0, bool transparent = false,
+		RenderQueue::DrawCallback func = nullptr, void* pArg = nullptr);
+	// eNX`̒iKIȓǂݍ݂։ʏ̑傫ʒm(TextureStream::CalcScreenSizeȂ
+	// DrawADrawInstancedASubmitOɌĂ(t[ŌĂ΂ĂȂΕ`掞Ɍ̑傫Œʒm
+	void RequestTextures(float screenSize);
 
 	//--- e擾
 	const Mesh* GetMesh(unsigned int index);
@@ -151,6 +187,10 @@ public:
 	uint32_t GetMaterialNum();
 	DirectX::XMMATRIX GetBone(NodeIndex index);
 	const Animation* GetAnimation(AnimeNo no);
+	uint32_t GetAnimationNum();
+	AnimeNo FindAnimation(const char* name);
+	const DirectX::BoundingBox& GetBounds();
+	const DirectX::BoundingSphere& GetBoundingSphere();
 
 	//--- Aj[V
 	// Aj[V̓ǂݍ
@@ -179,6 +219,7 @@ public:
 #ifdef _DEBUG
 	static std::string GetError();
 	void DrawBone();
+	size_t GetLoadAllocNum();
 #endif
 
 
@@ -186,8 +227,18 @@ private:
 	// e퐶
 	void MakeMesh(const void* ptr, float scale, Flip flip);
 	void MakeMaterial(const void* ptr, std::string directory);
+	HRESULT MakeMaterialBuffer(Material* pMaterial);
+	static void MakeMaterialParam(const Material& material, DirectX::XMFLOAT4* pParam);
 	void MakeBoneNodes(const void* ptr);
 	void MakeWeight(const void* ptr, int meshIdx);
+	void MakeBounds(Mesh* pMesh);
+	NodeIndex FindNode(const char* name);
+	void MakeAnimation(const void* ptr, Animation* pAnime);
+
+	// }eA̐ݒ
+	void BindMaterial(const Material& material);
+	void RequestDrawTextures();
+	static void BindMaterialCallback(void* pArg, UINT meshNo);
 
 	// vZ
 	bool AnimeNoCheck(AnimeNo no);
@@ -201,6 +252,8 @@ private:
 	static VertexShader*	m_pDefVS;		// ftHg_VF[_[
 	static PixelShader*		m_pDefPS;		// ftHgsNZVF[_[
 	static unsigned int		m_shaderRef;	// VF[_[QƐ
+	static ID3D11Buffer*	m_pInstanceBuffer;	// CX^Xf[^̓](SfŋL
+	static UINT				m_instanceMax;		// ]Ɋi[łCX^X
 #ifdef _DEBUG
 	static std::string m_errorStr;	
 #endif
@@ -208,11 +261,22 @@ private:
 private:
 	float			m_loadScale;	// 
 	Flip			m_loadFlip;		// 
+	bool			m_loadGPUOnly;	// _f[^CPUɎcȂ
+	Arena*			m_pLoadArena;	// ǂݍݒ̂ݎgpꎞ̈
+	UINT			m_requestFrame;	// eNX`̑傫ʒmt[(TextureStream::GetFrame
+#ifdef _DEBUG
+	size_t			m_loadAllocNum;	// ꎞ̈̃q[vmۉ
+#endif
 
 	Meshes			m_meshes;		// bVz
 	Materials		m_materials;	// }eAz
+	DirectX::BoundingBox	m_bounds;			// fŜ̋E{bNX
+	DirectX::BoundingSphere	m_boundingSphere;	// fŜ̋E
 	Nodes			m_nodes;		// Kw
+	Children		m_children;		// Sm[h̎q{[ԍ
+	NodeNames		m_nodeNames;	// {[̌p(nbVl
 	Animations		m_animes;		// Ajz
+	AnimeNames		m_animeNames;	// Aj[V̌p
 	VertexShader*	m_pVS;			// ݒ蒆̒_VF[_
 	PixelShader*	m_pPS;			// ݒ蒆̃sNZVF[_
 	
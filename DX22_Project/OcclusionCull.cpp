@@ -0,0 +1,311 @@
+#include "OcclusionCull.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <float.h>
+#include <string.h>
+
+// O(w)̒_܂ގOp`AAABB͔肵Ȃ
+static const float NEAR_W = 1.0e-3f;
+
+OcclusionCull::OcclusionCull()
+	: m_width(0), m_height(0)
+	, m_bufWidth(0), m_bufHeight(0)
+	, m_tileX(0), m_tileY(0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	DirectX::XMStoreFloat4x4(&m_viewProj, DirectX::XMMatrixIdentity());
+}
+OcclusionCull::~OcclusionCull()
+{
+}
+
+void OcclusionCull::Init(uint32_t width, uint32_t height)
+{
+	m_width = width;
+	m_height = height;
+	m_tileX = (width + TILE_W - 1) / TILE_W;
+	m_tileY = (height + TILE_H - 1) / TILE_H;
+	m_bufWidth = m_tileX * TILE_W;
+	m_bufHeight = m_tileY * TILE_H;
+	m_depth.assign(m_bufWidth * m_bufHeight, 1.0f);
+	m_hiz.assign((m_bufWidth / HIZ_SIZE) * (m_bufHeight / HIZ_SIZE), 1.0f);
+	m_tileTriangles.resize(m_tileX * m_tileY);
+}
+
+void OcclusionCull::Begin(const DirectX::XMFLOAT4X4& viewProj)
+{
+	m_viewProj = viewProj;
+	m_triangles.clear();
+	for (size_t i = 0; i < m_tileTriangles.size(); ++i)
+		m_tileTriangles[i].clear();
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+void OcclusionCull::AddOccluder(const DirectX::XMFLOAT3* pVertices, uint32_t vtxNum,
+	const uint32_t* pIndices, uint32_t idxNum, const DirectX::XMFLOAT4X4& world)
+{
+	// InitO͕`ݐ悪Ȃ߉Ȃ(ʂ͈̔͂0Ɣ͈͂̌vZɂȂ
+	if (m_width == 0 || m_height == 0) { return; }
+
+	DirectX::XMMATRIX mat = DirectX::XMMatrixMultiply(
+		DirectX::XMLoadFloat4x4(&world), DirectX::XMLoadFloat4x4(&m_viewProj));
+
+	// _ʍW֕ϊ(ŵ͎Op`Ɣ肩O
+	std::vector<DirectX::XMFLOAT4> screen(vtxNum);
+	for (uint32_t i = 0; i < vtxNum; ++i)
+	{
+		DirectX::XMVECTOR pos = DirectX::XMVector4Transform(
+			DirectX::XMVectorSet(pVertices[i].x, pVertices[i].y, pVertices[i].z, 1.0f), mat);
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, pos);
+		if (clip.w < NEAR_W)
+		{
+			screen[i].w = -1.0f;
+			continue;
+		}
+		float invW = 1.0f / clip.w;
+		screen[i].x = (clip.x * invW * 0.5f + 0.5f) * m_width;
+		screen[i].y = (0.5f - clip.y * invW * 0.5f) * m_height;
+		screen[i].z = clip.z * invW;
+		screen[i].w = clip.z < 0.0f ? -1.0f : 1.0f;
+	}
+
+	for (uint32_t i = 0; i + 2 < idxNum; i += 3)
+	{
+		const DirectX::XMFLOAT4* v[3] = { &screen[pIndices[i]], &screen[pIndices[i + 1]], &screen[pIndices[i + 2]] };
+		if (v[0]->w < 0.0f || v[1]->w < 0.0f || v[2]->w < 0.0f) { continue; }
+
+		// \Ɋւ炸`ނ߁AʐςɂȂ鏇ɑ
+		float area = (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[2]->x - v[0]->x) * (v[1]->y - v[0]->y);
+		if (area < 0.0f)
+			std::swap(v[1], v[2]);
+		else if (area == 0.0f)
+			continue;
+
+		// ʓ͈̔
+		float minX = std::min(std::min(v[0]->x, v[1]->x), v[2]->x);
+		float maxX = std::max(std::max(v[0]->x, v[1]->x), v[2]->x);
+		float minY = std::min(std::min(v[0]->y, v[1]->y), v[2]->y);
+		float maxY = std::max(std::max(v[0]->y, v[1]->y), v[2]->y);
+		if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height) { continue; }
+		uint32_t x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+		uint32_t y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+		uint32_t x1 = static_cast<uint32_t>(std::min(maxX, m_width - 1.0f));
+		uint32_t y1 = static_cast<uint32_t>(std::min(maxY, m_height - 1.0f));
+
+		// dȂ^C֓o^
+		uint32_t index = static_cast<uint32_t>(m_triangles.size());
+		Triangle tri;
+		for (int j = 0; j < 3; ++j)
+		{
+			tri.x[j] = v[j]->x;
+			tri.y[j] = v[j]->y;
+			tri.z[j] = v[j]->z;
+		}
+		m_triangles.push_back(tri);
+		for (uint32_t ty = y0 / TILE_H; ty <= y1 / TILE_H; ++ty)
+		{
+			for (uint32_t tx = x0 / TILE_W; tx <= x1 / TILE_W; ++tx)
+				m_tileTriangles[ty * m_tileX + tx].push_back(index);
+		}
+	}
+	m_stats.triangleNum = static_cast<uint32_t>(m_triangles.size());
+}
+
+void OcclusionCull::Render()
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	// 󂢂Ă^C珇ɊeXbhŏ
+	uint32_t tileNum = m_tileX * m_tileY;
+	std::atomic<uint32_t> next(0);
+	auto worker = [&]() {
+		uint32_t tile;
+		while ((tile = next++) < tileNum)
+			RenderTile(tile);
+	};
+	uint32_t threadNum = std::min(std::max(std::thread::hardware_concurrency(), 1u), tileNum);
+	std::vector<std::future<void>> tasks;
+	for (uint32_t i = 1; i < threadNum; ++i)
+		tasks.push_back(std::async(std::launch::async, worker));
+	worker();
+	for (size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].get();
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	m_stats.renderTime = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+// ^CɎOp``݁A^CHiZ쐬
+void OcclusionCull::RenderTile(uint32_t tile)
+{
+	uint32_t tileX0 = (tile % m_tileX) * TILE_W;
+	uint32_t tileY0 = (tile / m_tileX) * TILE_H;
+	for (uint32_t y = 0; y < TILE_H; ++y)
+		std::fill_n(&m_depth[(tileY0 + y) * m_bufWidth + tileX0], TILE_W, 1.0f);
+
+	const DirectX::XMVECTOR offsetX = DirectX::XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const std::vector<uint32_t>& triangles = m_tileTriangles[tile];
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		const Triangle& tri = m_triangles[triangles[i]];
+
+		// ^C͈̔(4sNZP
+		float minX = std::min(std::min(tri.x[0], tri.x[1]), tri.x[2]);
+		float maxX = std::max(std::max(tri.x[0], tri.x[1]), tri.x[2]);
+		float minY = std::min(std::min(tri.y[0], tri.y[1]), tri.y[2]);
+		float maxY = std::max(std::max(tri.y[0], tri.y[1]), tri.y[2]);
+		int x0 = std::max(static_cast<int>(minX), static_cast<int>(tileX0)) & ~3;
+		int x1 = std::min(static_cast<int>(maxX), static_cast<int>(std::min(tileX0 + TILE_W, m_width) - 1));
+		int y0 = std::max(static_cast<int>(minY), static_cast<int>(tileY0));
+		int y1 = std::min(static_cast<int>(maxY), static_cast<int>(std::min(tileY0 + TILE_H, m_height) - 1));
+		if (x0 > x1 || y0 > y1) { continue; }
+
+		// ӊ֐ e = A * x + B * y + C (Ő
+		float a[3], b[3], c[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			int s = (j + 1) % 3;
+			int e = (j + 2) % 3;
+			a[j] = -(tri.y[e] - tri.y[s]);
+			b[j] = tri.x[e] - tri.x[s];
+			c[j] = -a[j] * tri.x[s] - b[j] * tri.y[s];
+		}
+		float area = a[0] * tri.x[0] + b[0] * tri.y[0] + c[0];
+		float zA = (tri.z[1] - tri.z[0]) / area;
+		float zB = (tri.z[2] - tri.z[0]) / area;
+
+		DirectX::XMVECTOR vA[3], vB[3], vC[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			vA[j] = DirectX::XMVectorReplicate(a[j]);
+			vB[j] = DirectX::XMVectorReplicate(b[j]);
+			vC[j] = DirectX::XMVectorReplicate(c[j]);
+		}
+		DirectX::XMVECTOR vZ0 = DirectX::XMVectorReplicate(tri.z[0]);
+		DirectX::XMVECTOR vZA = DirectX::XMVectorReplicate(zA);
+		DirectX::XMVECTOR vZB = DirectX::XMVectorReplicate(zB);
+		DirectX::XMVECTOR zero = DirectX::XMVectorZero();
+
+		for (int y = y0; y <= y1; ++y)
+		{
+			DirectX::XMVECTOR py = DirectX::XMVectorReplicate(y + 0.5f);
+			float* pRow = &m_depth[y * m_bufWidth];
+			for (int x = x0; x <= x1; x += 4)
+			{
+				DirectX::XMVECTOR px = DirectX::XMVectorAdd(DirectX::XMVectorReplicate(static_cast<float>(x)), offsetX);
+				DirectX::XMVECTOR e[3];
+				for (int j = 0; j < 3; ++j)
+					e[j] = DirectX::XMVectorMultiplyAdd(vA[j], px, DirectX::XMVectorMultiplyAdd(vB[j], py, vC[j]));
+
+				// OӂƂ̃sNZ֎O̐[x
+				DirectX::XMVECTOR inside = DirectX::XMVectorAndInt(
+					DirectX::XMVectorGreaterOrEqual(e[0], zero),
+					DirectX::XMVectorAndInt(
+						DirectX::XMVectorGreaterOrEqual(e[1], zero),
+						DirectX::XMVectorGreaterOrEqual(e[2], zero)));
+				DirectX::XMVECTOR depth = DirectX::XMVectorMultiplyAdd(vZA, e[1], DirectX::XMVectorMultiplyAdd(vZB, e[2], vZ0));
+				DirectX::XMVECTOR old = DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&pRow[x]));
+				DirectX::XMVECTOR result = DirectX::XMVectorSelect(old, DirectX::XMVectorMin(old, depth), inside);
+				DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&pRow[x]), result);
+			}
+		}
+	}
+
+	// HiZ(8x8sNZ̍ł̐[x
+	uint32_t hizWidth = m_bufWidth / HIZ_SIZE;
+	for (uint32_t by = 0; by < TILE_H / HIZ_SIZE; ++by)
+	{
+		for (uint32_t bx = 0; bx < TILE_W / HIZ_SIZE; ++bx)
+		{
+			uint32_t px = tileX0 + bx * HIZ_SIZE;
+			uint32_t py = tileY0 + by * HIZ_SIZE;
+			DirectX::XMVECTOR vMax = DirectX::XMVectorZero();
+			for (uint32_t y = 0; y < HIZ_SIZE; ++y)
+			{
+				const float* pRow = &m_depth[(py + y) * m_bufWidth + px];
+				for (uint32_t x = 0; x < HIZ_SIZE; x += 4)
+					vMax = DirectX::XMVectorMax(vMax, DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&pRow[x])));
+			}
+			DirectX::XMFLOAT4 m;
+			DirectX::XMStoreFloat4(&m, vMax);
+			m_hiz[(py / HIZ_SIZE) * hizWidth + px / HIZ_SIZE] = std::max(std::max(m.x, m.y), std::max(m.z, m.w));
+		}
+	}
+}
+
+bool OcclusionCull::IsVisible(const DirectX::BoundingBox& box)
+{
+	// InitO͔łȂߌĂ̂Ƃ
+	if (m_width == 0 || m_height == 0 || m_hiz.empty()) { return true; }
+
+	// 8_ʍW֕ϊāAʏ͈̔͂ƍłO̐[x߂
+	DirectX::XMMATRIX mat = DirectX::XMLoadFloat4x4(&m_viewProj);
+	DirectX::XMFLOAT3 corners[8];
+	box.GetCorners(corners);
+	float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+	for (int i = 0; i < 8; ++i)
+	{
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, DirectX::XMVector4Transform(
+			DirectX::XMVectorSet(corners[i].x, corners[i].y, corners[i].z, 1.0f), mat));
+		if (clip.w < NEAR_W) { return true; }	// J܂͔̂肵Ȃ
+		float invW = 1.0f / clip.w;
+		float x = (clip.x * invW * 0.5f + 0.5f) * m_width;
+		float y = (0.5f - clip.y * invW * 0.5f) * m_height;
+		minX = std::min(minX, x);	maxX = std::max(maxX, x);
+		minY = std::min(minY, y);	maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip.z * invW);
+	}
+	if (minZ < 0.0f) { return true; }
+	if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height) { return false; }
+
+	// ͈͓HiẐꂩOłΌĂ
+	uint32_t hizWidth = m_bufWidth / HIZ_SIZE;
+	uint32_t bx0 = static_cast<uint32_t>(std::max(minX, 0.0f)) / HIZ_SIZE;
+	uint32_t by0 = static_cast<uint32_t>(std::max(minY, 0.0f)) / HIZ_SIZE;
+	uint32_t bx1 = static_cast<uint32_t>(std::min(maxX, m_width - 1.0f)) / HIZ_SIZE;
+	uint32_t by1 = static_cast<uint32_t>(std::min(maxY, m_height - 1.0f)) / HIZ_SIZE;
+	for (uint32_t by = by0; by <= by1; ++by)
+	{
+		for (uint32_t bx = bx0; bx <= bx1; ++bx)
+		{
+			if (minZ <= m_hiz[by * hizWidth + bx])
+				return true;
+		}
+	}
+	return false;
+}
+
+uint32_t OcclusionCull::Test(const DirectX::BoundingBox* pBoxes, uint32_t num, std::vector<uint32_t>* pVisible)
+{
+	pVisible->clear();
+	for (uint32_t i = 0; i < num; ++i)
+	{
+		if (IsVisible(pBoxes[i]))
+			pVisible->push_back(i);
+	}
+	m_stats.testNum += num;
+	m_stats.occludedNum += num - static_cast<uint32_t>(pVisible->size());
+	return static_cast<uint32_t>(pVisible->size());
+}
+
+const OcclusionCull::Stats& OcclusionCull::GetStats()
+{
+	return m_stats;
+}
+const float* OcclusionCull::GetDepth()
+{
+	return m_depth.data();
+}
+uint32_t OcclusionCull::GetWidth()
+{
+	return m_bufWidth;
+}
+uint32_t OcclusionCull::GetHeight()
+{
+	return m_bufHeight;
+}
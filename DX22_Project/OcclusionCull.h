@@ -0,0 +1,78 @@
+#ifndef __OCCLUSION_CULL_H__
+#define __OCCLUSION_CULL_H__
+
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <vector>
+#include <stdint.h>
+
+// CPUɂՕJO
+// Օ(n`A傫ȊȂ)̐[x𑜓x̃obt@֕`݁A
+// 8x8sNZƂ̍ł̐[x(HiZ)ƃIuWFNgAABBrāASɉBĂ̂O
+// `݂͉ʂ^CɕA^CƂɕXbhōs
+class OcclusionCull
+{
+public:
+	// Wv
+	struct Stats
+	{
+		uint32_t	triangleNum;	// `񂾎Op`
+		uint32_t	testNum;		// 肵IuWFNg
+		uint32_t	occludedNum;	// BĂIuWFNg
+		float		renderTime;		// `݂ɂ(~b
+	};
+
+public:
+	OcclusionCull();
+	~OcclusionCull();
+
+	// [xobt@̑傫(ł̓^C̑傫֐؂グ
+	void Init(uint32_t width = 320, uint32_t height = 192);
+
+	// t[̊Jn(]uĂȂr[~vWFNVs
+	void Begin(const DirectX::XMFLOAT4X4& viewProj);
+	// Օ̒ǉ(Op`XgAworld͓]uĂȂ[hs
+	void AddOccluder(const DirectX::XMFLOAT3* pVertices, uint32_t vtxNum,
+		const uint32_t* pIndices, uint32_t idxNum, const DirectX::XMFLOAT4X4& world);
+	// Օ̕`݂HiZ̍쐬
+	void Render();
+
+	// AABBĂ邩(łȂꍇ͌Ă̂Ƃ
+	bool IsVisible(const DirectX::BoundingBox& box);
+	// Ă̂̔ԍpVisible֏o
+	uint32_t Test(const DirectX::BoundingBox* pBoxes, uint32_t num, std::vector<uint32_t>* pVisible);
+
+	const Stats& GetStats();
+	const float* GetDepth();
+	uint32_t GetWidth();
+	uint32_t GetHeight();
+
+private:
+	// ʍW֕ϊOp`
+	struct Triangle
+	{
+		float x[3], y[3], z[3];
+	};
+
+	void RenderTile(uint32_t tile);
+
+private:
+	static const uint32_t TILE_W	= 64;	// ^C̑傫
+	static const uint32_t TILE_H	= 32;
+	static const uint32_t HIZ_SIZE	= 8;	// HiZ1vf܂Ƃ߂sNZ(c
+
+	uint32_t				m_width;		// `͈
+	uint32_t				m_height;
+	uint32_t				m_bufWidth;		// ^C̑傫ɐ؂グobt@̑傫
+	uint32_t				m_bufHeight;
+	uint32_t				m_tileX;		// ^C
+	uint32_t				m_tileY;
+	DirectX::XMFLOAT4X4		m_viewProj;
+	std::vector<float>		m_depth;		// [x(0:O ` 1:
+	std::vector<float>		m_hiz;			// 8x8sNZƂ̍ł̐[x
+	std::vector<Triangle>	m_triangles;
+	std::vector<std::vector<uint32_t>>	m_tileTriangles;	// ^CƂ̎Op`ԍ
+	Stats					m_stats;
+};
+
+#endif // __OCCLUSION_CULL_H__
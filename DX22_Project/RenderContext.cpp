@@ -0,0 +1,1155 @@
+#include "RenderContext.h"
+#include <string.h>
+
+static_assert(sizeof(RenderContextRecord::Command) == 16, "RenderContextRecord::Command must be 16 bytes.");
+
+// 萔obt@̈ʒuwȂ(obt@S)̔rp
+static const UINT ZERO_CONSTANTS[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT] = {};
+
+// ]ʂ̌vZ(obt@ȊO͍ssb`TZ
+static UINT GetUploadSize(ID3D11Resource* pResource, const D3D11_BOX* pBox, UINT rowPitch)
+{
+	D3D11_RESOURCE_DIMENSION dimension;
+	pResource->GetType(&dimension);
+	if (dimension == D3D11_RESOURCE_DIMENSION_BUFFER)
+	{
+		if (pBox) { return pBox->right - pBox->left; }
+		D3D11_BUFFER_DESC desc;
+		static_cast<ID3D11Buffer*>(pResource)->GetDesc(&desc);
+		return desc.ByteWidth;
+	}
+	if (dimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D)
+	{
+		if (pBox) { return rowPitch * (pBox->bottom - pBox->top); }
+		D3D11_TEXTURE2D_DESC desc;
+		static_cast<ID3D11Texture2D*>(pResource)->GetDesc(&desc);
+		return rowPitch * desc.Height;
+	}
+	return rowPitch;
+}
+
+//----------
+// D3D11
+RenderContextD3D11::RenderContextD3D11(ID3D11DeviceContext* pContext)
+	: m_pContext(pContext)
+	, m_pContext1(nullptr)
+{
+	if (FAILED(pContext->QueryInterface(IID_PPV_ARGS(&m_pContext1))))
+		m_pContext1 = nullptr;
+}
+RenderContextD3D11::~RenderContextD3D11()
+{
+	if (m_pContext1) { m_pContext1->Release(); }
+}
+ID3D11DeviceContext* RenderContextD3D11::GetNative()
+{
+	return m_pContext;
+}
+void RenderContextD3D11::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	m_pContext->IASetPrimitiveTopology(topology);
+}
+void RenderContextD3D11::IASetInputLayout(ID3D11InputLayout* pLayout)
+{
+	m_pContext->IASetInputLayout(pLayout);
+}
+void RenderContextD3D11::IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets)
+{
+	m_pContext->IASetVertexBuffers(slot, num, ppBuffers, pStrides, pOffsets);
+}
+void RenderContextD3D11::IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset)
+{
+	m_pContext->IASetIndexBuffer(pBuffer, format, offset);
+}
+void RenderContextD3D11::VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	m_pContext->VSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextD3D11::PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	m_pContext->PSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextD3D11::VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	m_pContext->VSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextD3D11::PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	m_pContext->PSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextD3D11::VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	// D3D11.1gȂΈʒuwłȂ߁Aobt@Ŝݒ
+	if (m_pContext1)
+		m_pContext1->VSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+	else
+		m_pContext->VSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextD3D11::PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	if (m_pContext1)
+		m_pContext1->PSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+	else
+		m_pContext->PSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextD3D11::VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	m_pContext->VSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextD3D11::PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	m_pContext->PSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextD3D11::PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers)
+{
+	m_pContext->PSSetSamplers(slot, num, ppSamplers);
+}
+void RenderContextD3D11::RSSetState(ID3D11RasterizerState* pState)
+{
+	m_pContext->RSSetState(pState);
+}
+void RenderContextD3D11::RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports)
+{
+	m_pContext->RSSetViewports(num, pViewports);
+}
+void RenderContextD3D11::OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV)
+{
+	m_pContext->OMSetRenderTargets(num, ppRTVs, pDSV);
+}
+void RenderContextD3D11::OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	m_pContext->OMSetBlendState(pState, blendFactor, sampleMask);
+}
+void RenderContextD3D11::OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef)
+{
+	m_pContext->OMSetDepthStencilState(pState, stencilRef);
+}
+void RenderContextD3D11::UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch)
+{
+	m_pContext->UpdateSubresource(pResource, subresource, pBox, pData, rowPitch, depthPitch);
+}
+HRESULT RenderContextD3D11::Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped)
+{
+	return m_pContext->Map(pResource, subresource, type, flags, pMapped);
+}
+void RenderContextD3D11::Unmap(ID3D11Resource* pResource, UINT subresource)
+{
+	m_pContext->Unmap(pResource, subresource);
+}
+void RenderContextD3D11::UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size)
+{
+	m_pContext->Unmap(pResource, subresource);
+}
+void RenderContextD3D11::ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4])
+{
+	m_pContext->ClearRenderTargetView(pRTV, color);
+}
+void RenderContextD3D11::ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil)
+{
+	m_pContext->ClearDepthStencilView(pDSV, flags, depth, stencil);
+}
+void RenderContextD3D11::Draw(UINT vtxCount, UINT startVtx)
+{
+	m_pContext->Draw(vtxCount, startVtx);
+}
+void RenderContextD3D11::DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx)
+{
+	m_pContext->DrawIndexed(idxCount, startIdx, baseVtx);
+}
+void RenderContextD3D11::DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance)
+{
+	m_pContext->DrawInstanced(vtxCount, instanceNum, startVtx, startInstance);
+}
+void RenderContextD3D11::DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance)
+{
+	m_pContext->DrawIndexedInstanced(idxCount, instanceNum, startIdx, baseVtx, startInstance);
+}
+void RenderContextD3D11::ClearState()
+{
+	m_pContext->ClearState();
+}
+
+//----------
+// L^
+RenderContextRecord::RenderContextRecord(RenderContext* pForward)
+	: m_pForward(pForward)
+{
+	Clear();
+}
+RenderContextRecord::~RenderContextRecord()
+{
+}
+void RenderContextRecord::Clear()
+{
+	m_commands.clear();
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+const std::vector<RenderContextRecord::Command>& RenderContextRecord::GetCommands()
+{
+	return m_commands;
+}
+const RenderContextRecord::Stats& RenderContextRecord::GetStats()
+{
+	return m_stats;
+}
+
+void RenderContextRecord::Record(CommandType type, UINT slot, UINT num, UINT value, const void* obj)
+{
+	Record(type, slot, num, value, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(obj)));
+}
+void RenderContextRecord::Record(CommandType type, UINT slot, UINT num, UINT value, uint64_t arg)
+{
+	Command cmd;
+	cmd.type	= type;
+	cmd.slot	= static_cast<uint8_t>(slot);
+	cmd.num		= static_cast<uint16_t>(num);
+	cmd.value	= value;
+	cmd.obj		= arg;
+	m_commands.push_back(cmd);
+
+	// Wv
+	++m_stats.commandNum;
+	++m_stats.typeNum[type];
+	switch (type)
+	{
+	case CMD_DRAW:
+	case CMD_DRAW_INDEXED:
+	case CMD_DRAW_INSTANCED:
+	case CMD_DRAW_INDEXED_INSTANCED:
+		++m_stats.drawNum;
+		break;
+	case CMD_UPDATE:
+	case CMD_MAP:
+		++m_stats.uploadNum;
+		m_stats.uploadBytes += value;
+		break;
+	case CMD_CLEAR_RTV:
+	case CMD_CLEAR_DSV:
+	case CMD_CLEAR_STATE:
+		break;
+	default:
+		++m_stats.stateNum;
+		break;
+	}
+}
+
+void RenderContextRecord::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	Record(CMD_TOPOLOGY, 0, 1, topology, nullptr);
+	if (m_pForward) m_pForward->IASetPrimitiveTopology(topology);
+}
+void RenderContextRecord::IASetInputLayout(ID3D11InputLayout* pLayout)
+{
+	Record(CMD_INPUT_LAYOUT, 0, 1, 0, pLayout);
+	if (m_pForward) m_pForward->IASetInputLayout(pLayout);
+}
+void RenderContextRecord::IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets)
+{
+	Record(CMD_VERTEX_BUFFER, slot, num, pStrides[0], ppBuffers[0]);
+	if (m_pForward) m_pForward->IASetVertexBuffers(slot, num, ppBuffers, pStrides, pOffsets);
+}
+void RenderContextRecord::IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset)
+{
+	Record(CMD_INDEX_BUFFER, 0, 1, format, pBuffer);
+	if (m_pForward) m_pForward->IASetIndexBuffer(pBuffer, format, offset);
+}
+void RenderContextRecord::VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	Record(CMD_VS, 0, 1, 0, pShader);
+	if (m_pForward) m_pForward->VSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextRecord::PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	Record(CMD_PS, 0, 1, 0, pShader);
+	if (m_pForward) m_pForward->PSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextRecord::VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	Record(CMD_VS_CONSTANT_BUFFER, slot, num, 0, ppBuffers[0]);
+	if (m_pForward) m_pForward->VSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextRecord::PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	Record(CMD_PS_CONSTANT_BUFFER, slot, num, 0, ppBuffers[0]);
+	if (m_pForward) m_pForward->PSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextRecord::VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	Record(CMD_VS_CONSTANT_BUFFER, slot, num, pFirstConstant ? pFirstConstant[0] : 0, ppBuffers[0]);
+	if (m_pForward) m_pForward->VSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+}
+void RenderContextRecord::PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	Record(CMD_PS_CONSTANT_BUFFER, slot, num, pFirstConstant ? pFirstConstant[0] : 0, ppBuffers[0]);
+	if (m_pForward) m_pForward->PSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+}
+void RenderContextRecord::VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	Record(CMD_VS_RESOURCE, slot, num, 0, ppViews[0]);
+	if (m_pForward) m_pForward->VSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextRecord::PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	Record(CMD_PS_RESOURCE, slot, num, 0, ppViews[0]);
+	if (m_pForward) m_pForward->PSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextRecord::PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers)
+{
+	Record(CMD_PS_SAMPLER, slot, num, 0, ppSamplers[0]);
+	if (m_pForward) m_pForward->PSSetSamplers(slot, num, ppSamplers);
+}
+void RenderContextRecord::RSSetState(ID3D11RasterizerState* pState)
+{
+	Record(CMD_RASTERIZER, 0, 1, 0, pState);
+	if (m_pForward) m_pForward->RSSetState(pState);
+}
+void RenderContextRecord::RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports)
+{
+	Record(CMD_VIEWPORT, 0, num, 0, nullptr);
+	if (m_pForward) m_pForward->RSSetViewports(num, pViewports);
+}
+void RenderContextRecord::OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV)
+{
+	Record(CMD_RENDER_TARGET, 0, num, 0, num > 0 ? ppRTVs[0] : nullptr);
+	if (m_pForward) m_pForward->OMSetRenderTargets(num, ppRTVs, pDSV);
+}
+void RenderContextRecord::OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	Record(CMD_BLEND, 0, 1, sampleMask, pState);
+	if (m_pForward) m_pForward->OMSetBlendState(pState, blendFactor, sampleMask);
+}
+void RenderContextRecord::OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef)
+{
+	Record(CMD_DEPTH_STENCIL, 0, 1, stencilRef, pState);
+	if (m_pForward) m_pForward->OMSetDepthStencilState(pState, stencilRef);
+}
+void RenderContextRecord::UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch)
+{
+	Record(CMD_UPDATE, subresource, 1, GetUploadSize(pResource, pBox, rowPitch), pResource);
+	if (m_pForward) m_pForward->UpdateSubresource(pResource, subresource, pBox, pData, rowPitch, depthPitch);
+}
+HRESULT RenderContextRecord::Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped)
+{
+	// ]ʂ͏݌ɕ邽߁AL^Unmapōs
+	if (m_pForward)
+	{
+		return m_pForward->Map(pResource, subresource, type, flags, pMapped);
+	}
+
+	// ]悪Ȃꍇ͏ݐ̗̈悾pӂ
+	UINT size = GetUploadSize(pResource, nullptr, 0);
+	if (size == 0) { return E_NOTIMPL; }
+	if (m_mapData.size() < size)
+		m_mapData.resize(size);
+	pMapped->pData = m_mapData.data();
+	pMapped->RowPitch = size;
+	pMapped->DepthPitch = size;
+	return S_OK;
+}
+void RenderContextRecord::Unmap(ID3D11Resource* pResource, UINT subresource)
+{
+	// ͈͂̎w肪Ȃ΃\[XŜ񂾂̂Ƃ
+	Record(CMD_MAP, subresource, 1, GetUploadSize(pResource, nullptr, 0), pResource);
+	if (m_pForward) m_pForward->Unmap(pResource, subresource);
+}
+void RenderContextRecord::UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size)
+{
+	Record(CMD_MAP, subresource, 1, size, pResource);
+	if (m_pForward) m_pForward->UnmapRange(pResource, subresource, offset, size);
+}
+void RenderContextRecord::ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4])
+{
+	Record(CMD_CLEAR_RTV, 0, 1, 0, pRTV);
+	if (m_pForward) m_pForward->ClearRenderTargetView(pRTV, color);
+}
+void RenderContextRecord::ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil)
+{
+	Record(CMD_CLEAR_DSV, 0, 1, flags, pDSV);
+	if (m_pForward) m_pForward->ClearDepthStencilView(pDSV, flags, depth, stencil);
+}
+void RenderContextRecord::Draw(UINT vtxCount, UINT startVtx)
+{
+	Record(CMD_DRAW, 0, 1, vtxCount, static_cast<uint64_t>(startVtx));
+	if (m_pForward) m_pForward->Draw(vtxCount, startVtx);
+}
+void RenderContextRecord::DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx)
+{
+	Record(CMD_DRAW_INDEXED, 0, 1, idxCount, static_cast<uint64_t>(startIdx));
+	if (m_pForward) m_pForward->DrawIndexed(idxCount, startIdx, baseVtx);
+}
+void RenderContextRecord::DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance)
+{
+	uint64_t arg = (static_cast<uint64_t>(vtxCount) << 32) | startVtx;
+	Record(CMD_DRAW_INSTANCED, 0, 1, instanceNum, arg);
+	if (m_pForward) m_pForward->DrawInstanced(vtxCount, instanceNum, startVtx, startInstance);
+}
+void RenderContextRecord::DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance)
+{
+	uint64_t arg = (static_cast<uint64_t>(idxCount) << 32) | startIdx;
+	Record(CMD_DRAW_INDEXED_INSTANCED, 0, 1, instanceNum, arg);
+	if (m_pForward) m_pForward->DrawIndexedInstanced(idxCount, instanceNum, startIdx, baseVtx, startInstance);
+}
+void RenderContextRecord::ClearState()
+{
+	Record(CMD_CLEAR_STATE, 0, 0, 0, nullptr);
+	if (m_pForward) m_pForward->ClearState();
+}
+
+//----------
+// L^ČォĐ
+// ׂ͂8byteɍLĊi[(|C^AA
+static uint64_t ToArg(const void* p)
+{
+	return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+}
+static uint64_t ToArg(float f)
+{
+	uint32_t u;
+	memcpy(&u, &f, sizeof(u));
+	return u;
+}
+template<class T>
+static T* ToPtr(uint64_t arg)
+{
+	return reinterpret_cast<T*>(static_cast<uintptr_t>(arg));
+}
+static float ToFloat(uint64_t arg)
+{
+	uint32_t u = static_cast<uint32_t>(arg);
+	float f;
+	memcpy(&f, &u, sizeof(f));
+	return f;
+}
+template<class T>
+static void WritePtrs(uint64_t* pArgs, T* const* ppValues, UINT num)
+{
+	for (UINT i = 0; i < num; ++i)
+		pArgs[i] = ToArg(ppValues ? ppValues[i] : nullptr);
+}
+template<class T>
+static void ReadPtrs(const uint64_t* pArgs, UINT num, T** ppOut)
+{
+	for (UINT i = 0; i < num; ++i)
+		ppOut[i] = ToPtr<T>(pArgs[i]);
+}
+static void WriteUints(uint64_t* pArgs, const UINT* pValues, UINT num)
+{
+	for (UINT i = 0; i < num; ++i)
+		pArgs[i] = pValues ? pValues[i] : 0;
+}
+static void ReadUints(const uint64_t* pArgs, UINT num, UINT* pOut)
+{
+	for (UINT i = 0; i < num; ++i)
+		pOut[i] = static_cast<UINT>(pArgs[i]);
+}
+
+// Đ̈ꎞ̈̑傫(D3D11̏
+static const UINT LIST_MAX_SLOT = D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT;
+
+RenderContextList::RenderContextList()
+{
+	Clear();
+}
+RenderContextList::~RenderContextList()
+{
+}
+void RenderContextList::Clear()
+{
+	m_stream.clear();
+	m_mappings.clear();
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+bool RenderContextList::IsEmpty() const
+{
+	return m_stream.empty();
+}
+const RenderContextList::Stats& RenderContextList::GetStats() const
+{
+	return m_stats;
+}
+
+uint64_t* RenderContextList::Push(CommandType type, UINT flag, UINT num, size_t argNum)
+{
+	size_t pos = m_stream.size();
+	m_stream.resize(pos + 1 + argNum);
+	m_stream[pos] =
+		static_cast<uint64_t>(type) |
+		static_cast<uint64_t>(flag & 0xff) << 8 |
+		static_cast<uint64_t>(num & 0xffff) << 16 |
+		static_cast<uint64_t>(argNum) << 32;
+	++m_stats.commandNum;
+	m_stats.streamBytes = m_stream.size() * sizeof(uint64_t);
+	// Ȃꍇ͖w߁AYł͂Ȃ|C^ŕԂ
+	return m_stream.data() + pos + 1;
+}
+void RenderContextList::PushData(CommandType type, ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT size, UINT rowPitch, UINT depthPitch)
+{
+	// [\[X][Tu\[X][͈x3][傫][ssb`][[xsb`][f[^...]
+	const size_t HEAD = 8;
+	uint64_t* pArgs = Push(type, pBox ? 1 : 0, 0, HEAD + (size + 7) / 8);
+	pArgs[0] = ToArg(pResource);
+	pArgs[1] = subresource;
+	if (pBox)
+	{
+		pArgs[2] = pBox->left | static_cast<uint64_t>(pBox->right) << 32;
+		pArgs[3] = pBox->top | static_cast<uint64_t>(pBox->bottom) << 32;
+		pArgs[4] = pBox->front | static_cast<uint64_t>(pBox->back) << 32;
+	}
+	pArgs[5] = size;
+	pArgs[6] = rowPitch;
+	pArgs[7] = depthPitch;
+	memcpy(pArgs + HEAD, pData, size);
+	m_stats.uploadBytes += size;
+}
+
+void RenderContextList::Execute(RenderContext* pTarget) const
+{
+	ID3D11Buffer*				pBuffers[LIST_MAX_SLOT];
+	ID3D11ShaderResourceView*	pViews[LIST_MAX_SLOT];
+	ID3D11SamplerState*			pSamplers[LIST_MAX_SLOT];
+	ID3D11RenderTargetView*		pRTVs[LIST_MAX_SLOT];
+	UINT						values[2][LIST_MAX_SLOT];
+	D3D11_VIEWPORT				viewports[LIST_MAX_SLOT];
+
+	size_t pos = 0;
+	while (pos < m_stream.size())
+	{
+		uint64_t head = m_stream[pos];
+		CommandType type = static_cast<CommandType>(head & 0xff);
+		UINT flag = static_cast<UINT>((head >> 8) & 0xff);
+		UINT num = static_cast<UINT>((head >> 16) & 0xffff);
+		size_t argNum = static_cast<size_t>(head >> 32);
+		const uint64_t* pArgs = m_stream.data() + pos + 1;	// ȂΓǂ܂Ȃ
+		pos += 1 + argNum;
+		if (num > LIST_MAX_SLOT) { num = LIST_MAX_SLOT; }
+
+		switch (type)
+		{
+		case RenderContextRecord::CMD_TOPOLOGY:
+			pTarget->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(pArgs[0]));
+			break;
+		case RenderContextRecord::CMD_INPUT_LAYOUT:
+			pTarget->IASetInputLayout(ToPtr<ID3D11InputLayout>(pArgs[0]));
+			break;
+		case RenderContextRecord::CMD_VERTEX_BUFFER:
+			ReadPtrs(pArgs + 1, num, pBuffers);
+			ReadUints(pArgs + 1 + num, num, values[0]);
+			ReadUints(pArgs + 1 + num * 2, num, values[1]);
+			pTarget->IASetVertexBuffers(static_cast<UINT>(pArgs[0]), num, pBuffers, values[0], values[1]);
+			break;
+		case RenderContextRecord::CMD_INDEX_BUFFER:
+			pTarget->IASetIndexBuffer(ToPtr<ID3D11Buffer>(pArgs[0]), static_cast<DXGI_FORMAT>(pArgs[1]), static_cast<UINT>(pArgs[2]));
+			break;
+		case RenderContextRecord::CMD_VS:
+			pTarget->VSSetShader(ToPtr<ID3D11VertexShader>(pArgs[0]), nullptr, 0);
+			break;
+		case RenderContextRecord::CMD_PS:
+			pTarget->PSSetShader(ToPtr<ID3D11PixelShader>(pArgs[0]), nullptr, 0);
+			break;
+		case RenderContextRecord::CMD_VS_CONSTANT_BUFFER:
+		case RenderContextRecord::CMD_PS_CONSTANT_BUFFER:
+		{
+			bool isVS = type == RenderContextRecord::CMD_VS_CONSTANT_BUFFER;
+			UINT slot = static_cast<UINT>(pArgs[0]);
+			ReadPtrs(pArgs + 1, num, pBuffers);
+			if (flag)
+			{
+				// ʒuw肠
+				ReadUints(pArgs + 1 + num, num, values[0]);
+				ReadUints(pArgs + 1 + num * 2, num, values[1]);
+				if (isVS)	pTarget->VSSetConstantBuffers1(slot, num, pBuffers, values[0], values[1]);
+				else		pTarget->PSSetConstantBuffers1(slot, num, pBuffers, values[0], values[1]);
+			}
+			else
+			{
+				if (isVS)	pTarget->VSSetConstantBuffers(slot, num, pBuffers);
+				else		pTarget->PSSetConstantBuffers(slot, num, pBuffers);
+			}
+			break;
+		}
+		case RenderContextRecord::CMD_VS_RESOURCE:
+			ReadPtrs(pArgs + 1, num, pViews);
+			pTarget->VSSetShaderResources(static_cast<UINT>(pArgs[0]), num, pViews);
+			break;
+		case RenderContextRecord::CMD_PS_RESOURCE:
+			ReadPtrs(pArgs + 1, num, pViews);
+			pTarget->PSSetShaderResources(static_cast<UINT>(pArgs[0]), num, pViews);
+			break;
+		case RenderContextRecord::CMD_PS_SAMPLER:
+			ReadPtrs(pArgs + 1, num, pSamplers);
+			pTarget->PSSetSamplers(static_cast<UINT>(pArgs[0]), num, pSamplers);
+			break;
+		case RenderContextRecord::CMD_RASTERIZER:
+			pTarget->RSSetState(ToPtr<ID3D11RasterizerState>(pArgs[0]));
+			break;
+		case RenderContextRecord::CMD_VIEWPORT:
+			for (UINT i = 0; i < num; ++i)
+			{
+				const uint64_t* pVP = pArgs + i * 6;
+				viewports[i].TopLeftX	= ToFloat(pVP[0]);
+				viewports[i].TopLeftY	= ToFloat(pVP[1]);
+				viewports[i].Width		= ToFloat(pVP[2]);
+				viewports[i].Height		= ToFloat(pVP[3]);
+				viewports[i].MinDepth	= ToFloat(pVP[4]);
+				viewports[i].MaxDepth	= ToFloat(pVP[5]);
+			}
+			pTarget->RSSetViewports(num, viewports);
+			break;
+		case RenderContextRecord::CMD_RENDER_TARGET:
+			ReadPtrs(pArgs + 1, num, pRTVs);
+			pTarget->OMSetRenderTargets(num, pRTVs, ToPtr<ID3D11DepthStencilView>(pArgs[0]));
+			break;
+		case RenderContextRecord::CMD_BLEND:
+		{
+			FLOAT factor[4] = { ToFloat(pArgs[1]), ToFloat(pArgs[2]), ToFloat(pArgs[3]), ToFloat(pArgs[4]) };
+			pTarget->OMSetBlendState(ToPtr<ID3D11BlendState>(pArgs[0]), flag ? factor : nullptr, static_cast<UINT>(pArgs[5]));
+			break;
+		}
+		case RenderContextRecord::CMD_DEPTH_STENCIL:
+			pTarget->OMSetDepthStencilState(ToPtr<ID3D11DepthStencilState>(pArgs[0]), static_cast<UINT>(pArgs[1]));
+			break;
+		case RenderContextRecord::CMD_UPDATE:
+		{
+			D3D11_BOX box;
+			box.left	= static_cast<UINT>(pArgs[2]);	box.right	= static_cast<UINT>(pArgs[2] >> 32);
+			box.top		= static_cast<UINT>(pArgs[3]);	box.bottom	= static_cast<UINT>(pArgs[3] >> 32);
+			box.front	= static_cast<UINT>(pArgs[4]);	box.back	= static_cast<UINT>(pArgs[4] >> 32);
+			pTarget->UpdateSubresource(ToPtr<ID3D11Resource>(pArgs[0]), static_cast<UINT>(pArgs[1]),
+				flag ? &box : nullptr, pArgs + 8, static_cast<UINT>(pArgs[6]), static_cast<UINT>(pArgs[7]));
+			break;
+		}
+		case RenderContextRecord::CMD_MAP:
+		{
+			ID3D11Resource* pResource = ToPtr<ID3D11Resource>(pArgs[0]);
+			UINT subresource = static_cast<UINT>(pArgs[1]);
+			D3D11_MAPPED_SUBRESOURCE mapped;
+			if (SUCCEEDED(pTarget->Map(pResource, subresource, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+			{
+				// ͈͕t(UnmapRange)͔͈͂̐擪֏
+				UINT offset = flag ? static_cast<UINT>(pArgs[2]) : 0;
+				UINT size = static_cast<UINT>(pArgs[5]);
+				memcpy(static_cast<char*>(mapped.pData) + offset, pArgs + 8, size);
+				if (flag)
+					pTarget->UnmapRange(pResource, subresource, offset, size);
+				else
+					pTarget->Unmap(pResource, subresource);
+			}
+			break;
+		}
+		case RenderContextRecord::CMD_CLEAR_RTV:
+		{
+			FLOAT color[4] = { ToFloat(pArgs[1]), ToFloat(pArgs[2]), ToFloat(pArgs[3]), ToFloat(pArgs[4]) };
+			pTarget->ClearRenderTargetView(ToPtr<ID3D11RenderTargetView>(pArgs[0]), color);
+			break;
+		}
+		case RenderContextRecord::CMD_CLEAR_DSV:
+			pTarget->ClearDepthStencilView(ToPtr<ID3D11DepthStencilView>(pArgs[0]), static_cast<UINT>(pArgs[1]),
+				ToFloat(pArgs[2]), static_cast<UINT8>(pArgs[3]));
+			break;
+		case RenderContextRecord::CMD_DRAW:
+			pTarget->Draw(static_cast<UINT>(pArgs[0]), static_cast<UINT>(pArgs[1]));
+			break;
+		case RenderContextRecord::CMD_DRAW_INDEXED:
+			pTarget->DrawIndexed(static_cast<UINT>(pArgs[0]), static_cast<UINT>(pArgs[1]), static_cast<INT>(static_cast<UINT>(pArgs[2])));
+			break;
+		case RenderContextRecord::CMD_DRAW_INSTANCED:
+			pTarget->DrawInstanced(static_cast<UINT>(pArgs[0]), static_cast<UINT>(pArgs[1]), static_cast<UINT>(pArgs[2]), static_cast<UINT>(pArgs[3]));
+			break;
+		case RenderContextRecord::CMD_DRAW_INDEXED_INSTANCED:
+			pTarget->DrawIndexedInstanced(static_cast<UINT>(pArgs[0]), static_cast<UINT>(pArgs[1]), static_cast<UINT>(pArgs[2]),
+				static_cast<INT>(static_cast<UINT>(pArgs[3])), static_cast<UINT>(pArgs[4]));
+			break;
+		case RenderContextRecord::CMD_CLEAR_STATE:
+			pTarget->ClearState();
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void RenderContextList::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	Push(RenderContextRecord::CMD_TOPOLOGY, 0, 0, 1)[0] = topology;
+}
+void RenderContextList::IASetInputLayout(ID3D11InputLayout* pLayout)
+{
+	Push(RenderContextRecord::CMD_INPUT_LAYOUT, 0, 0, 1)[0] = ToArg(pLayout);
+}
+void RenderContextList::IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_VERTEX_BUFFER, 0, num, 1 + num * 3);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppBuffers, num);
+	WriteUints(pArgs + 1 + num, pStrides, num);
+	WriteUints(pArgs + 1 + num * 2, pOffsets, num);
+}
+void RenderContextList::IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_INDEX_BUFFER, 0, 0, 3);
+	pArgs[0] = ToArg(pBuffer);
+	pArgs[1] = format;
+	pArgs[2] = offset;
+}
+// NXCX^X͎gpĂȂߋL^Ȃ
+void RenderContextList::VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	Push(RenderContextRecord::CMD_VS, 0, 0, 1)[0] = ToArg(pShader);
+}
+void RenderContextList::PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	Push(RenderContextRecord::CMD_PS, 0, 0, 1)[0] = ToArg(pShader);
+}
+void RenderContextList::VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_VS_CONSTANT_BUFFER, 0, num, 1 + num);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppBuffers, num);
+}
+void RenderContextList::PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_PS_CONSTANT_BUFFER, 0, num, 1 + num);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppBuffers, num);
+}
+void RenderContextList::VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_VS_CONSTANT_BUFFER, 1, num, 1 + num * 3);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppBuffers, num);
+	WriteUints(pArgs + 1 + num, pFirstConstant, num);
+	WriteUints(pArgs + 1 + num * 2, pNumConstants, num);
+}
+void RenderContextList::PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_PS_CONSTANT_BUFFER, 1, num, 1 + num * 3);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppBuffers, num);
+	WriteUints(pArgs + 1 + num, pFirstConstant, num);
+	WriteUints(pArgs + 1 + num * 2, pNumConstants, num);
+}
+void RenderContextList::VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_VS_RESOURCE, 0, num, 1 + num);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppViews, num);
+}
+void RenderContextList::PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_PS_RESOURCE, 0, num, 1 + num);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppViews, num);
+}
+void RenderContextList::PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_PS_SAMPLER, 0, num, 1 + num);
+	pArgs[0] = slot;
+	WritePtrs(pArgs + 1, ppSamplers, num);
+}
+void RenderContextList::RSSetState(ID3D11RasterizerState* pState)
+{
+	Push(RenderContextRecord::CMD_RASTERIZER, 0, 0, 1)[0] = ToArg(pState);
+}
+void RenderContextList::RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_VIEWPORT, 0, num, num * 6);
+	for (UINT i = 0; i < num; ++i)
+	{
+		uint64_t* pVP = pArgs + i * 6;
+		pVP[0] = ToArg(pViewports[i].TopLeftX);
+		pVP[1] = ToArg(pViewports[i].TopLeftY);
+		pVP[2] = ToArg(pViewports[i].Width);
+		pVP[3] = ToArg(pViewports[i].Height);
+		pVP[4] = ToArg(pViewports[i].MinDepth);
+		pVP[5] = ToArg(pViewports[i].MaxDepth);
+	}
+}
+void RenderContextList::OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_RENDER_TARGET, 0, num, 1 + num);
+	pArgs[0] = ToArg(pDSV);
+	WritePtrs(pArgs + 1, ppRTVs, num);
+}
+void RenderContextList::OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_BLEND, blendFactor ? 1 : 0, 0, 6);
+	pArgs[0] = ToArg(pState);
+	for (int i = 0; i < 4; ++i)
+		pArgs[1 + i] = ToArg(blendFactor ? blendFactor[i] : 1.0f);
+	pArgs[5] = sampleMask;
+}
+void RenderContextList::OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_DEPTH_STENCIL, 0, 0, 2);
+	pArgs[0] = ToArg(pState);
+	pArgs[1] = stencilRef;
+}
+void RenderContextList::UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch)
+{
+	UINT size = GetUploadSize(pResource, pBox, rowPitch);
+	if (size == 0) { return; }
+	PushData(RenderContextRecord::CMD_UPDATE, pResource, subresource, pBox, pData, size, rowPitch, depthPitch);
+}
+HRESULT RenderContextList::Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped)
+{
+	// NO_OVERWRITE͏񂾔͈͂炸Aǂݍ݂͋L^ɓeȂߔΉ
+	if (type != D3D11_MAP_WRITE_DISCARD) { return E_NOTIMPL; }
+	UINT size = GetUploadSize(pResource, nullptr, 0);
+	if (size == 0) { return E_NOTIMPL; }
+
+	// Đɂ܂Ƃ߂ďނ߁AUnmap܂ł͎茳̗̈֏܂
+	Mapping* pMapping = nullptr;
+	for (size_t i = 0; i < m_mappings.size(); ++i)
+	{
+		if (m_mappings[i].pResource == pResource && m_mappings[i].subresource == subresource)
+			pMapping = &m_mappings[i];
+	}
+	if (!pMapping)
+	{
+		m_mappings.push_back(Mapping());
+		pMapping = &m_mappings.back();
+		pMapping->pResource = pResource;
+		pMapping->subresource = subresource;
+	}
+	pMapping->data.resize(size);
+	pMapped->pData = pMapping->data.data();
+	pMapped->RowPitch = size;
+	pMapped->DepthPitch = size;
+	return S_OK;
+}
+void RenderContextList::Unmap(ID3D11Resource* pResource, UINT subresource)
+{
+	for (size_t i = 0; i < m_mappings.size(); ++i)
+	{
+		Mapping& mapping = m_mappings[i];
+		if (mapping.pResource != pResource || mapping.subresource != subresource) { continue; }
+		PushData(RenderContextRecord::CMD_MAP, pResource, subresource, nullptr, mapping.data.data(),
+			static_cast<UINT>(mapping.data.size()), 0, 0);
+		m_mappings.erase(m_mappings.begin() + i);
+		return;
+	}
+}
+void RenderContextList::UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size)
+{
+	for (size_t i = 0; i < m_mappings.size(); ++i)
+	{
+		Mapping& mapping = m_mappings[i];
+		if (mapping.pResource != pResource || mapping.subresource != subresource) { continue; }
+
+		// ͈͊O͏܂ĂȂߓ]Ȃ(DISCARD̂ߍĐe͕sł悢
+		UINT mapSize = static_cast<UINT>(mapping.data.size());
+		if (offset > mapSize) { offset = mapSize; }
+		if (size > mapSize - offset) { size = mapSize - offset; }
+		D3D11_BOX box = { offset, 0, 0, offset + size, 1, 1 };
+		PushData(RenderContextRecord::CMD_MAP, pResource, subresource, &box, mapping.data.data() + offset, size, 0, 0);
+		m_mappings.erase(m_mappings.begin() + i);
+		return;
+	}
+}
+void RenderContextList::ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4])
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_CLEAR_RTV, 0, 0, 5);
+	pArgs[0] = ToArg(pRTV);
+	for (int i = 0; i < 4; ++i)
+		pArgs[1 + i] = ToArg(color[i]);
+}
+void RenderContextList::ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_CLEAR_DSV, 0, 0, 4);
+	pArgs[0] = ToArg(pDSV);
+	pArgs[1] = flags;
+	pArgs[2] = ToArg(depth);
+	pArgs[3] = stencil;
+}
+void RenderContextList::Draw(UINT vtxCount, UINT startVtx)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_DRAW, 0, 0, 2);
+	pArgs[0] = vtxCount;
+	pArgs[1] = startVtx;
+	++m_stats.drawNum;
+}
+void RenderContextList::DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_DRAW_INDEXED, 0, 0, 3);
+	pArgs[0] = idxCount;
+	pArgs[1] = startIdx;
+	pArgs[2] = static_cast<UINT>(baseVtx);
+	++m_stats.drawNum;
+}
+void RenderContextList::DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_DRAW_INSTANCED, 0, 0, 4);
+	pArgs[0] = vtxCount;
+	pArgs[1] = instanceNum;
+	pArgs[2] = startVtx;
+	pArgs[3] = startInstance;
+	++m_stats.drawNum;
+}
+void RenderContextList::DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance)
+{
+	uint64_t* pArgs = Push(RenderContextRecord::CMD_DRAW_INDEXED_INSTANCED, 0, 0, 5);
+	pArgs[0] = idxCount;
+	pArgs[1] = instanceNum;
+	pArgs[2] = startIdx;
+	pArgs[3] = static_cast<UINT>(baseVtx);
+	pArgs[4] = startInstance;
+	++m_stats.drawNum;
+}
+void RenderContextList::ClearState()
+{
+	Push(RenderContextRecord::CMD_CLEAR_STATE, 0, 0, 0);
+}
+
+//----------
+// Ԃ̕ێ
+RenderContextCache::RenderContextCache(RenderContext* pForward)
+	: m_pForward(pForward)
+{
+	Invalidate();
+	ResetStats();
+}
+RenderContextCache::~RenderContextCache()
+{
+}
+void RenderContextCache::Invalidate()
+{
+	// s邱Ƃ̂Ȃl(Srbg1)Ŗ߂āA̐ݒKs
+	memset(&m_topology, 0xff, sizeof(m_topology));
+	memset(&m_pLayout, 0xff, sizeof(m_pLayout));
+	memset(m_pVtxBuffers, 0xff, sizeof(m_pVtxBuffers));
+	memset(m_vtxStrides, 0xff, sizeof(m_vtxStrides));
+	memset(m_vtxOffsets, 0xff, sizeof(m_vtxOffsets));
+	memset(&m_pIdxBuffer, 0xff, sizeof(m_pIdxBuffer));
+	memset(&m_idxFormat, 0xff, sizeof(m_idxFormat));
+	memset(&m_idxOffset, 0xff, sizeof(m_idxOffset));
+	memset(&m_pVS, 0xff, sizeof(m_pVS));
+	memset(&m_pPS, 0xff, sizeof(m_pPS));
+	memset(m_pVSBuffers, 0xff, sizeof(m_pVSBuffers));
+	memset(m_pPSBuffers, 0xff, sizeof(m_pPSBuffers));
+	memset(m_vsFirstConstants, 0xff, sizeof(m_vsFirstConstants));
+	memset(m_vsNumConstants, 0xff, sizeof(m_vsNumConstants));
+	memset(m_psFirstConstants, 0xff, sizeof(m_psFirstConstants));
+	memset(m_psNumConstants, 0xff, sizeof(m_psNumConstants));
+	memset(m_pVSResources, 0xff, sizeof(m_pVSResources));
+	memset(m_pPSResources, 0xff, sizeof(m_pPSResources));
+	memset(m_pSamplers, 0xff, sizeof(m_pSamplers));
+	memset(&m_pRasterizer, 0xff, sizeof(m_pRasterizer));
+	memset(&m_pBlend, 0xff, sizeof(m_pBlend));
+	memset(m_blendFactor, 0xff, sizeof(m_blendFactor));
+	memset(&m_sampleMask, 0xff, sizeof(m_sampleMask));
+	memset(&m_pDepthStencil, 0xff, sizeof(m_pDepthStencil));
+	memset(&m_stencilRef, 0xff, sizeof(m_stencilRef));
+}
+void RenderContextCache::ResetStats()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+const RenderContextCache::Stats& RenderContextCache::GetStats()
+{
+	return m_stats;
+}
+
+template<class T>
+bool RenderContextCache::IsSameSlots(T* pCache, UINT cacheNum, UINT slot, UINT num, T const* ppValues)
+{
+	// ێĂȂXbg܂ޏꍇ͏ɔs
+	// (ێĂ͈͔͂s̒lȂȂ邽ߔj
+	if (slot + num > cacheNum)
+	{
+		if (slot < cacheNum)
+			memset(&pCache[slot], 0xff, sizeof(T) * (cacheNum - slot));
+		return false;
+	}
+
+	bool same = true;
+	for (UINT i = 0; i < num; ++i)
+	{
+		if (pCache[slot + i] != ppValues[i])
+		{
+			pCache[slot + i] = ppValues[i];
+			same = false;
+		}
+	}
+	return same;
+}
+bool RenderContextCache::Filter(bool same)
+{
+	if (same)
+		++m_stats.filteredNum;
+	else
+		++m_stats.issuedNum;
+	return same;
+}
+
+void RenderContextCache::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	if (Filter(m_topology == topology)) { return; }
+	m_topology = topology;
+	m_pForward->IASetPrimitiveTopology(topology);
+}
+void RenderContextCache::IASetInputLayout(ID3D11InputLayout* pLayout)
+{
+	if (Filter(m_pLayout == pLayout)) { return; }
+	m_pLayout = pLayout;
+	m_pForward->IASetInputLayout(pLayout);
+}
+void RenderContextCache::IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets)
+{
+	// 3Ƃr邽߁AZ]ɂׂčXV
+	bool same = IsSameSlots(m_pVtxBuffers, MAX_VERTEX_BUFFER, slot, num, ppBuffers);
+	same &= IsSameSlots(m_vtxStrides, MAX_VERTEX_BUFFER, slot, num, pStrides);
+	same &= IsSameSlots(m_vtxOffsets, MAX_VERTEX_BUFFER, slot, num, pOffsets);
+	if (Filter(same)) { return; }
+	m_pForward->IASetVertexBuffers(slot, num, ppBuffers, pStrides, pOffsets);
+}
+void RenderContextCache::IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset)
+{
+	if (Filter(m_pIdxBuffer == pBuffer && m_idxFormat == format && m_idxOffset == offset)) { return; }
+	m_pIdxBuffer = pBuffer;
+	m_idxFormat = format;
+	m_idxOffset = offset;
+	m_pForward->IASetIndexBuffer(pBuffer, format, offset);
+}
+void RenderContextCache::VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	if (Filter(m_pVS == pShader && instanceNum == 0)) { return; }
+	m_pVS = pShader;
+	m_pForward->VSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextCache::PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum)
+{
+	if (Filter(m_pPS == pShader && instanceNum == 0)) { return; }
+	m_pPS = pShader;
+	m_pForward->PSSetShader(pShader, ppInstances, instanceNum);
+}
+void RenderContextCache::VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	// ʒuwȂ̓obt@S(0,0)̐ݒƂĔr
+	bool same = IsSameSlots(m_pVSBuffers, MAX_CONSTANT_BUFFER, slot, num, ppBuffers);
+	same &= IsSameSlots(m_vsFirstConstants, MAX_CONSTANT_BUFFER, slot, num, ZERO_CONSTANTS);
+	same &= IsSameSlots(m_vsNumConstants, MAX_CONSTANT_BUFFER, slot, num, ZERO_CONSTANTS);
+	if (Filter(same)) { return; }
+	m_pForward->VSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextCache::PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers)
+{
+	bool same = IsSameSlots(m_pPSBuffers, MAX_CONSTANT_BUFFER, slot, num, ppBuffers);
+	same &= IsSameSlots(m_psFirstConstants, MAX_CONSTANT_BUFFER, slot, num, ZERO_CONSTANTS);
+	same &= IsSameSlots(m_psNumConstants, MAX_CONSTANT_BUFFER, slot, num, ZERO_CONSTANTS);
+	if (Filter(same)) { return; }
+	m_pForward->PSSetConstantBuffers(slot, num, ppBuffers);
+}
+void RenderContextCache::VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	bool same = IsSameSlots(m_pVSBuffers, MAX_CONSTANT_BUFFER, slot, num, ppBuffers);
+	same &= IsSameSlots(m_vsFirstConstants, MAX_CONSTANT_BUFFER, slot, num, pFirstConstant ? pFirstConstant : ZERO_CONSTANTS);
+	same &= IsSameSlots(m_vsNumConstants, MAX_CONSTANT_BUFFER, slot, num, pNumConstants ? pNumConstants : ZERO_CONSTANTS);
+	if (Filter(same)) { return; }
+	m_pForward->VSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+}
+void RenderContextCache::PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants)
+{
+	bool same = IsSameSlots(m_pPSBuffers, MAX_CONSTANT_BUFFER, slot, num, ppBuffers);
+	same &= IsSameSlots(m_psFirstConstants, MAX_CONSTANT_BUFFER, slot, num, pFirstConstant ? pFirstConstant : ZERO_CONSTANTS);
+	same &= IsSameSlots(m_psNumConstants, MAX_CONSTANT_BUFFER, slot, num, pNumConstants ? pNumConstants : ZERO_CONSTANTS);
+	if (Filter(same)) { return; }
+	m_pForward->PSSetConstantBuffers1(slot, num, ppBuffers, pFirstConstant, pNumConstants);
+}
+void RenderContextCache::VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	if (Filter(IsSameSlots(m_pVSResources, MAX_RESOURCE, slot, num, ppViews))) { return; }
+	m_pForward->VSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextCache::PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews)
+{
+	if (Filter(IsSameSlots(m_pPSResources, MAX_RESOURCE, slot, num, ppViews))) { return; }
+	m_pForward->PSSetShaderResources(slot, num, ppViews);
+}
+void RenderContextCache::PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers)
+{
+	if (Filter(IsSameSlots(m_pSamplers, MAX_SAMPLER, slot, num, ppSamplers))) { return; }
+	m_pForward->PSSetSamplers(slot, num, ppSamplers);
+}
+void RenderContextCache::RSSetState(ID3D11RasterizerState* pState)
+{
+	if (Filter(m_pRasterizer == pState)) { return; }
+	m_pRasterizer = pState;
+	m_pForward->RSSetState(pState);
+}
+void RenderContextCache::RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports)
+{
+	Filter(false);
+	m_pForward->RSSetViewports(num, pViewports);
+}
+void RenderContextCache::OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV)
+{
+	// o͐ɐݒ肵\[X̓VF[_[\[XO邽߁AێĂlj
+	Filter(false);
+	memset(m_pVSResources, 0xff, sizeof(m_pVSResources));
+	memset(m_pPSResources, 0xff, sizeof(m_pPSResources));
+	m_pForward->OMSetRenderTargets(num, ppRTVs, pDSV);
+}
+void RenderContextCache::OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	FLOAT factor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };	// NULLw莞̊l
+	if (blendFactor)
+		memcpy(factor, blendFactor, sizeof(factor));
+	if (Filter(m_pBlend == pState && m_sampleMask == sampleMask &&
+		memcmp(m_blendFactor, factor, sizeof(factor)) == 0)) { return; }
+	m_pBlend = pState;
+	m_sampleMask = sampleMask;
+	memcpy(m_blendFactor, factor, sizeof(factor));
+	m_pForward->OMSetBlendState(pState, blendFactor, sampleMask);
+}
+void RenderContextCache::OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef)
+{
+	if (Filter(m_pDepthStencil == pState && m_stencilRef == stencilRef)) { return; }
+	m_pDepthStencil = pState;
+	m_stencilRef = stencilRef;
+	m_pForward->OMSetDepthStencilState(pState, stencilRef);
+}
+void RenderContextCache::UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch)
+{
+	m_pForward->UpdateSubresource(pResource, subresource, pBox, pData, rowPitch, depthPitch);
+}
+HRESULT RenderContextCache::Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped)
+{
+	return m_pForward->Map(pResource, subresource, type, flags, pMapped);
+}
+void RenderContextCache::Unmap(ID3D11Resource* pResource, UINT subresource)
+{
+	m_pForward->Unmap(pResource, subresource);
+}
+void RenderContextCache::UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size)
+{
+	m_pForward->UnmapRange(pResource, subresource, offset, size);
+}
+void RenderContextCache::ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4])
+{
+	m_pForward->ClearRenderTargetView(pRTV, color);
+}
+void RenderContextCache::ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil)
+{
+	m_pForward->ClearDepthStencilView(pDSV, flags, depth, stencil);
+}
+void RenderContextCache::Draw(UINT vtxCount, UINT startVtx)
+{
+	m_pForward->Draw(vtxCount, startVtx);
+}
+void RenderContextCache::DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx)
+{
+	m_pForward->DrawIndexed(idxCount, startIdx, baseVtx);
+}
+void RenderContextCache::DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance)
+{
+	m_pForward->DrawInstanced(vtxCount, instanceNum, startVtx, startInstance);
+}
+void RenderContextCache::DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance)
+{
+	m_pForward->DrawIndexedInstanced(idxCount, instanceNum, startIdx, baseVtx, startInstance);
+}
+void RenderContextCache::ClearState()
+{
+	Invalidate();
+	m_pForward->ClearState();
+}
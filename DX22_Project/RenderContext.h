@@ -0,0 +1,391 @@
+#ifndef __RENDER_CONTEXT_H__
+#define __RENDER_CONTEXT_H__
+
+#include <d3d11_1.h>
+#include <vector>
+#include <stdint.h>
+
+// `R}h̔s
+// ID3D11DeviceContextƓOAŌĂяo悤ɂĂA
+// @ւ̔sƋL^(wbhXv)ւ悤ɂ
+class RenderContext
+{
+public:
+	virtual ~RenderContext() {}
+
+	// ̓AZu
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+	virtual void IASetInputLayout(ID3D11InputLayout* pLayout) = 0;
+	virtual void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets) = 0;
+	virtual void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) = 0;
+
+	// VF[_[
+	virtual void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum) = 0;
+	virtual void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum) = 0;
+	virtual void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers) = 0;
+	virtual void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers) = 0;
+	// obt@̈ꕔݒ(D3D11.1AʒuƑ傫16bytePʂ16̔{
+	virtual void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants) = 0;
+	virtual void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants) = 0;
+	virtual void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews) = 0;
+	virtual void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews) = 0;
+	virtual void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers) = 0;
+
+	// X^CUAo
+	virtual void RSSetState(ID3D11RasterizerState* pState) = 0;
+	virtual void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports) = 0;
+	virtual void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV) = 0;
+	virtual void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) = 0;
+
+	// \[XXV
+	virtual void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch) = 0;
+	virtual HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped) = 0;
+	virtual void Unmap(ID3D11Resource* pResource, UINT subresource) = 0;
+	// 񂾔͈(byte)w肵Unmap(NO_OVERWRITEŒǋLꍇȂ
+	// @ւ͒ʏUnmapƂĔsAL^ł͔͈͂̑傫]ʂƂĐ
+	virtual void UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size) = 0;
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]) = 0;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil) = 0;
+
+	// `
+	virtual void Draw(UINT vtxCount, UINT startVtx) = 0;
+	virtual void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx) = 0;
+	virtual void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance) = 0;
+	virtual void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance) = 0;
+
+	virtual void ClearState() = 0;
+};
+
+//----------
+// D3D11̃foCXReLXgւ̂܂ܔs
+class RenderContextD3D11 : public RenderContext
+{
+public:
+	RenderContextD3D11(ID3D11DeviceContext* pContext);
+	~RenderContextD3D11();
+
+	ID3D11DeviceContext* GetNative();
+
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void IASetInputLayout(ID3D11InputLayout* pLayout);
+	void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets);
+	void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset);
+	void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers);
+	void RSSetState(ID3D11RasterizerState* pState);
+	void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports);
+	void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV);
+	void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask);
+	void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef);
+	void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch);
+	HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped);
+	void Unmap(ID3D11Resource* pResource, UINT subresource);
+	void UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size);
+	void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]);
+	void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil);
+	void Draw(UINT vtxCount, UINT startVtx);
+	void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx);
+	void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance);
+	void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance);
+	void ClearState();
+
+private:
+	ID3D11DeviceContext* m_pContext;
+	ID3D11DeviceContext1* m_pContext1;	// D3D11.1gȂłnullptr
+};
+
+//----------
+// sꂽR}hL^
+// ]w肷ƁAL^ł̂܂ܓ]
+class RenderContextRecord : public RenderContext
+{
+public:
+	// R}h̎
+	enum CommandType : uint8_t
+	{
+		CMD_TOPOLOGY,
+		CMD_INPUT_LAYOUT,
+		CMD_VERTEX_BUFFER,
+		CMD_INDEX_BUFFER,
+		CMD_VS,
+		CMD_PS,
+		CMD_VS_CONSTANT_BUFFER,
+		CMD_PS_CONSTANT_BUFFER,
+		CMD_VS_RESOURCE,
+		CMD_PS_RESOURCE,
+		CMD_PS_SAMPLER,
+		CMD_RASTERIZER,
+		CMD_VIEWPORT,
+		CMD_RENDER_TARGET,
+		CMD_BLEND,
+		CMD_DEPTH_STENCIL,
+		CMD_UPDATE,
+		CMD_MAP,
+		CMD_CLEAR_RTV,
+		CMD_CLEAR_DSV,
+		CMD_DRAW,
+		CMD_DRAW_INDEXED,
+		CMD_DRAW_INSTANCED,
+		CMD_DRAW_INDEXED_INSTANCED,
+		CMD_CLEAR_STATE,
+		CMD_MAX
+	};
+
+	// L^R}h(16byteŒ
+	// objɂ͐ݒ肳ꂽIuWFNg̃AhXA`R}hł͊Jnʒui[
+	// (CX^X`łvalueɃCX^XAobj̏32bitɕ`搔i[
+	struct Command
+	{
+		CommandType	type;
+		uint8_t		slot;	// ݒXbg
+		uint16_t	num;	// ݒ萔
+		uint32_t	value;	// `搔A]oCgȂ
+		uint64_t	obj;
+	};
+
+	// L^̏Wv
+	struct Stats
+	{
+		UINT	commandNum;			// R}h
+		UINT	drawNum;			// `R}h
+		UINT	stateNum;			// ԕύXR}h
+		UINT	uploadNum;			// ]R}h
+		UINT64	uploadBytes;		// ]
+		UINT	typeNum[CMD_MAX];	// ޕʂ̃R}h
+	};
+
+public:
+	RenderContextRecord(RenderContext* pForward = nullptr);
+	~RenderContextRecord();
+
+	// L^̔j(t[̊JnɌĂяo
+	void Clear();
+	const std::vector<Command>& GetCommands();
+	const Stats& GetStats();
+
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void IASetInputLayout(ID3D11InputLayout* pLayout);
+	void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets);
+	void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset);
+	void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers);
+	void RSSetState(ID3D11RasterizerState* pState);
+	void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports);
+	void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV);
+	void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask);
+	void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef);
+	void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch);
+	HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped);
+	void Unmap(ID3D11Resource* pResource, UINT subresource);
+	void UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size);
+	void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]);
+	void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil);
+	void Draw(UINT vtxCount, UINT startVtx);
+	void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx);
+	void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance);
+	void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance);
+	void ClearState();
+
+private:
+	void Record(CommandType type, UINT slot, UINT num, UINT value, const void* obj);
+	void Record(CommandType type, UINT slot, UINT num, UINT value, uint64_t arg);
+
+private:
+	RenderContext*			m_pForward;	// ](nullptrł΋L^̂
+	std::vector<Command>	m_commands;
+	Stats					m_stats;
+	std::vector<char>		m_mapData;	// ]悪ȂꍇMapݐ
+};
+
+//----------
+// sꂽR}hA]eƋL^Aォʂ̔s֍Đ
+// [J[XbhƂɗpӂĕ`L^A`XbhŏԂɍĐ
+// (foCXReLXggpȂ߁Aǂ̃XbhłL^ł
+// EMapWRITE_DISCARD̂ݑΉ(񂾓eUnmap̈ʒuœ]AUnmapRangê͔͈͓
+// EMapAUpdateSubresource̓obt@2DeNX`̂ݑΉ
+class RenderContextList : public RenderContext
+{
+public:
+	// L^̏Wv
+	struct Stats
+	{
+		UINT	commandNum;		// R}h
+		UINT	drawNum;		// `R}h
+		UINT64	uploadBytes;	// ]
+		UINT64	streamBytes;	// L^ɎgpĂ傫
+	};
+
+public:
+	RenderContextList();
+	~RenderContextList();
+
+	// L^̔j(mۍς݂̗͍̈ėp
+	void Clear();
+	// L^R}hԂɔs(L^͎c
+	void Execute(RenderContext* pTarget) const;
+	bool IsEmpty() const;
+	const Stats& GetStats() const;
+
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void IASetInputLayout(ID3D11InputLayout* pLayout);
+	void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets);
+	void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset);
+	void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers);
+	void RSSetState(ID3D11RasterizerState* pState);
+	void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports);
+	void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV);
+	void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask);
+	void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef);
+	void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch);
+	HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped);
+	void Unmap(ID3D11Resource* pResource, UINT subresource);
+	void UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size);
+	void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]);
+	void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil);
+	void Draw(UINT vtxCount, UINT startVtx);
+	void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx);
+	void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance);
+	void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance);
+	void ClearState();
+
+private:
+	using CommandType = RenderContextRecord::CommandType;
+
+	// Unmap܂ł̏ݐ
+	struct Mapping
+	{
+		ID3D11Resource*		pResource;
+		UINT				subresource;
+		std::vector<char>	data;
+	};
+
+	// R}h̐擪ǉȀݐԂ(8byteP
+	uint64_t* Push(CommandType type, UINT flag, UINT num, size_t argNum);
+	void PushData(CommandType type, ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT size, UINT rowPitch, UINT depthPitch);
+
+private:
+	std::vector<uint64_t>	m_stream;	// [擪(,tO,,̐)][...]̌JԂ
+	std::vector<Mapping>	m_mappings;
+	Stats					m_stats;
+};
+
+//----------
+// ݒς݂̏ԂێAݒ̍Ĕsȗē]֓n
+class RenderContextCache : public RenderContext
+{
+public:
+	// s̏Wv
+	struct Stats
+	{
+		UINT issuedNum;		// ]֔sݒ
+		UINT filteredNum;	// ݒ̂ߏȗݒ
+	};
+
+public:
+	RenderContextCache(RenderContext* pForward);
+	~RenderContextCache();
+
+	// ێĂԂ̔j(OŒڏԂύXꍇɌĂяo
+	void Invalidate();
+	// Wv̔j(t[̊JnɌĂяo
+	void ResetStats();
+	const Stats& GetStats();
+
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void IASetInputLayout(ID3D11InputLayout* pLayout);
+	void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets);
+	void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset);
+	void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum);
+	void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers);
+	void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants);
+	void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews);
+	void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers);
+	void RSSetState(ID3D11RasterizerState* pState);
+	void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports);
+	void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV);
+	void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask);
+	void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef);
+	void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch);
+	HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped);
+	void Unmap(ID3D11Resource* pResource, UINT subresource);
+	void UnmapRange(ID3D11Resource* pResource, UINT subresource, UINT offset, UINT size);
+	void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]);
+	void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil);
+	void Draw(UINT vtxCount, UINT startVtx);
+	void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx);
+	void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance);
+	void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance);
+	void ClearState();
+
+private:
+	// ێXbg(𒴂Xbg͏ɔs
+	static const UINT MAX_VERTEX_BUFFER		= 4;
+	static const UINT MAX_CONSTANT_BUFFER	= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+	static const UINT MAX_RESOURCE			= 16;
+	static const UINT MAX_SAMPLER			= D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT;
+
+	// Xbg̐ݒrAύXȂtrue
+	// ύXΕێĂlXV
+	template<class T>
+	bool IsSameSlots(T* pCache, UINT cacheNum, UINT slot, UINT num, T const* ppValues);
+	bool Filter(bool same);
+
+private:
+	RenderContext*				m_pForward;
+	Stats						m_stats;
+
+	D3D11_PRIMITIVE_TOPOLOGY	m_topology;
+	ID3D11InputLayout*			m_pLayout;
+	ID3D11Buffer*				m_pVtxBuffers[MAX_VERTEX_BUFFER];
+	UINT						m_vtxStrides[MAX_VERTEX_BUFFER];
+	UINT						m_vtxOffsets[MAX_VERTEX_BUFFER];
+	ID3D11Buffer*				m_pIdxBuffer;
+	DXGI_FORMAT					m_idxFormat;
+	UINT						m_idxOffset;
+	ID3D11VertexShader*			m_pVS;
+	ID3D11PixelShader*			m_pPS;
+	ID3D11Buffer*				m_pVSBuffers[MAX_CONSTANT_BUFFER];
+	ID3D11Buffer*				m_pPSBuffers[MAX_CONSTANT_BUFFER];
+	UINT						m_vsFirstConstants[MAX_CONSTANT_BUFFER];	// 0,0̓obt@S
+	UINT						m_vsNumConstants[MAX_CONSTANT_BUFFER];
+	UINT						m_psFirstConstants[MAX_CONSTANT_BUFFER];
+	UINT						m_psNumConstants[MAX_CONSTANT_BUFFER];
+	ID3D11ShaderResourceView*	m_pVSResources[MAX_RESOURCE];
+	ID3D11ShaderResourceView*	m_pPSResources[MAX_RESOURCE];
+	ID3D11SamplerState*			m_pSamplers[MAX_SAMPLER];
+	ID3D11RasterizerState*		m_pRasterizer;
+	ID3D11BlendState*			m_pBlend;
+	FLOAT						m_blendFactor[4];
+	UINT						m_sampleMask;
+	ID3D11DepthStencilState*	m_pDepthStencil;
+	UINT						m_stencilRef;
+};
+
+#endif // __RENDER_CONTEXT_H__
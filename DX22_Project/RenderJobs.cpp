@@ -0,0 +1,153 @@
+#include "RenderJobs.h"
+#include "ConstantBufferRing.h"
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// [J[Xbh(Initō쐬AUninit܂Ŏg
+static std::vector<std::thread>	g_workers;
+static std::mutex				g_jobLock;
+static std::condition_variable	g_jobStart;	// L^̊Jn̒ʒm
+static std::condition_variable	g_jobEnd;	// S[J[Xbh̋L^̏I̒ʒm
+static UINT						g_round = 0;	// JnL^̔ԍ([J[XbhQς݂̔
+static UINT						g_activeNum = 0;	// L^̃[J[Xbh
+static bool						g_quit = false;
+// s̍
+static RenderJobs::Job			g_job = nullptr;
+static void*					g_pArg = nullptr;
+static UINT						g_jobNum = 0;
+static std::atomic<UINT>		g_next(0);
+
+//--- ÓIo
+std::vector<RenderContextList*>	RenderJobs::m_lists;
+UINT							RenderJobs::m_threadNum = 1;
+RenderJobs::Stats				RenderJobs::m_stats;
+
+void RenderJobs::Init(UINT threadNum)
+{
+	if (threadNum == 0)
+		threadNum = std::max(std::thread::hardware_concurrency(), 1u);
+	m_threadNum = threadNum;
+	memset(&m_stats, 0, sizeof(m_stats));
+
+	g_quit = false;
+	for (UINT i = 1; i < m_threadNum; ++i)
+		g_workers.push_back(std::thread(WorkerMain));
+}
+void RenderJobs::Uninit()
+{
+	{
+		std::lock_guard<std::mutex> lock(g_jobLock);
+		g_quit = true;
+	}
+	g_jobStart.notify_all();
+	for (size_t i = 0; i < g_workers.size(); ++i)
+		g_workers[i].join();
+	g_workers.clear();
+
+	for (size_t i = 0; i < m_lists.size(); ++i)
+		delete m_lists[i];
+	m_lists.clear();
+}
+
+void RenderJobs::Run(UINT jobNum, Job job, void* pArg)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.jobNum = jobNum;
+	if (jobNum == 0) { return; }
+
+	// ӖȂ΂̂܂ܔs
+	UINT threadNum = std::min(m_threadNum, jobNum);
+	m_stats.threadNum = threadNum;
+	if (threadNum <= 1)
+	{
+		for (UINT i = 0; i < jobNum; ++i)
+			job(pArg, i);
+		return;
+	}
+
+	while (m_lists.size() < jobNum)
+		m_lists.push_back(new RenderContextList());
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	// 󂢂ĂƂ珇ɊeXbhŋL^(萔͂̊ԊJ܂܂̃O֏
+	ConstantBufferRing::BeginRecording();
+	g_job = job;
+	g_pArg = pArg;
+	g_jobNum = jobNum;
+	g_next = 0;
+	{
+		std::lock_guard<std::mutex> lock(g_jobLock);
+		++g_round;
+		g_activeNum = static_cast<UINT>(g_workers.size());
+	}
+	g_jobStart.notify_all();
+	Record();
+	{
+		std::unique_lock<std::mutex> lock(g_jobLock);
+		g_jobEnd.wait(lock, []() { return g_activeNum == 0; });
+	}
+	ConstantBufferRing::EndRecording();
+
+	std::chrono::high_resolution_clock::time_point record = std::chrono::high_resolution_clock::now();
+
+	// Ƃ̔ԍɍĐ
+	RenderContext* pContext = GetContext();
+	for (UINT i = 0; i < jobNum; ++i)
+	{
+		const RenderContextList* pList = m_lists[i];
+		pList->Execute(pContext);
+		m_stats.commandNum += pList->GetStats().commandNum;
+		m_stats.streamBytes += pList->GetStats().streamBytes;
+	}
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	m_stats.recordTime = std::chrono::duration<float, std::milli>(record - start).count();
+	m_stats.executeTime = std::chrono::duration<float, std::milli>(end - record).count();
+}
+
+void RenderJobs::Record()
+{
+	UINT index;
+	while ((index = g_next++) < g_jobNum)
+	{
+		RenderContextList* pList = m_lists[index];
+		pList->Clear();
+		SetThreadContext(pList);
+		g_job(g_pArg, index);
+	}
+	SetThreadContext(nullptr);
+}
+void RenderJobs::WorkerMain()
+{
+	UINT round = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(g_jobLock);
+			g_jobStart.wait(lock, [&round]() { return g_quit || g_round != round; });
+			if (g_quit) { return; }
+			round = g_round;
+		}
+		Record();
+		{
+			std::lock_guard<std::mutex> lock(g_jobLock);
+			if (--g_activeNum == 0)
+				g_jobEnd.notify_one();
+		}
+	}
+}
+
+UINT RenderJobs::GetThreadNum()
+{
+	return m_threadNum;
+}
+const RenderJobs::Stats& RenderJobs::GetStats()
+{
+	return m_stats;
+}
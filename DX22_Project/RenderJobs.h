@@ -0,0 +1,53 @@
+#ifndef __RENDER_JOBS_H__
+#define __RENDER_JOBS_H__
+
+#include "DirectX.h"
+#include <vector>
+
+// [J[Xbhł̕`̋L^
+// `𕡐̍ƂɕAƂƂRenderContextList֊eXbhŋL^ƁA
+// ĂяõXbhōƂ̔ԍɍĐ(ʂ͔ԍɌĂяoꍇƓɂȂ
+// ƓłGetContextƂƂ̋L^Ԃ
+// EƂ܂œIuWFNg̏ԂύXȂ(VF[_[ւWriteBufferASetTextureȂ
+// E萔͋L^̊ԊJ܂܂̒萔obt@̃O֏(ȂΊeVF[_[̃obt@ւ̓]ƂȂ
+class RenderJobs
+{
+public:
+	// (index0`Ɛ-1
+	using Job = void(*)(void* pArg, UINT index);
+
+	// O̎s̏Wv
+	struct Stats
+	{
+		UINT	jobNum;			// Ɛ
+		UINT	threadNum;		// gpXbh(Ăяo܂
+		UINT	commandNum;		// L^R}h
+		UINT64	streamBytes;	// L^Ɏgp傫
+		float	recordTime;		// L^ɂ(~b
+		float	executeTime;	// Đɂ(~b
+	};
+
+public:
+	// threadNum0w肷CPŨXbh(Ăяõ[J[Xbh쐬Ă
+	static void Init(UINT threadNum = 0);
+	static void Uninit();
+
+	// ƂeXbhŋL^AԍɍĐ
+	// Xbh1gȂꍇAƂ1̏ꍇ͋L^ɂ̂܂܌Ăяo
+	static void Run(UINT jobNum, Job job, void* pArg);
+
+	static UINT GetThreadNum();
+	static const Stats& GetStats();
+
+private:
+	// 󂢂ĂƂ珇ɋL^(e[J[XbhƌĂяõXbhŎs
+	static void Record();
+	static void WorkerMain();
+
+private:
+	static std::vector<RenderContextList*>	m_lists;	// ƂƂ̋L^(t[܂ōėp
+	static UINT								m_threadNum;
+	static Stats							m_stats;
+};
+
+#endif // __RENDER_JOBS_H__
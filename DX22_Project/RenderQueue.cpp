@@ -0,0 +1,289 @@
+#include "RenderQueue.h"
+#include "RenderJobs.h"
+#include "ShaderList.h"
+#include <string.h>
+#include <algorithm>
+#include <utility>
+
+//--- \[gL[̃rbgzu
+// [63-60] C[ [59] 
+// s: [58-47] VF[_[ [46-35] }eA [34-23] eNX` [22-0] [x
+// : [58-36] [x(]) [35-24] VF[_[ [23-12] }eA [11-0] eNX`
+// VF[_[A}eAAeNX`̓t[̘A(AddStateKeys
+static const int		KEY_ID_BITS		= 12;
+static const int		KEY_DEPTH_BITS	= 23;
+static const uint64_t	KEY_ID_MASK		= (1ull << KEY_ID_BITS) - 1;
+static const uint64_t	KEY_DEPTH_MASK	= (1ull << KEY_DEPTH_BITS) - 1;
+
+//--- ÓIo
+std::vector<RenderQueue::Item>	RenderQueue::m_items;
+std::vector<uint64_t>			RenderQueue::m_keys;
+std::vector<const void*>		RenderQueue::m_materials;
+std::unordered_map<uint64_t, UINT>	RenderQueue::m_shaderIndices;
+std::unordered_map<uint64_t, UINT>	RenderQueue::m_materialIndices;
+std::unordered_map<uint64_t, UINT>	RenderQueue::m_textureIndices;
+std::vector<uint32_t>			RenderQueue::m_order;
+std::vector<uint64_t>			RenderQueue::m_tmpKeys;
+std::vector<uint32_t>			RenderQueue::m_tmpOrder;
+float							RenderQueue::m_nearZ = 0.0f;
+float							RenderQueue::m_farZ = 1000.0f;
+RenderQueue::Stats				RenderQueue::m_stats;
+std::vector<RenderQueue::Stats>	RenderQueue::m_jobStats;
+
+void RenderQueue::Init()
+{
+	m_items.reserve(1024);
+	m_keys.reserve(1024);
+	m_materials.reserve(1024);
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+void RenderQueue::Uninit()
+{
+	m_items.clear();		m_items.shrink_to_fit();
+	m_keys.clear();			m_keys.shrink_to_fit();
+	m_materials.clear();	m_materials.shrink_to_fit();
+	m_shaderIndices.clear();
+	m_materialIndices.clear();
+	m_textureIndices.clear();
+	m_order.clear();		m_order.shrink_to_fit();
+	m_tmpKeys.clear();		m_tmpKeys.shrink_to_fit();
+	m_tmpOrder.clear();		m_tmpOrder.shrink_to_fit();
+	m_jobStats.clear();		m_jobStats.shrink_to_fit();
+}
+
+void RenderQueue::SetDepthRange(float nearZ, float farZ)
+{
+	m_nearZ = nearZ;
+	m_farZ = farZ > nearZ ? farZ : nearZ + 1.0f;
+}
+
+void RenderQueue::Submit(const Item& item, const void* material, float depth, UINT layer, bool transparent)
+{
+	m_items.push_back(item);
+	m_materials.push_back(material);
+	m_keys.push_back(MakeKey(depth, layer, transparent));
+}
+
+void RenderQueue::Flush()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.itemNum = static_cast<UINT>(m_items.size());
+	if (m_items.empty()) { return; }
+
+	AddStateKeys();
+	Sort();
+
+	// `撼Ȍ͔Cӂ̏ԂύX邽߁A܂܂ĂΕɕ`悷
+	UINT num = static_cast<UINT>(m_order.size());
+	UINT jobNum = std::min(RenderJobs::GetThreadNum(), num / PARALLEL_MIN);
+	for (UINT i = 0; i < num && jobNum > 1; ++i)
+	{
+		if (m_items[i].callback)
+			jobNum = 1;
+	}
+	if (jobNum <= 1)
+	{
+		DrawRange(0, num, &m_stats);
+	}
+	else
+	{
+		// я𕪊ĊeXbhŋL^AԂɍĐ
+		m_jobStats.resize(jobNum);
+		RenderJobs::Run(jobNum, [](void* pArg, UINT index) {
+			UINT num = static_cast<UINT>(m_order.size());
+			UINT jobNum = *static_cast<UINT*>(pArg);
+			memset(&m_jobStats[index], 0, sizeof(Stats));
+			DrawRange(num * index / jobNum, num * (index + 1) / jobNum, &m_jobStats[index]);
+		}, &jobNum);
+		for (UINT i = 0; i < jobNum; ++i)
+		{
+			m_stats.vsChangeNum		+= m_jobStats[i].vsChangeNum;
+			m_stats.psChangeNum		+= m_jobStats[i].psChangeNum;
+			m_stats.texChangeNum	+= m_jobStats[i].texChangeNum;
+			m_stats.matChangeNum	+= m_jobStats[i].matChangeNum;
+		}
+	}
+
+	Clear();
+}
+
+// яbegin`end`
+// OƓVF[_[AeNX`A[hs̐ݒ͏ȗ
+// eNX`ƃ}eA̓VF[_[̏ԂύXɒڐݒ肷(XbhœVF[_[g
+void RenderQueue::DrawRange(UINT begin, UINT end, Stats* pStats)
+{
+	RenderContext*	pContext = GetContext();
+	VertexShader*	pVS = nullptr;
+	PixelShader*	pPS = nullptr;
+	Texture*		pTex = nullptr;
+	bool			texValid = false;	// pTexݒ蒆̓e(nullptr̃eNX`ƂĐݒ肷邽
+	ID3D11Buffer*	pMat = nullptr;
+	const DirectX::XMFLOAT4X4* pWorld = nullptr;
+	for (UINT i = begin; i < end; ++i)
+	{
+		const Item& item = m_items[m_order[i]];
+		if (!pWorld || memcmp(pWorld, &item.world, sizeof(item.world)) != 0)
+		{
+			pWorld = &item.world;
+			ShaderList::SetWorld(item.world);
+		}
+		if (item.pVS != pVS)
+		{
+			pVS = item.pVS;
+			pVS->Bind();
+			++pStats->vsChangeNum;
+		}
+		if (item.pPS != pPS)
+		{
+			pPS = item.pPS;
+			pPS->Bind();
+			texValid = false;	// BindŃeNX`Đݒ肳邽
+			pMat = nullptr;
+			++pStats->psChangeNum;
+		}
+
+		if (item.callback)
+		{
+			item.callback(item.pArg, item.param);
+			texValid = false;
+			pMat = nullptr;
+		}
+		else
+		{
+			if (!texValid || item.pTexture != pTex)
+			{
+				pTex = item.pTexture;
+				texValid = true;
+				Texture* pBind = pTex ? pTex : Shader::GetDefaultTexture();
+				ID3D11ShaderResourceView* pSRV = pBind ? pBind->GetResource() : nullptr;
+				pContext->PSSetShaderResources(0, 1, &pSRV);
+				++pStats->texChangeNum;
+			}
+			if (item.pMaterial && item.pMaterial != pMat)
+			{
+				pMat = item.pMaterial;
+				pContext->PSSetConstantBuffers(0, 1, &pMat);
+				++pStats->matChangeNum;
+			}
+		}
+
+		item.pMesh->Draw();
+	}
+}
+
+void RenderQueue::Clear()
+{
+	m_items.clear();
+	m_keys.clear();
+	m_materials.clear();
+}
+
+const RenderQueue::Stats& RenderQueue::GetStats()
+{
+	return m_stats;
+}
+
+uint64_t RenderQueue::MakeKey(float depth, UINT layer, bool transparent)
+{
+	// [x0`1ɐKėʎq
+	float rate = (depth - m_nearZ) / (m_farZ - m_nearZ);
+	rate = rate < 0.0f ? 0.0f : (rate > 1.0f ? 1.0f : rate);
+	uint64_t depthKey = static_cast<uint64_t>(rate * KEY_DEPTH_MASK);
+
+	uint64_t key = static_cast<uint64_t>(layer & (LAYER_MAX - 1)) << 60;
+	if (!transparent)
+	{
+		key |= depthKey;
+	}
+	else
+	{
+		// `悷邽ߐ[x𔽓]
+		key |= 1ull << 59;
+		key |= (KEY_DEPTH_MASK - depthKey) << 36;
+	}
+	return key;
+}
+
+// VF[_[A}eAAeNX`t[̓oꏇ̘AԂ֒uăL[֒ǉ
+// (ʔԍAhX̂܂܃rbgɐ؂l߂ƁAʂ̂̂lɂȂ邽
+void RenderQueue::AddStateKeys()
+{
+	m_shaderIndices.clear();
+	m_materialIndices.clear();
+	m_textureIndices.clear();
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		const Item& item = m_items[i];
+		uint64_t shaderKey = GetIndex(&m_shaderIndices,
+			(static_cast<uint64_t>(item.pVS->GetID()) << 32) | item.pPS->GetID());
+		uint64_t materialKey = GetIndex(&m_materialIndices,
+			static_cast<uint64_t>(reinterpret_cast<uintptr_t>(m_materials[i])));
+		uint64_t texKey = GetIndex(&m_textureIndices, item.pTexture ? item.pTexture->GetID() : 0);
+
+		if (!(m_keys[i] & (1ull << 59)))
+			m_keys[i] |= (shaderKey << 47) | (materialKey << 35) | (texKey << 23);
+		else
+			m_keys[i] |= (shaderKey << 24) | (materialKey << 12) | texKey;
+	}
+}
+// ʂɑΉA(rbg𒴂镪͍Ō̒lɂ܂Ƃ߂
+UINT RenderQueue::GetIndex(std::unordered_map<uint64_t, UINT>* pIndices, uint64_t id)
+{
+	auto it = pIndices->find(id);
+	if (it != pIndices->end()) { return it->second; }
+	UINT index = static_cast<UINT>(std::min<size_t>(pIndices->size(), KEY_ID_MASK));
+	pIndices->insert(std::make_pair(id, index));
+	return index;
+}
+
+// 8bitLSD\[gŃL[̏ɕׂ`揇쐬
+void RenderQueue::Sort()
+{
+	size_t num = m_keys.size();
+	m_order.resize(num);
+	m_tmpKeys.resize(num);
+	m_tmpOrder.resize(num);
+	for (size_t i = 0; i < num; ++i)
+		m_order[i] = static_cast<uint32_t>(i);
+
+	uint64_t* pKeys = m_keys.data();
+	uint32_t* pOrder = m_order.data();
+	uint64_t* pTmpKeys = m_tmpKeys.data();
+	uint32_t* pTmpOrder = m_tmpOrder.data();
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		// eoPbg̐𐔂
+		uint32_t count[256] = {};
+		for (size_t i = 0; i < num; ++i)
+			++count[(pKeys[i] >> shift) & 0xff];
+
+		// ׂēoPbgłΕёւsv
+		if (count[(pKeys[0] >> shift) & 0xff] == num)
+			continue;
+
+		// ݈ʒǔvZ
+		uint32_t offset = 0;
+		for (int i = 0; i < 256; ++i)
+		{
+			uint32_t c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+
+		// 肵ĐU蕪
+		for (size_t i = 0; i < num; ++i)
+		{
+			uint32_t dst = count[(pKeys[i] >> shift) & 0xff]++;
+			pTmpKeys[dst] = pKeys[i];
+			pTmpOrder[dst] = pOrder[i];
+		}
+		std::swap(pKeys, pTmpKeys);
+		std::swap(pOrder, pTmpOrder);
+	}
+
+	// ŏIʂƗ̈摤ɂꍇ͖߂
+	if (pOrder != m_order.data())
+	{
+		memcpy(m_order.data(), pOrder, sizeof(uint32_t) * num);
+	}
+}
@@ -0,0 +1,93 @@
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__
+
+#include "Shader.h"
+#include "MeshBuffer.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+// `L[
+// `v𗭂߂ĂAt[ňx\[gL[ŕёւĂ`悷
+// Es C[ > VF[_[ > }eA > eNX` > O牜
+// E C[ > O > VF[_[ > }eA > eNX`
+// VF[_[A}eAAeNX`̓t[Ƃɓoꏇ̘AԂ֒uĂL[쐬
+// `搔A`撼Ȍ(callback)܂܂Ȃꍇ͕я𕪊ĕXbhŋL^(RenderJobs
+class RenderQueue
+{
+public:
+	// `撼OɌĂяo鏈(萔obt@݂̏Ȃ
+	using DrawCallback = void(*)(void* pArg, UINT param);
+
+	// `v
+	struct Item
+	{
+		VertexShader*	pVS;
+		PixelShader*	pPS;
+		MeshBuffer*		pMesh;
+		Texture*		pTexture;	// PS̃Xbg0ɐݒ(nullptr͔Acallbackw莞͐ݒ肵Ȃ
+		ID3D11Buffer*	pMaterial;	// PS̒萔obt@0ɐݒ(nullptrAcallbackw莞͐ݒ肵Ȃ
+		DrawCallback	callback;
+		void*			pArg;
+		UINT			param;
+		DirectX::XMFLOAT4X4	world;	// ShaderList::SetWorldŐݒ肷郏[hs(]uς
+	};
+
+	// `̏Wv
+	struct Stats
+	{
+		UINT itemNum;		// `搔
+		UINT vsChangeNum;	// _VF[_[̐؂ւ
+		UINT psChangeNum;	// sNZVF[_[̐؂ւ
+		UINT texChangeNum;	// eNX`̐؂ւ
+		UINT matChangeNum;	// }eA萔̐؂ւ
+	};
+
+	// 萔`
+	static const UINT LAYER_MAX = 16;	// C[(0珇ɕ`
+	static const UINT PARALLEL_MIN = 256;	// 1Xbh̍ŏ̕`搔(ꖢł͕Ȃ
+
+public:
+	static void Init();
+	static void Uninit();
+
+	// [x̐K͈(J̋
+	static void SetDepthRange(float nearZ, float farZ);
+
+	// `v̒ǉ(material͓}eAׂ邽߂̎ʁAModel::Material̃AhXȂ
+	static void Submit(const Item& item, const void* material, float depth,
+		UINT layer = 0, bool transparent = false);
+	// ёւĕ`悵AL[ɂ
+	static void Flush();
+	// `悹ɃL[ɂ
+	static void Clear();
+
+	static const Stats& GetStats();
+
+private:
+	// C[AA[x̃L[(Submitɍ쐬
+	static uint64_t MakeKey(float depth, UINT layer, bool transparent);
+	// AԂ֒uVF[_[A}eAAeNX`L[֒ǉ
+	static void AddStateKeys();
+	static UINT GetIndex(std::unordered_map<uint64_t, UINT>* pIndices, uint64_t id);
+	static void Sort();
+	static void DrawRange(UINT begin, UINT end, Stats* pStats);
+
+private:
+	static std::vector<Item>		m_items;
+	static std::vector<uint64_t>	m_keys;
+	static std::vector<const void*>	m_materials;	// `vƂ̃}eA̎
+	static std::unordered_map<uint64_t, UINT>	m_shaderIndices;	// ʂAԂւ̕ϊ(t[Ƃɍ蒼
+	static std::unordered_map<uint64_t, UINT>	m_materialIndices;
+	static std::unordered_map<uint64_t, UINT>	m_textureIndices;
+	static std::vector<uint32_t>	m_order;
+	static std::vector<uint64_t>	m_tmpKeys;	// ёւp̍Ɨ̈
+	static std::vector<uint32_t>	m_tmpOrder;
+	static float					m_nearZ;
+	static float					m_farZ;
+	static Stats					m_stats;
+	static std::vector<Stats>		m_jobStats;	// XbhƂ̏Wv
+};
+
+#endif // __RENDER_QUEUE_H__
@@ -1,17 +1,102 @@
 #include "Shader.h"
 #include <d3dcompiler.h>
 #include <stdio.h>
+#include <string.h>
+#include <algorithm>
 
 #pragma comment(lib, "d3dcompiler.lib")
 
+// RpCς݃VF[_[̕ۑ
+static const char* SHADER_CACHE_DIR = "ShaderCache/";
+
+// t@C̓ǂݍ
+static bool ReadBinary(const char* pFileName, std::vector<char>* pData)
+{
+	FILE* fp;
+	fopen_s(&fp, pFileName, "rb");
+	if (!fp) { return false; }
+
+	// t@C̃TCY𒲂ׂ
+	fseek(fp, 0, SEEK_END);
+	long fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	// ɓǂݍ
+	pData->resize(fileSize > 0 ? fileSize : 0);
+	size_t readSize = fileSize > 0 ? fread(pData->data(), fileSize, 1, fp) : 0;
+	fclose(fp);
+	return readSize == 1;
+}
+
+// nbVl(FNV-1a)փf[^ǉ
+static const uint64_t HASH_BASIS = 14695981039346656037ull;
+static uint64_t AddHash(uint64_t hash, const void* pData, size_t size)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(pData);
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= p[i];
+		hash *= 1099511628211ull;
+	}
+	hash ^= 0xff;	// ؂
+	hash *= 1099511628211ull;
+	return hash;
+}
+
+// LbṼt@C(RpCʂɉêׂĂnbVl쐬
+static std::string MakeCachePath(const char* pCode, const D3D_SHADER_MACRO* pDefines, const char* pTarget, UINT flags)
+{
+	uint64_t hash = HASH_BASIS;
+	auto add = [&hash](const void* pData, size_t size) {
+		hash = AddHash(hash, pData, size);
+	};
+	add(pCode, strlen(pCode));
+	for (const D3D_SHADER_MACRO* pDef = pDefines; pDef && pDef->Name; ++pDef)
+	{
+		add(pDef->Name, strlen(pDef->Name));
+		if (pDef->Definition)
+			add(pDef->Definition, strlen(pDef->Definition));
+	}
+	add(pTarget, strlen(pTarget));
+	add(&flags, sizeof(flags));
+	UINT version = D3D_COMPILER_VERSION;
+	add(&version, sizeof(version));
+
+	char name[32];
+	sprintf_s(name, "%016llx.cso", static_cast<unsigned long long>(hash));
+	return std::string(SHADER_CACHE_DIR) + name;
+}
+
 //----------
 // {NX
+UINT Shader::m_idCount = 0;
+std::vector<Shader*> Shader::m_shaders;
+thread_local Shader* Shader::m_pBindShader[2] = { nullptr, nullptr };
+Texture* Shader::m_pDefaultTexture = nullptr;
+
 Shader::Shader(Kind kind)
 	: m_kind(kind)
+	, m_id(++m_idCount)
 {
+	if (m_shaders.empty())
+	{
+		ConstantBufferRing::AddDiscardCallback(OnRingDiscard);
+		Texture::AddReleaseCallback(OnTextureRelease);
+	}
+	m_shaders.push_back(this);
 }
 Shader::~Shader()
 {
+	if (m_compile.valid())
+		m_compile.wait();
+	m_shaders.erase(std::find(m_shaders.begin(), m_shaders.end(), this));
+	if (m_shaders.empty())
+	{
+		ConstantBufferRing::RemoveDiscardCallback(OnRingDiscard);
+		Texture::RemoveReleaseCallback(OnTextureRelease);
+	}
+	if (m_pBindShader[m_kind] == this)
+		m_pBindShader[m_kind] = nullptr;
 	std::vector<ID3D11Buffer*>::iterator it = m_pBuffers.begin();
 	while (it != m_pBuffers.end())
 	{
@@ -21,64 +106,151 @@ Shader::~Shader()
 }
 HRESULT Shader::Load(const char* pFileName)
 {
-	HRESULT hr = E_FAIL;
-
 	// t@Cǂݍ
-	FILE* fp;
-	fopen_s(&fp, pFileName, "rb");
-	if (!fp) { return hr; }
-
-	// t@C̃TCY𒲂ׂ
-	int fileSize = 0;
-	fseek(fp, 0, SEEK_END);
-	fileSize = ftell(fp);
-
-	// ɓǂݍ
-	fseek(fp, 0, SEEK_SET);
-	char* pData = new char[fileSize];
-	fread(pData, fileSize, 1, fp);
-	fclose(fp);
+	std::vector<char> data;
+	if (!ReadBinary(pFileName, &data)) { return E_FAIL; }
 
 	// VF[_[쐬
-	hr = Make(pData, fileSize);
-	
-	// I
-	if (pData) { delete[] pData; }
+	return Make(data.data(), static_cast<UINT>(data.size()));
+}
+HRESULT Shader::Compile(const char *pCode, const D3D_SHADER_MACRO* pDefines)
+{
+	HRESULT hr = Prepare(pCode, pDefines);
+	if (FAILED(hr)) { return hr; }
+	hr = Create(m_bytecode.data(), static_cast<UINT>(m_bytecode.size()));
+	std::vector<char>().swap(m_bytecode);
 	return hr;
 }
-HRESULT Shader::Compile(const char *pCode)
+void Shader::CompileAsync(const char* pCode, const D3D_SHADER_MACRO* pDefines)
+{
+	// }N͌ĂяoŔjĂ悢悤Ă
+	std::vector<std::string> names;
+	for (const D3D_SHADER_MACRO* pDef = pDefines; pDef && pDef->Name; ++pDef)
+	{
+		names.push_back(pDef->Name);
+		names.push_back(pDef->Definition ? pDef->Definition : "");
+	}
+
+	m_compile = std::async(std::launch::async, [this, pCode, names]() {
+		std::vector<D3D_SHADER_MACRO> defines;
+		for (size_t i = 0; i < names.size(); i += 2)
+			defines.push_back({ names[i].c_str(), names[i + 1].c_str() });
+		defines.push_back({ nullptr, nullptr });
+		return Prepare(pCode, defines.data());
+	});
+}
+HRESULT Shader::WaitCompile()
+{
+	if (!m_compile.valid()) { return E_FAIL; }
+	HRESULT hr = m_compile.get();
+	if (FAILED(hr)) { return hr; }
+	hr = Create(m_bytecode.data(), static_cast<UINT>(m_bytecode.size()));
+	std::vector<char>().swap(m_bytecode);
+	return hr;
+}
+
+HRESULT Shader::CompileBytecode(const char* pCode, const D3D_SHADER_MACRO* pDefines, Kind kind, bool useCache, std::vector<char>* pOut)
 {
 	static const char *pTargetList[] = 
 	{
 		"vs_5_0",
 		"ps_5_0"
 	};
+#ifdef _DEBUG
+	UINT compileFlag = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	UINT compileFlag = D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#endif
+
+	// RpCς݂łΓǂݍ
+	std::string cachePath = MakeCachePath(pCode, pDefines, pTargetList[kind], compileFlag);
+	if (useCache && ReadBinary(cachePath.c_str(), pOut))
+		return S_OK;
 
 	HRESULT hr;
 	ID3DBlob *pBlob;
 	ID3DBlob *error;
-	UINT compileFlag = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-	hr = D3DCompile(pCode, strlen(pCode), nullptr, nullptr, nullptr,
-		"main", pTargetList[m_kind], compileFlag, 0, &pBlob, &error);
+	hr = D3DCompile(pCode, strlen(pCode), nullptr, pDefines, nullptr,
+		"main", pTargetList[kind], compileFlag, 0, &pBlob, &error);
+	SAFE_RELEASE(error);
 	if (FAILED(hr)) { return hr; }
-
-	// VF[_쐬
-	hr = Make(pBlob->GetBufferPointer(), (UINT)pBlob->GetBufferSize());
+	const char* pData = static_cast<const char*>(pBlob->GetBufferPointer());
+	pOut->assign(pData, pData + pBlob->GetBufferSize());
 	SAFE_RELEASE(pBlob);
-	SAFE_RELEASE(error);
+
+	// ̂߂ɕۑ(ۑłȂĂ͑
+	CreateDirectoryA(SHADER_CACHE_DIR, NULL);
+	FILE* fp;
+	fopen_s(&fp, cachePath.c_str(), "wb");
+	if (fp)
+	{
+		fwrite(pOut->data(), pOut->size(), 1, fp);
+		fclose(fp);
+	}
+	return S_OK;
+}
+HRESULT Shader::Prepare(const char* pCode, const D3D_SHADER_MACRO* pDefines)
+{
+	// LbVĂĉ͂łȂ΃RpC
+	HRESULT hr = CompileBytecode(pCode, pDefines, m_kind, true, &m_bytecode);
+	if (SUCCEEDED(hr))
+		hr = Reflect(m_bytecode.data(), static_cast<UINT>(m_bytecode.size()));
+	if (FAILED(hr))
+	{
+		hr = CompileBytecode(pCode, pDefines, m_kind, false, &m_bytecode);
+		if (SUCCEEDED(hr))
+			hr = Reflect(m_bytecode.data(), static_cast<UINT>(m_bytecode.size()));
+	}
 	return hr;
 }
 
+UINT Shader::GetID() const
+{
+	return m_id;
+}
+bool Shader::IsBound() const
+{
+	return m_pBindShader[m_kind] == this;
+}
+
 void Shader::WriteBuffer(UINT slot, void* pData)
 {
-	if(slot < m_pBuffers.size())
+	if (slot >= m_pBuffers.size() || !m_pBuffers[slot]) { return; }
+	m_pExternalBuffers[slot] = nullptr;
+
+	if (ConstantBufferRing::IsEnabled())
+	{
+		memcpy(m_bufferData[slot].data(), pData, m_bufferSizes[slot]);
+		if (!ConstantBufferRing::Write(pData, m_bufferSizes[slot], &m_blocks[slot]))
+			m_blocks[slot].pBuffer = nullptr;
+	}
+	if (!m_blocks[slot].pBuffer)
+	{
 		GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, pData, 0, 0);
+		ConstantBufferRing::AddFallback(m_bufferSizes[slot]);
+	}
+
+	// ݒ蒆łΏ񂾈ʒuݒ肵
+	if (m_pBindShader[m_kind] == this)
+		BindBuffer(slot);
+}
+void Shader::SetBuffer(UINT slot, ID3D11Buffer* pBuffer)
+{
+	if (slot >= m_pBuffers.size() || !m_pBuffers[slot] || m_pExternalBuffers[slot] == pBuffer) { return; }
+	m_pExternalBuffers[slot] = pBuffer;
+	if (m_pBindShader[m_kind] == this)
+		BindBuffer(slot);
+}
+bool Shader::HasBuffer(UINT slot, const char* pName) const
+{
+	return slot < m_bufferNames.size() && m_pBuffers[slot] && m_bufferNames[slot] == pName;
 }
 void Shader::SetTexture(UINT slot, Texture* tex)
 {
+	if (!tex) { tex = m_pDefaultTexture; }
 	if (!tex || slot >= m_pTextures.size()) { return; }
+	m_pTextures[slot] = tex;
 	ID3D11ShaderResourceView* pTex = tex->GetResource();
-	m_pTextures[slot] = pTex;
 	switch (m_kind)
 	{
 	case Vertex:	GetContext()->VSSetShaderResources(slot, 1, &pTex); break;
@@ -86,30 +258,190 @@ void Shader::SetTexture(UINT slot, Texture* tex)
 	}
 }
 
+void Shader::SetDefaultTexture(Texture* tex)
+{
+	m_pDefaultTexture = tex;
+}
+Texture* Shader::GetDefaultTexture()
+{
+	return m_pDefaultTexture;
+}
+
+void Shader::BindBuffers()
+{
+	m_pBindShader[m_kind] = this;
+	for (UINT i = 0; i < m_pBuffers.size(); ++i)
+	{
+		if (m_pBuffers[i])
+			BindBuffer(i);
+	}
+}
+void Shader::BindBuffer(UINT slot)
+{
+	RenderContext* pContext = GetContext();
+	if (m_pExternalBuffers[slot])
+	{
+		switch (m_kind)
+		{
+		case Vertex:	pContext->VSSetConstantBuffers(slot, 1, &m_pExternalBuffers[slot]); break;
+		case Pixel:		pContext->PSSetConstantBuffers(slot, 1, &m_pExternalBuffers[slot]); break;
+		}
+		return;
+	}
+
+	// OmۂĂ΁A珑ݒ
+	// L^̃Xbhł͑̃XbhQƂ鏑݈ʒuύXA̐ݒ݂̂Ŏgʒu֏
+	// (mۂ͋L^̊JnOOnRingDiscardŏݒ߁Aʏ͋L^ɌÂȂ邱Ƃ͂Ȃ
+	ConstantBufferRing::Block block = m_blocks[slot];
+	bool useRing = block.pBuffer != nullptr;
+	if (useRing && !ConstantBufferRing::IsValid(block))
+	{
+		bool isRecording = IsRecordingThread();
+		if (ConstantBufferRing::Write(m_bufferData[slot].data(), m_bufferSizes[slot], &block))
+		{
+			if (!isRecording)
+				m_blocks[slot] = block;
+		}
+		else
+		{
+			if (!isRecording)
+				m_blocks[slot].pBuffer = nullptr;
+			useRing = false;
+			pContext->UpdateSubresource(m_pBuffers[slot], 0, nullptr, m_bufferData[slot].data(), 0, 0);
+			ConstantBufferRing::AddFallback(m_bufferSizes[slot]);
+		}
+	}
+
+	if (useRing)
+	{
+		switch (m_kind)
+		{
+		case Vertex:	pContext->VSSetConstantBuffers1(slot, 1, &block.pBuffer, &block.firstConstant, &block.numConstants); break;
+		case Pixel:		pContext->PSSetConstantBuffers1(slot, 1, &block.pBuffer, &block.firstConstant, &block.numConstants); break;
+		}
+	}
+	else
+	{
+		switch (m_kind)
+		{
+		case Vertex:	pContext->VSSetConstantBuffers(slot, 1, &m_pBuffers[slot]); break;
+		case Pixel:		pContext->PSSetConstantBuffers(slot, 1, &m_pBuffers[slot]); break;
+		}
+	}
+}
+
+void Shader::OnRingDiscard()
+{
+	for (size_t i = 0; i < m_shaders.size(); ++i)
+	{
+		Shader* pShader = m_shaders[i];
+		for (UINT slot = 0; slot < pShader->m_blocks.size(); ++slot)
+		{
+			ConstantBufferRing::Block& block = pShader->m_blocks[slot];
+			if (!block.pBuffer || ConstantBufferRing::IsValid(block)) { continue; }
+			if (!ConstantBufferRing::Write(pShader->m_bufferData[slot].data(), pShader->m_bufferSizes[slot], &block))
+			{
+				block.pBuffer = nullptr;
+				GetContext()->UpdateSubresource(pShader->m_pBuffers[slot], 0, nullptr, pShader->m_bufferData[slot].data(), 0, 0);
+				ConstantBufferRing::AddFallback(pShader->m_bufferSizes[slot]);
+			}
+			// ݒ蒆łΏݒʒuݒ肵
+			if (m_pBindShader[pShader->m_kind] == pShader && !pShader->m_pExternalBuffers[slot])
+				pShader->BindBuffer(slot);
+		}
+	}
+}
+
+void Shader::OnTextureRelease(Texture* pTexture)
+{
+	if (m_pDefaultTexture == pTexture)
+		m_pDefaultTexture = nullptr;
+	for (size_t i = 0; i < m_shaders.size(); ++i)
+	{
+		std::vector<Texture*>& textures = m_shaders[i]->m_pTextures;
+		for (size_t slot = 0; slot < textures.size(); ++slot)
+		{
+			if (textures[slot] == pTexture)
+				textures[slot] = m_pDefaultTexture;
+		}
+	}
+}
+
 HRESULT Shader::Make(void* pData, UINT size)
+{
+	HRESULT hr = Reflect(pData, size);
+	if (FAILED(hr)) { return hr; }
+	return Create(pData, size);
+}
+HRESULT Shader::Reflect(const void* pData, UINT size)
 {
 	HRESULT hr;
-	ID3D11Device* pDevice = GetDevice();
 
 	// ͗p̃tNV쐬
 	ID3D11ShaderReflection* pReflection;
 	hr = D3DReflect(pData, size, IID_PPV_ARGS(&pReflection));
 	if (FAILED(hr)) { return hr; }
 
-	// 萔obt@쐬
+	// 萔obt@̃WX^ԍƑ傫擾(L̂̂͏
 	D3D11_SHADER_DESC shaderDesc;
 	pReflection->GetDesc(&shaderDesc);
-	m_pBuffers.resize(shaderDesc.ConstantBuffers, nullptr);
+	std::vector<UINT> bindPoints(shaderDesc.ConstantBuffers);
+	std::vector<UINT> sizes(shaderDesc.ConstantBuffers);
+	std::vector<std::string> names(shaderDesc.ConstantBuffers);
+	UINT slotNum = 0;
 	for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i)
 	{
-		// VF[_[̒萔obt@̏擾
 		D3D11_SHADER_BUFFER_DESC shaderBufDesc;
-		ID3D11ShaderReflectionConstantBuffer* cbuf = pReflection->GetConstantBufferByIndex(i);
-		cbuf->GetDesc(&shaderBufDesc);
+		D3D11_SHADER_INPUT_BIND_DESC bindDesc;
+		pReflection->GetConstantBufferByIndex(i)->GetDesc(&shaderBufDesc);
+		pReflection->GetResourceBindingDescByName(shaderBufDesc.Name, &bindDesc);
+		bindPoints[i] = bindDesc.BindPoint;
+		sizes[i] = shaderBufDesc.Size;
+		names[i] = shaderBufDesc.Name;
+		if (bindDesc.BindPoint < SHARED_SLOT && slotNum <= bindDesc.BindPoint)
+			slotNum = bindDesc.BindPoint + 1;
+	}
+
+	// 萔obt@̈(obt@̂Createō쐬
+	m_pBuffers.assign(slotNum, nullptr);
+	m_bufferSizes.assign(slotNum, 0);
+	m_bufferNames.assign(slotNum, std::string());
+	m_pExternalBuffers.assign(slotNum, nullptr);
+	m_blocks.assign(slotNum, ConstantBufferRing::Block());
+	m_bufferData.assign(slotNum, std::vector<char>());
+	for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i)
+	{
+		UINT slot = bindPoints[i];
+		if (slot >= SHARED_SLOT) { continue; }
+		m_bufferSizes[slot] = sizes[i];
+		m_bufferNames[slot] = names[i];
+		m_bufferData[slot].resize(sizes[i], 0);
+	}
+	// eNX`̈쐬
+	m_pTextures.assign(shaderDesc.TextureNormalInstructions, nullptr);
+
+	// ޕʂ̉
+	hr = ReflectShader(pReflection);
+	pReflection->Release();
+	return hr;
+}
+HRESULT Shader::ReflectShader(ID3D11ShaderReflection* pReflection)
+{
+	return S_OK;
+}
+HRESULT Shader::Create(void* pData, UINT size)
+{
+	HRESULT hr;
+	ID3D11Device* pDevice = GetDevice();
+
+	// 萔obt@쐬
+	for (UINT i = 0; i < m_bufferSizes.size(); ++i)
+	{
+		if (m_bufferSizes[i] == 0) { continue; }
 
 		// 쐬obt@̏
 		D3D11_BUFFER_DESC bufDesc = {};
-		bufDesc.ByteWidth = shaderBufDesc.Size;
+		bufDesc.ByteWidth = m_bufferSizes[i];
 		bufDesc.Usage = D3D11_USAGE_DEFAULT;
 		bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
 
@@ -117,47 +449,53 @@ HRESULT Shader::Make(void* pData, UINT size)
 		hr = pDevice->CreateBuffer(&bufDesc, nullptr, &m_pBuffers[i]);
 		if (FAILED(hr)) { return hr; }
 	}
-	// eNX`̈쐬
-	m_pTextures.resize(shaderDesc.TextureNormalInstructions, nullptr);
 
 	return MakeShader(pData, size);
 }
 
 //----------
 // _VF[_
+VertexShader::LayoutCache VertexShader::m_layoutCache;
+
 VertexShader::VertexShader()
 	: Shader(Shader::Vertex)
 	, m_pVS(nullptr)
 	, m_pInputLayout(nullptr)
+	, m_layoutKey(0)
 {
 }
 
 VertexShader::~VertexShader()
 {
-	SAFE_RELEASE(m_pInputLayout);
+	// LĂCvbgCAEg͍Ō̎QƂŉ
+	if (m_pInputLayout)
+	{
+		LayoutCache::iterator it = m_layoutCache.find(m_layoutKey);
+		if (it != m_layoutCache.end() && --it->second.refCount == 0)
+		{
+			SAFE_RELEASE(it->second.pLayout);
+			m_layoutCache.erase(it);
+		}
+		m_pInputLayout = nullptr;
+	}
 	SAFE_RELEASE(m_pVS);
 }
 
 void VertexShader::Bind(void)
 {
-	ID3D11DeviceContext* pContext =	GetContext();
+	RenderContext* pContext =	GetContext();
 	pContext->VSSetShader(m_pVS, NULL, 0);
 	pContext->IASetInputLayout(m_pInputLayout);
-	for (int i = 0; i < m_pBuffers.size(); ++i)
-		pContext->VSSetConstantBuffers(i, 1, &m_pBuffers[i]);
-	for (int i = 0; i < m_pTextures.size(); ++i)
-		pContext->VSSetShaderResources(i, 1, &m_pTextures[i]);
+	BindBuffers();
+	for (UINT i = 0; i < m_pTextures.size(); ++i)
+	{
+		ID3D11ShaderResourceView* pSRV = m_pTextures[i] ? m_pTextures[i]->GetResource() : nullptr;
+		pContext->VSSetShaderResources(i, 1, &pSRV);
+	}
 }
 
-HRESULT VertexShader::MakeShader(void* pData, UINT size)
+HRESULT VertexShader::ReflectShader(ID3D11ShaderReflection* pReflection)
 {
-	HRESULT hr;
-	ID3D11Device* pDevice = GetDevice();
-	
-	// VF[_[쐬
-	hr = pDevice->CreateVertexShader(pData, size, NULL, &m_pVS);
-	if(FAILED(hr)) { return hr; }
-
 	/*
 	VF[_쐬ɃVF[_tNVʂăCvbgCAEg擾
 	Z}eBNX̔zuȂǂ环ʎq쐬
@@ -165,9 +503,7 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 	https://blog.techlab-xe.net/dxc-shader-reflection/
 	*/
 
-	ID3D11ShaderReflection *pReflection;
 	D3D11_SHADER_DESC shaderDesc;
-	D3D11_INPUT_ELEMENT_DESC* pInputDesc;
 	D3D11_SIGNATURE_PARAMETER_DESC sigDesc;
 
 	DXGI_FORMAT formats[][4] =
@@ -190,16 +526,17 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 		},
 	};
 
-	hr = D3DReflect(pData, size, IID_PPV_ARGS(&pReflection));
-	if (FAILED(hr)) { return hr; }
-
 	pReflection->GetDesc(&shaderDesc);
-	pInputDesc = new D3D11_INPUT_ELEMENT_DESC[shaderDesc.InputParameters];
+	m_inputDesc.resize(shaderDesc.InputParameters);
+	m_semantics.resize(shaderDesc.InputParameters);
+	UINT offsets[2] = { 0, 0 };	// XbgƂ̔zuʒu
 	for(UINT i = 0; i < shaderDesc.InputParameters; ++ i)
 	{
 		pReflection->GetInputParameterDesc(i, &sigDesc);
-		pInputDesc[i].SemanticName = sigDesc.SemanticName;
-		pInputDesc[i].SemanticIndex = sigDesc.SemanticIndex;
+		// Z}eBNX̓tNV̉gߕ
+		m_semantics[i] = sigDesc.SemanticName;
+		m_inputDesc[i].SemanticName = nullptr;
+		m_inputDesc[i].SemanticIndex = sigDesc.SemanticIndex;
 
 		// http://marupeke296.com/TIPS_No17_Bit.html
 		BYTE elementCount = sigDesc.Mask;
@@ -209,30 +546,82 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 		switch (sigDesc.ComponentType)
 		{
 			case D3D_REGISTER_COMPONENT_UINT32:
-				pInputDesc[i].Format = formats[0][elementCount - 1];
+				m_inputDesc[i].Format = formats[0][elementCount - 1];
 				break;
 			case D3D_REGISTER_COMPONENT_SINT32:
-				pInputDesc[i].Format = formats[1][elementCount - 1];
+				m_inputDesc[i].Format = formats[1][elementCount - 1];
 				break;
 			case D3D_REGISTER_COMPONENT_FLOAT32:
-				pInputDesc[i].Format = formats[2][elementCount - 1];
+				m_inputDesc[i].Format = formats[2][elementCount - 1];
 				break;
 		}
-		pInputDesc[i].InputSlot = 0;
-		pInputDesc[i].AlignedByteOffset = i == 0 ? 0 : D3D11_APPEND_ALIGNED_ELEMENT;
-		pInputDesc[i].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-		pInputDesc[i].InstanceDataStepRate = 0;
+		// INSTANCEn܂Z}eBNX̓CX^XƂ̃f[^ƂăXbg1ǂݍ
+		if (strncmp(sigDesc.SemanticName, "INSTANCE", 8) == 0)
+		{
+			m_inputDesc[i].InputSlot = 1;
+			m_inputDesc[i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+			m_inputDesc[i].InstanceDataStepRate = 1;
+		}
+		else
+		{
+			m_inputDesc[i].InputSlot = 0;
+			m_inputDesc[i].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+			m_inputDesc[i].InstanceDataStepRate = 0;
+		}
+		m_inputDesc[i].AlignedByteOffset = offsets[m_inputDesc[i].InputSlot];
+		offsets[m_inputDesc[i].InputSlot] += elementCount * 4;
+	}
+	return S_OK;
+}
+
+HRESULT VertexShader::MakeShader(void* pData, UINT size)
+{
+	HRESULT hr;
+	ID3D11Device* pDevice = GetDevice();
+	
+	// VF[_[쐬
+	hr = pDevice->CreateVertexShader(pData, size, NULL, &m_pVS);
+	if(FAILED(hr)) { return hr; }
+
+	// vf̕т环ʎq쐬
+	uint64_t key = HASH_BASIS;
+	for (UINT i = 0; i < m_inputDesc.size(); ++i)
+	{
+		D3D11_INPUT_ELEMENT_DESC desc = m_inputDesc[i];
+		desc.SemanticName = nullptr;	// AhXł͂ȂOr
+		key = AddHash(key, m_semantics[i].c_str(), m_semantics[i].size());
+		key = AddHash(key, &desc, sizeof(desc));
+	}
+
+	// o^ς݂ł΍ėp
+	LayoutCache::iterator it = m_layoutCache.find(key);
+	if (it != m_layoutCache.end())
+	{
+		m_pInputLayout = it->second.pLayout;
+		++it->second.refCount;
+		m_layoutKey = key;
+		return S_OK;
 	}
 
+	// VK쐬
+	for (UINT i = 0; i < m_inputDesc.size(); ++i)
+		m_inputDesc[i].SemanticName = m_semantics[i].c_str();
 	hr = pDevice->CreateInputLayout(
-		pInputDesc, shaderDesc.InputParameters,
+		m_inputDesc.data(), static_cast<UINT>(m_inputDesc.size()),
 		pData, size, &m_pInputLayout
 	);
-	
-	delete[] pInputDesc;
+	if (FAILED(hr)) { return hr; }
+	LayoutEntry entry = { m_pInputLayout, 1 };
+	m_layoutCache.insert(LayoutCache::value_type(key, entry));
+	m_layoutKey = key;
 	return hr;
 }
 
+UINT VertexShader::GetLayoutNum()
+{
+	return static_cast<UINT>(m_layoutCache.size());
+}
+
 //----------
 // sNZVF[_
 PixelShader::PixelShader()
@@ -246,12 +635,14 @@ PixelShader::~PixelShader()
 }
 void PixelShader::Bind(void)
 {
-	ID3D11DeviceContext* pContext = GetContext();
+	RenderContext* pContext = GetContext();
 	pContext->PSSetShader(m_pPS, nullptr, 0);
-	for (int i = 0; i < m_pBuffers.size(); ++i)
-		pContext->PSSetConstantBuffers(i, 1, &m_pBuffers[i]);
-	for (int i = 0; i < m_pTextures.size(); ++i)
-		pContext->PSSetShaderResources(i, 1, &m_pTextures[i]);
+	BindBuffers();
+	for (UINT i = 0; i < m_pTextures.size(); ++i)
+	{
+		ID3D11ShaderResourceView* pSRV = m_pTextures[i] ? m_pTextures[i]->GetResource() : nullptr;
+		pContext->PSSetShaderResources(i, 1, &pSRV);
+	}
 }
 HRESULT PixelShader::MakeShader(void* pData, UINT size)
 {
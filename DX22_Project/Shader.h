@@ -2,10 +2,13 @@
 #define __SHADER_H__
 
 #include "DirectX.h"
+#include <d3d11shader.h>
 #include "Texture.h"
+#include "ConstantBufferRing.h"
 #include <string>
 #include <map>
 #include <vector>
+#include <future>
 
 // VF[_[̊{NX
 class Shader
@@ -20,31 +23,81 @@ protected:
 	Shader(Kind kind);
 public:
 	virtual ~Shader();
+public:
+	// ̃WX^ԍȍ~̒萔obt@̓GWŋL(VF[_[Ƃɍ쐬Aݒ肵Ȃ
+	static const UINT SHARED_SLOT = 8;
 public:
 	// VF[_[t@C(*.cso)ǂݍޏ
 	HRESULT Load(const char* pFileName);
 	// 񂩂VF[_RpC
-	HRESULT Compile(const char* pCode);
+	// RpCʂ̓\[XA}NA^[QbgAtÕnbVl𖼑OƂSHADER_CACHE_DIR֕ۑA
+	// ȍ~̓RpCɓǂݍ
+	HRESULT Compile(const char* pCode, const D3D_SHADER_MACRO* pDefines = nullptr);
+	// RpCƉ݂͂̂ʃXbhŊJn(pCodeWaitCompile܂ŕێĂ
+	void CompileAsync(const char* pCode, const D3D_SHADER_MACRO* pDefines = nullptr);
+	// CompileAsync̊҂ăVF[_[쐬(foCXgp邽ߕ`XbhŌĂяo
+	HRESULT WaitCompile();
 
 
-	// 萔̏
+	// 萔̏(slot̓WX^ԍ
+	// Ogꍇ̓O֏݁Aʒuw肵Đݒ肷
 	void WriteBuffer(UINT slot, void* pData);
-	// eNX`̐ݒ
+	// Oō쐬萔obt@̐ݒ(WriteBufferĂԂ܂ŎgpA͍쐬ōs
+	void SetBuffer(UINT slot, ID3D11Buffer* pBuffer);
+	// w̖O̒萔obt@slotɐ錾Ă邩(ݒ̔zu̔
+	bool HasBuffer(UINT slot, const char* pName) const;
+	// eNX`̐ݒ(nullptȑꍇ͊̃eNX`ݒ
 	void SetTexture(UINT slot, Texture* tex);
+	// eNX`ݒ莞ɎgpeNX`
+	static void SetDefaultTexture(Texture* tex);
+	static Texture* GetDefaultTexture();
 	// VF[_[`Ɏgp
 	virtual void Bind(void) = 0;
+	// ĂяoXbhŕ`ɐݒ蒆
+	bool IsBound() const;
+	// ʔԍ(`̕ёւɎgp
+	UINT GetID() const;
 
 private:
+	static HRESULT CompileBytecode(const char* pCode, const D3D_SHADER_MACRO* pDefines, Kind kind, bool useCache, std::vector<char>* pOut);
+	// RpCƉ(foCXgpȂ
+	HRESULT Prepare(const char* pCode, const D3D_SHADER_MACRO* pDefines);
+	HRESULT Reflect(const void* pData, UINT size);
+	// ͌ʂƂɃfoCX̃IuWFNg쐬
+	HRESULT Create(void* pData, UINT size);
 	HRESULT Make(void* pData, UINT size);
 protected:
 	// VF[_[t@Cǂݍ񂾌AVF[_[̎ޕʂɏs
 	virtual HRESULT MakeShader(void* pData, UINT size) = 0;
+	// ޕʂ̉(ReflectĂ΂AfoCX͎gpȂ
+	virtual HRESULT ReflectShader(ID3D11ShaderReflection* pReflection);
+	// 萔obt@̐ݒ
+	void BindBuffers();
+private:
+	void BindBuffer(UINT slot);
+	// OmۂۂɁASVF[_[̒萔`Xbhŏݒ
+	// ([J[Xbhł̋L^ɊeVF[_[݈̏ʒuύXȂ悤AL^̊JnOɍς܂Ă
+	static void OnRingDiscard();
+	// jeNX`SVF[_[O(̃eNX`ɖ߂
+	static void OnTextureRelease(Texture* pTexture);
 
 private:
+	static UINT m_idCount;
+	static std::vector<Shader*> m_shaders;	// 쐬ς݂̃VF[_[(Ȍݒp
+	static thread_local Shader* m_pBindShader[2];	// ނƂ̐ݒ蒆̃VF[_[(s悪XbhƂɈقȂ邽
+	static Texture* m_pDefaultTexture;
 	Kind m_kind;
+	UINT m_id;
+	std::future<HRESULT> m_compile;	// CompileAsync̏
+	std::vector<char> m_bytecode;	// RpCA쐬܂ł̊Ԃ̂ݕێ
 protected:
 	std::vector<ID3D11Buffer*> m_pBuffers;
-	std::vector<ID3D11ShaderResourceView*> m_pTextures;
+	std::vector<ID3D11Buffer*> m_pExternalBuffers;	// SetBufferŐݒ肳ꂽobt@
+	std::vector<UINT> m_bufferSizes;
+	std::vector<std::string> m_bufferNames;	// VF[_[̒萔obt@
+	std::vector<ConstantBufferRing::Block> m_blocks;	// O֏񂾈ʒu
+	std::vector<std::vector<char>> m_bufferData;		// Omۂۂɏݒ߂̕
+	std::vector<Texture*> m_pTextures;	// ݒ莞ł͂ȂBindSRV擾(iKIȓǂݍ݂ōւ邽
 };
 
 //----------
@@ -55,12 +108,27 @@ public:
 	VertexShader();
 	~VertexShader();
 	void Bind(void);
+	// 쐬ς݂̃CvbgCAEg(͂̃VF[_[͈L
+	static UINT GetLayoutNum();
 protected:
+	HRESULT ReflectShader(ID3D11ShaderReflection* pReflection);
 	HRESULT MakeShader(void* pData, UINT size);
 
 private:
+	// ͗vf̕тL[ƂCvbgCAEg̋L
+	struct LayoutEntry
+	{
+		ID3D11InputLayout* pLayout;
+		UINT refCount;
+	};
+	using LayoutCache = std::map<uint64_t, LayoutEntry>;
+	static LayoutCache m_layoutCache;
+
 	ID3D11VertexShader* m_pVS;
 	ID3D11InputLayout* m_pInputLayout;
+	uint64_t m_layoutKey;
+	std::vector<D3D11_INPUT_ELEMENT_DESC> m_inputDesc;
+	std::vector<std::string> m_semantics;
 };
 //----------
 // sNZVF[_
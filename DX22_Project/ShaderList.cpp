@@ -1,176 +1,95 @@
 #include "ShaderList.h"
+#include <string.h>
 
 
-VertexShader* ShaderList::m_pVS[VS_KIND_MAX];
-PixelShader* ShaderList::m_pPS[PS_KIND_MAX];
+std::map<UINT, VertexShader*> ShaderList::m_vsVariants;
+std::map<UINT, PixelShader*> ShaderList::m_psVariants;
+ID3D11Buffer* ShaderList::m_pShared[SHARED_NUM];
+thread_local DirectX::XMFLOAT4X4 ShaderList::m_world;
+thread_local ConstantBufferRing::Block ShaderList::m_objectBlock;
+ShaderList::ViewParam ShaderList::m_view;
+Model::Material ShaderList::m_material;
+UINT ShaderList::m_materialVersion = 0;
+ShaderList::MaterialPS* ShaderList::m_pBindPS = nullptr;
+Texture* ShaderList::m_pWhite;
 
-
-ShaderList::ShaderList()
-{
-}
-ShaderList::~ShaderList()
-{
-}
-
-void ShaderList::Init()
-{
-	MakeWorldVS();
-	MakeAnimeVS();
-	MakeLambertPS();
-	MakeSpecularPS();
-	MakeToonPS();
-	MakeFogPS();
-
-	DirectX::XMFLOAT4X4 mat[250];
-	for (int i = 0; i < 250; ++i)
-	{
-		DirectX::XMStoreFloat4x4(&mat[i], DirectX::XMMatrixIdentity());
-	}
-	SetWVP(mat);
-	SetBones(mat);
-
-	Model::Material material = {
-		DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
-		DirectX::XMFLOAT4(0.3f, 0.3f, 0.3f, 1.0f),
-		DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
-		nullptr
-	};
-	SetMaterial(material);
-	SetLight(DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), DirectX::XMFLOAT3(-1.0f, -1.0f, -1.0f));
-	SetCameraPos(DirectX::XMFLOAT3(0.0f, 1.0f, -2.0f));
-	SetFog(DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 50.0f, 50.0f);
-}
-
-void ShaderList::Uninit()
+// SetMaterial̓e͑SĂ̑gݍ킹֏܂Aݒ蒆̃VF[_[Ǝɐݒ肵VF[_[ɂ̂ݔf
+// L^̃Xbhł͋L̃VF[_[ύXȂ(`L[̓eNX`ƃ}eA𒼐ڐݒ肷
+class ShaderList::MaterialPS : public PixelShader
 {
-	for (int i = 0; i < VS_KIND_MAX; ++i)
+public:
+	MaterialPS() : m_version(0) {}
+	void Bind(void)
 	{
-		if (m_pVS[i])
-		{
-			delete m_pVS[i];
-			m_pVS[i] = nullptr;
-		}
+		PixelShader::Bind();
+		if (IsRecordingThread()) { return; }
+		m_pBindPS = this;
+		ApplyMaterial();
 	}
-	for (int i = 0; i < PS_KIND_MAX; ++i)
+	void ApplyMaterial()
 	{
-		if (m_pPS[i])
+		if (m_version == m_materialVersion) { return; }
+		m_version = m_materialVersion;
+
+		SetTexture(0, m_material.pTexture);
+		// 쐬ς݂̒萔obt@΍ւ̂
+		if (m_material.pBuffer)
 		{
-			delete m_pPS[i];
-			m_pPS[i] = nullptr;
+			SetBuffer(0, m_material.pBuffer);
+			return;
 		}
+		DirectX::XMFLOAT4 param[3] = {
+			m_material.diffuse,
+			m_material.ambient,
+			m_material.specular
+		};
+		WriteBuffer(0, param);
 	}
-}
-
-VertexShader* ShaderList::GetVS(VSKind vs)
-{
-	return m_pVS[vs];
-}
-PixelShader* ShaderList::GetPS(PSKind ps)
-{
-	return m_pPS[ps];
-}
-
-void ShaderList::SetWVP(DirectX::XMFLOAT4X4* wvp)
-{
-	for (int i = 0; i < VS_KIND_MAX; ++i)
-	{
-		m_pVS[i]->WriteBuffer(0, wvp);
-	}
-}
-void ShaderList::SetBones(DirectX::XMFLOAT4X4* bones200)
-{
-	m_pVS[VS_ANIME]->WriteBuffer(1, bones200);
-}
-void ShaderList::SetMaterial(const Model::Material& material)
-{
-	DirectX::XMFLOAT4 param[3] = {
-		material.diffuse,
-		material.ambient,
-		material.specular
-	};
-	param[1].w = material.pTexture ? 1.0f : 0.0f;
-	for (int i = 0; i < PS_KIND_MAX; ++i)
-	{
-		m_pPS[i]->SetTexture(0, material.pTexture);
-		m_pPS[i]->WriteBuffer(0, param);
-	}
-}
-void ShaderList::SetLight(DirectX::XMFLOAT4 color, DirectX::XMFLOAT3 dir)
-{
-	DirectX::XMFLOAT4 param[2] = {
-		color
-	};
-	DirectX::XMStoreFloat4(&param[1], DirectX::XMVector3Normalize(
-		DirectX::XMVectorSet(dir.x, dir.y, dir.z, 0.0f)
-	));
-	for (int i = 0; i < PS_KIND_MAX; ++i)
-	{
-		m_pPS[i]->WriteBuffer(1, param);
-	}
-}
-void ShaderList::SetCameraPos(const DirectX::XMFLOAT3 pos)
-{
-	DirectX::XMFLOAT4 param[] = {
-		{pos.x, pos.y, pos.z, 0.0f}
-	};
-	m_pPS[PS_SPECULAR]->WriteBuffer(2, param);
-	m_pPS[PS_TOON]->WriteBuffer(2, param);
-}
-void ShaderList::SetFog(DirectX::XMFLOAT4 color, float start, float range)
-{
-	DirectX::XMFLOAT4 param[] = {
-		color,
-		{start, range, 0.0f, 0.0f}
-	};
-	m_pPS[PS_FOG]->WriteBuffer(3, param);
-}
+private:
+	UINT m_version;	// fς݂SetMaterial̔ԍ
+};
 
-void ShaderList::MakeWorldVS()
-{
-	const char* code = R"EOT(
-struct VS_IN {
-	float3 pos : POSITION;
-	float3 normal : NORMAL0;
-	float2 uv : TEXCOORD0;
-	float4 color : COLOR0;
+// ]̎ނɑΉ@\̑gݍ킹
+const UINT ShaderList::VS_KIND_FEATURES[VS_KIND_MAX] = {
+	0,						// VS_WORLD
+	FEATURE_SKINNING,		// VS_ANIME
+	FEATURE_INSTANCING,		// VS_WORLD_INSTANCED
 };
-struct VS_OUT {
-	float4 pos : SV_POSITION;
-	float3 normal : NORMAL0;
-	float2 uv : TEXCOORD0;
-	float4 color : COLOR0;
-	float4 wPos : POSITION0;
+const UINT ShaderList::PS_KIND_FEATURES[PS_KIND_MAX] = {
+	FEATURE_TEXTURE,						// PS_LAMBERT
+	FEATURE_TEXTURE | FEATURE_SPECULAR,		// PS_SPECULAR
+	FEATURE_TEXTURE | FEATURE_TOON,			// PS_TOON
+	FEATURE_TEXTURE | FEATURE_FOG,			// PS_FOG
 };
-cbuffer WVP : register(b0) {
-	float4x4 world;
-	float4x4 view;
-	float4x4 proj;
+
+// @\ɑΉ}N
+static const char* FEATURE_NAMES[] = {
+	"SKINNING",
+	"INSTANCING",
+	"TEXTURE",
+	"SPECULAR",
+	"TOON",
+	"FOG",
 };
-VS_OUT main(VS_IN vin) {
-	VS_OUT vout;
-	vout.pos = float4(vin.pos, 1.0f);
-	vout.pos = mul(vout.pos, world);
-	vout.wPos = vout.pos;
-	vout.pos = mul(vout.pos, view);
-	vout.pos = mul(vout.pos, proj);
-	vout.normal = mul(vin.normal, (float3x3)world);
-	vout.uv = vin.uv;
-	vout.color = vin.color;
-	return vout;
-})EOT";
-	m_pVS[VS_WORLD] = new VertexShader();
-	m_pVS[VS_WORLD]->Compile(code);
-}
-void ShaderList::MakeAnimeVS()
-{
-	const char* code = R"EOT(
+
+// _VF[_[(S@\ʂ̃\[X
+static const char* VS_CODE = R"EOT(
 struct VS_IN {
 	float3 pos : POSITION;
 	float3 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 	float4 color : COLOR0;
+#if SKINNING
 	float4 weight : WEIGHT0;
 	uint4 index : INDEX0;
+#endif
+#if INSTANCING
+	float4 world0 : INSTANCE0;
+	float4 world1 : INSTANCE1;
+	float4 world2 : INSTANCE2;
+	float4 world3 : INSTANCE3;
+	float4 tint : INSTANCE4;
+#endif
 };
 struct VS_OUT {
 	float4 pos : SV_POSITION;
@@ -179,45 +98,58 @@ struct VS_OUT {
 	float4 color : COLOR0;
 	float4 wPos : POSITION0;
 };
-cbuffer WVP : register(b0) {
+cbuffer Object : register(b8) {
 	float4x4 world;
+};
+cbuffer View : register(b9) {
 	float4x4 view;
 	float4x4 proj;
+	float4 cameraPos;
 };
-cbuffer Bone : register(b1) {
+#if SKINNING
+cbuffer Bone : register(b0) {
 	float4x4 bone[200];
 };
+#endif
 VS_OUT main(VS_IN vin) {
 	VS_OUT vout;
+#if INSTANCING
+	float4x4 mWorld = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+#else
+	float4x4 mWorld = world;
+#endif
+	vout.pos = float4(vin.pos, 1.0f);
+	vout.normal = vin.normal;
+#if SKINNING
 	float4x4 anime;
 	anime  = bone[vin.index.x] * vin.weight.x;
 	anime += bone[vin.index.y] * vin.weight.y;
 	anime += bone[vin.index.z] * vin.weight.z;
 	anime += bone[vin.index.w] * vin.weight.w;
-	vout.pos = float4(vin.pos, 1.0f);
 	vout.pos = mul(vout.pos, anime);
-	vout.pos = mul(vout.pos, world);
+	vout.normal = mul(vout.normal, (float3x3)anime);
+#endif
+	vout.pos = mul(vout.pos, mWorld);
 	vout.wPos = vout.pos;
 	vout.pos = mul(vout.pos, view);
 	vout.pos = mul(vout.pos, proj);
-	vout.normal = vin.normal;
-	vout.normal = mul(vout.normal, (float3x3)anime);
-	vout.normal = mul(vout.normal, (float3x3)world);
+	vout.normal = mul(vout.normal, (float3x3)mWorld);
 	vout.uv = vin.uv;
 	vout.color = vin.color;
+#if INSTANCING
+	vout.color *= vin.tint;
+#endif
 	return vout;
 })EOT";
-	m_pVS[VS_ANIME] = new VertexShader();
-	m_pVS[VS_ANIME]->Compile(code);
-}
-void ShaderList::MakeLambertPS()
-{
-	const char* code = R"EOT(
+
+// sNZVF[_[(S@\ʂ̃\[X
+static const char* PS_CODE = R"EOT(
 struct PS_IN {
 	float4 pos : SV_POSITION;
 	float3 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 	float4 color : COLOR0;
+	float4 wPos : POSITION0;
 };
 cbuffer Material : register(b0)
 {
@@ -225,170 +157,326 @@ cbuffer Material : register(b0)
 	float4 objAmbient;
 	float4 objSpecular;
 };
-cbuffer Light : register(b1)
+cbuffer View : register(b9)
+{
+	float4x4 view;
+	float4x4 proj;
+	float4 cameraPos;
+};
+cbuffer Light : register(b10)
 {
 	float4 lightDiffuse;
 	float4 lightDir;
 };
+cbuffer Fog : register(b11)
+{
+	float4 fogColor;
+	float fogStart;
+	float fogRange;
+	float2 dummy;
+};
 Texture2D tex : register(t0);
 SamplerState samp : register(s0);
 float4 main(PS_IN pin) : SV_TARGET
 {
 	float4 color = float4(1.0f, 1.0f, 1.0f, 1.0f);
-	if(objAmbient.a >= 1.0f)
-		color = tex.Sample(samp, pin.uv);
+#if TEXTURE
+	color = tex.Sample(samp, pin.uv);
+#endif
 	float3 N = normalize(pin.normal);
-	float3 L = normalize(-lightDir);
+	float3 L = normalize(-lightDir.xyz);
 	float dotNL = saturate((dot(N, L) + 0.5f) / 1.5f);
+#if TOON
+	float rawNL = dot(N, L); // }CiXŌvZ
+	float lightNL = saturate((rawNL + 0.5f) / 1.5f * 100.0f); // A̋ڂ_炩
+#else
+	float lightNL = dotNL;
+#endif
 	float3 diffuse = objDiffuse.rgb * lightDiffuse.rgb;
 	float3 ambient = objAmbient.rgb * lightDiffuse.rgb;
 	float3 specular = objSpecular.rgb * lightDiffuse.rgb;
-	color.rgb *= saturate(diffuse * dotNL + ambient);
-	color.rgb += specular * pow(saturate(dotNL), max(0.01f, objSpecular.a));
+	color.rgb *= saturate(diffuse * lightNL + ambient);
+#if SPECULAR
+	float3 V = normalize(cameraPos.xyz - pin.wPos.xyz);
+	float3 R = reflect(-V, N);
+	float dotRL = saturate(dot(R, L));
+	color.rgb += specular * saturate(pow(dotRL, max(0.01f, objSpecular.a)));
+#elif TOON
+	if(objSpecular.a >= 1.0f)
+		color.rgb += specular * saturate(pow(rawNL, max(0.01f, objSpecular.a)));
+#elif !FOG
+	color.rgb += specular * pow(dotNL, max(0.01f, objSpecular.a));
+#endif
+#if FOG
+	float vLen = length(pin.wPos.xyz - cameraPos.xyz);
+	color.rgb = lerp(color.rgb, fogColor.rgb, saturate((vLen - fogStart) / fogRange));
+#endif
 	return color;
 })EOT";
-	m_pPS[PS_LAMBERT] = new PixelShader();
-	m_pPS[PS_LAMBERT]->Compile(code);
+
+// L̒萔obt@̑傫
+static const UINT SHARED_SIZE[] = {
+	sizeof(DirectX::XMFLOAT4X4),		// SLOT_OBJECT
+	sizeof(DirectX::XMFLOAT4X4) * 2 + sizeof(DirectX::XMFLOAT4),	// SLOT_VIEW
+	sizeof(DirectX::XMFLOAT4) * 2,		// SLOT_LIGHT
+	sizeof(DirectX::XMFLOAT4) * 2,		// SLOT_FOG
+};
+
+
+ShaderList::ShaderList()
+{
 }
-void ShaderList::MakeSpecularPS()
+ShaderList::~ShaderList()
 {
-	const char* code = R"EOT(
-struct PS_IN {
-	float4 pos : SV_POSITION;
-	float3 normal : NORMAL0;
-	float2 uv : TEXCOORD0;
-	float4 color : COLOR0;
-	float4 wPos : POSITION0;
-};
-cbuffer Material : register(b0)
+}
+
+void ShaderList::Init()
 {
-	float4 objDiffuse;
-	float4 objAmbient;
-	float4 objSpecular;
-};
-cbuffer Light : register(b1)
+	// L̒萔obt@
+	for (UINT i = 0; i < SHARED_NUM; ++i)
+	{
+		D3D11_BUFFER_DESC bufDesc = {};
+		bufDesc.ByteWidth = SHARED_SIZE[i];
+		bufDesc.Usage = D3D11_USAGE_DEFAULT;
+		bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		GetDevice()->CreateBuffer(&bufDesc, nullptr, &m_pShared[i]);
+	}
+	m_objectBlock = ConstantBufferRing::Block();
+	BindShared();
+	ConstantBufferRing::AddDiscardCallback(OnRingDiscard);
+	Texture::AddReleaseCallback(OnTextureRelease);
+
+	// eNX`ݒ莞̔
+	const BYTE white[4] = { 255, 255, 255, 255 };
+	m_pWhite = new Texture();
+	m_pWhite->Create(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, white);
+	Shader::SetDefaultTexture(m_pWhite);
+
+	// ]̎ނɑΉgݍ킹͎Oɍ쐬
+	Prebuild(VS_KIND_FEATURES, VS_KIND_MAX, PS_KIND_FEATURES, PS_KIND_MAX);
+
+	DirectX::XMFLOAT4X4 mat[250];
+	for (int i = 0; i < 250; ++i)
+	{
+		DirectX::XMStoreFloat4x4(&mat[i], DirectX::XMMatrixIdentity());
+	}
+	SetWVP(mat);
+	SetBones(mat);
+
+	Model::Material material = {
+		DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
+		DirectX::XMFLOAT4(0.3f, 0.3f, 0.3f, 1.0f),
+		DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
+		nullptr,
+		nullptr
+	};
+	SetMaterial(material);
+	SetLight(DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), DirectX::XMFLOAT3(-1.0f, -1.0f, -1.0f));
+	SetCameraPos(DirectX::XMFLOAT3(0.0f, 1.0f, -2.0f));
+	SetFog(DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 50.0f, 50.0f);
+}
+
+void ShaderList::Uninit()
 {
-	float4 lightDiffuse;
-	float4 lightDir;
-};
-cbuffer Camera : register(b2)
+	for (auto it = m_vsVariants.begin(); it != m_vsVariants.end(); ++it)
+		delete it->second;
+	m_vsVariants.clear();
+	for (auto it = m_psVariants.begin(); it != m_psVariants.end(); ++it)
+		delete it->second;
+	m_psVariants.clear();
+	m_pBindPS = nullptr;
+	ConstantBufferRing::RemoveDiscardCallback(OnRingDiscard);
+	Texture::RemoveReleaseCallback(OnTextureRelease);
+	m_objectBlock = ConstantBufferRing::Block();
+	for (UINT i = 0; i < SHARED_NUM; ++i)
+		SAFE_RELEASE(m_pShared[i]);
+	Shader::SetDefaultTexture(nullptr);
+	SAFE_DELETE(m_pWhite);
+}
+
+VertexShader* ShaderList::GetVS(VSKind vs)
 {
-	float4 cameraPos;
-};
-Texture2D tex : register(t0);
-SamplerState samp : register(s0);
-float4 main(PS_IN pin) : SV_TARGET
+	return GetVS(VS_KIND_FEATURES[vs]);
+}
+PixelShader* ShaderList::GetPS(PSKind ps)
 {
-	float4 color = float4(1.0f, 1.0f, 1.0f, 1.0f);
-	if(objAmbient.a >= 1.0f)
-		color = tex.Sample(samp, pin.uv);
-	float3 N = normalize(pin.normal);
-	float3 L = normalize(-lightDir);
-	float3 V = normalize(cameraPos.xyz - pin.wPos.xyz);
-	float3 R = reflect(-V, N);
-	float dotNL = saturate((dot(N, L) + 0.5f) / 1.5f);
-	float dotRL = saturate(dot(R, L));
-	float3 diffuse = objDiffuse.rgb * lightDiffuse.rgb;
-	float3 ambient = objAmbient.rgb * lightDiffuse.rgb;
-	float3 specular = objSpecular.rgb * lightDiffuse.rgb;
-	color.rgb *= saturate(diffuse * dotNL + ambient);
-	color.rgb += specular * saturate(pow(dotRL, max(0.01f, objSpecular.a)));
-	return color;
-})EOT";
-	m_pPS[PS_SPECULAR] = new PixelShader();
-	m_pPS[PS_SPECULAR]->Compile(code);
+	return GetPS(PS_KIND_FEATURES[ps]);
 }
-void ShaderList::MakeToonPS()
+VertexShader* ShaderList::GetVS(UINT features)
 {
-	const char* code = R"EOT(
-struct PS_IN {
-	float4 pos : SV_POSITION;
-	float3 normal : NORMAL0;
-	float2 uv : TEXCOORD0;
-	float4 color : COLOR0;
-};
-cbuffer Material : register(b0)
+	features &= FEATURE_VS_MASK;
+	auto it = m_vsVariants.find(features);
+	if (it != m_vsVariants.end()) { return it->second; }
+
+	std::vector<D3D_SHADER_MACRO> defines;
+	MakeDefines(features, &defines);
+	VertexShader* pVS = new VertexShader();
+	pVS->Compile(VS_CODE, defines.data());
+	m_vsVariants.insert(std::make_pair(features, pVS));
+	return pVS;
+}
+PixelShader* ShaderList::GetPS(UINT features)
 {
-	float4 objDiffuse;
-	float4 objAmbient;
-	float4 objSpecular;
-};
-cbuffer Light : register(b1)
+	features &= FEATURE_PS_MASK;
+	auto it = m_psVariants.find(features);
+	if (it != m_psVariants.end()) { return it->second; }
+
+	std::vector<D3D_SHADER_MACRO> defines;
+	MakeDefines(features, &defines);
+	PixelShader* pPS = new MaterialPS();
+	pPS->Compile(PS_CODE, defines.data());
+	m_psVariants.insert(std::make_pair(features, pPS));
+	return pPS;
+}
+void ShaderList::Prebuild(const UINT* pVSFeatures, UINT vsNum, const UINT* pPSFeatures, UINT psNum)
 {
-	float4 lightDiffuse;
-	float4 lightDir;
-};
-Texture2D tex : register(t0);
-SamplerState samp : register(s0);
-float4 main(PS_IN pin) : SV_TARGET
+	// 쐬̑gݍ킹̃RpCʃXbhœɍsAfoCXł̍쐬݂̂̃Xbhōs
+	std::vector<Shader*> shaders;
+	std::vector<D3D_SHADER_MACRO> defines;
+	for (UINT i = 0; i < vsNum; ++i)
+	{
+		UINT features = pVSFeatures[i] & FEATURE_VS_MASK;
+		if (m_vsVariants.count(features)) { continue; }
+		MakeDefines(features, &defines);
+		VertexShader* pVS = new VertexShader();
+		pVS->CompileAsync(VS_CODE, defines.data());
+		m_vsVariants.insert(std::make_pair(features, pVS));
+		shaders.push_back(pVS);
+	}
+	for (UINT i = 0; i < psNum; ++i)
+	{
+		UINT features = pPSFeatures[i] & FEATURE_PS_MASK;
+		if (m_psVariants.count(features)) { continue; }
+		MakeDefines(features, &defines);
+		PixelShader* pPS = new MaterialPS();
+		pPS->CompileAsync(PS_CODE, defines.data());
+		m_psVariants.insert(std::make_pair(features, pPS));
+		shaders.push_back(pPS);
+	}
+	for (size_t i = 0; i < shaders.size(); ++i)
+		shaders[i]->WaitCompile();
+}
+void ShaderList::MakeDefines(UINT features, std::vector<D3D_SHADER_MACRO>* pDefines)
 {
-	float4 color = float4(1.0f, 1.0f, 1.0f, 1.0f);
-	if(objAmbient.a >= 1.0f)
-		color = tex.Sample(samp, pin.uv);
-	float3 N = normalize(pin.normal);
-	float3 L = normalize(-lightDir);
-	float dotNL = dot(N, L); // }CiXŌvZ
-	float3 diffuse = objDiffuse.rgb * lightDiffuse.rgb;
-	float3 ambient = objAmbient.rgb * lightDiffuse.rgb;
-	float3 specular = objSpecular.rgb * lightDiffuse.rgb;
-	float toonNL = saturate((dot(N, L) + 0.5f) / 1.5f * 100.0f); // A̋ڂ_炩
-	color.rgb *= saturate(diffuse * toonNL + ambient);
-	if(objSpecular.a >= 1.0f)
-		color.rgb += specular * saturate(pow(dotNL, max(0.01f, objSpecular.a)));
-	return color;
-})EOT";
-	m_pPS[PS_TOON] = new PixelShader();
-	m_pPS[PS_TOON]->Compile(code);
+	// ׂĂ̋@\01Œ`ĂAVF[_[ł#ifŔ肷
+	pDefines->clear();
+	for (UINT i = 0; i < _countof(FEATURE_NAMES); ++i)
+	{
+		D3D_SHADER_MACRO macro = { FEATURE_NAMES[i], (features & (1 << i)) ? "1" : "0" };
+		pDefines->push_back(macro);
+	}
+	D3D_SHADER_MACRO end = { nullptr, nullptr };
+	pDefines->push_back(end);
 }
-void ShaderList::MakeFogPS()
+
+void ShaderList::SetWVP(DirectX::XMFLOAT4X4* wvp)
 {
-	const char* code = R"EOT(
-struct PS_IN {
-	float4 pos : SV_POSITION;
-	float3 normal : NORMAL0;
-	float2 uv : TEXCOORD0;
-	float4 color : COLOR0;
-	float4 wPos : POSITION0;
-};
-cbuffer Material : register(b0)
+	SetWorld(wvp[0]);
+	SetView(wvp[1], wvp[2]);
+}
+void ShaderList::SetWorld(const DirectX::XMFLOAT4X4& world)
 {
-	float4 objDiffuse;
-	float4 objAmbient;
-	float4 objSpecular;
-};
-cbuffer Light : register(b1)
+	m_world = world;
+	WriteObject();
+}
+void ShaderList::SetView(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& proj)
+{
+	// ύXȂΓ]Ȃ(SetWVPŕ`悲ƂɌĂ΂邽
+	if (memcmp(&m_view.view, &view, sizeof(view)) == 0 &&
+		memcmp(&m_view.proj, &proj, sizeof(proj)) == 0) { return; }
+	m_view.view = view;
+	m_view.proj = proj;
+	WriteShared(SLOT_VIEW, &m_view);
+}
+void ShaderList::SetBones(DirectX::XMFLOAT4X4* bones200)
 {
-	float4 lightDiffuse;
-	float4 lightDir;
-};
-cbuffer Camera : register(b2)
+	for (auto it = m_vsVariants.begin(); it != m_vsVariants.end(); ++it)
+	{
+		if (it->first & FEATURE_SKINNING)
+			it->second->WriteBuffer(0, bones200);
+	}
+}
+void ShaderList::SetMaterial(const Model::Material& material)
 {
-	float4 cameraPos;
-};
-cbuffer Param : register(b3)
+	m_material = material;
+	++m_materialVersion;
+	if (m_pBindPS && m_pBindPS->IsBound())
+		m_pBindPS->ApplyMaterial();
+}
+void ShaderList::SetLight(DirectX::XMFLOAT4 color, DirectX::XMFLOAT3 dir)
 {
-	float4 fogColor;
-	float fogStart;
-	float fogRange;
-	float2 dummy;
-};
-Texture2D tex : register(t0);
-SamplerState samp : register(s0);
-float4 main(PS_IN pin) : SV_TARGET
+	DirectX::XMFLOAT4 param[2] = {
+		color
+	};
+	DirectX::XMStoreFloat4(&param[1], DirectX::XMVector3Normalize(
+		DirectX::XMVectorSet(dir.x, dir.y, dir.z, 0.0f)
+	));
+	WriteShared(SLOT_LIGHT, param);
+}
+void ShaderList::SetCameraPos(const DirectX::XMFLOAT3 pos)
 {
-	float4 color = float4(1.0f, 1.0f, 1.0f, 1.0f);
-	if(objAmbient.a >= 1.0f)
-		color = tex.Sample(samp, pin.uv);
-	float3 N = normalize(pin.normal);
-	float3 L = normalize(-lightDir);
-	float dotNL = saturate((dot(N, L) + 0.5f) / 1.5f);
-	float3 diffuse = objDiffuse.rgb * lightDiffuse.rgb;
-	float3 ambient = objAmbient.rgb * lightDiffuse.rgb;
-	color.rgb *= saturate(diffuse * dotNL + ambient);
-	float vLen = length(pin.wPos.xyz - cameraPos.xyz);
-	color.rgb = lerp(color.rgb, fogColor.rgb, saturate((vLen - fogStart) / fogRange));
-	return color;
-})EOT";
-	m_pPS[PS_FOG] = new PixelShader();
-	m_pPS[PS_FOG]->Compile(code);
-}
\ No newline at end of file
+	m_view.cameraPos = DirectX::XMFLOAT4(pos.x, pos.y, pos.z, 0.0f);
+	WriteShared(SLOT_VIEW, &m_view);
+}
+void ShaderList::SetFog(DirectX::XMFLOAT4 color, float start, float range)
+{
+	DirectX::XMFLOAT4 param[] = {
+		color,
+		{start, range, 0.0f, 0.0f}
+	};
+	WriteShared(SLOT_FOG, param);
+}
+void ShaderList::BindShared()
+{
+	RenderContext* pContext = GetContext();
+	pContext->VSSetConstantBuffers(Shader::SHARED_SLOT, SHARED_NUM, m_pShared);
+	pContext->PSSetConstantBuffers(Shader::SHARED_SLOT, SHARED_NUM, m_pShared);
+
+	// O֏łΈʒuw肵Đݒ肵(mۂĂΏݒ
+	if (m_objectBlock.pBuffer)
+	{
+		if (ConstantBufferRing::IsValid(m_objectBlock))
+			BindObject();
+		else
+			WriteObject();
+	}
+}
+void ShaderList::WriteShared(SharedSlot slot, const void* pData)
+{
+	UINT index = slot - Shader::SHARED_SLOT;
+	GetContext()->UpdateSubresource(m_pShared[index], 0, nullptr, pData, 0, 0);
+	ConstantBufferRing::AddFallback(SHARED_SIZE[index]);
+}
+void ShaderList::WriteObject()
+{
+	if (!ConstantBufferRing::Write(&m_world, sizeof(m_world), &m_objectBlock))
+	{
+		m_objectBlock.pBuffer = nullptr;
+		WriteShared(SLOT_OBJECT, &m_world);
+	}
+	BindObject();
+}
+void ShaderList::BindObject()
+{
+	RenderContext* pContext = GetContext();
+	if (m_objectBlock.pBuffer)
+	{
+		pContext->VSSetConstantBuffers1(SLOT_OBJECT, 1, &m_objectBlock.pBuffer, &m_objectBlock.firstConstant, &m_objectBlock.numConstants);
+		pContext->PSSetConstantBuffers1(SLOT_OBJECT, 1, &m_objectBlock.pBuffer, &m_objectBlock.firstConstant, &m_objectBlock.numConstants);
+	}
+	else
+	{
+		pContext->VSSetConstantBuffers(SLOT_OBJECT, 1, &m_pShared[SLOT_OBJECT - Shader::SHARED_SLOT]);
+		pContext->PSSetConstantBuffers(SLOT_OBJECT, 1, &m_pShared[SLOT_OBJECT - Shader::SHARED_SLOT]);
+	}
+}
+void ShaderList::OnRingDiscard()
+{
+	if (m_objectBlock.pBuffer)
+		WriteObject();
+}
+void ShaderList::OnTextureRelease(Texture* pTexture)
+{
+	if (m_material.pTexture == pTexture)
+		m_material.pTexture = nullptr;
+}
@@ -13,6 +13,7 @@ public:
 	{
 		VS_WORLD, // SetWVP
 		VS_ANIME, // SetWVP,SetBones
+		VS_WORLD_INSTANCED, // SetWVP(worldModel::InstanceDatagp
 		VS_KIND_MAX
 	};
 	enum PSKind
@@ -23,6 +24,29 @@ public:
 		PS_FOG, // SetMaterial, SetLight,SetFog
 		PS_KIND_MAX
 	};
+	// VF[_[̋@\(gݍ킹ƂɃ}N`ăRpC
+	enum Feature
+	{
+		FEATURE_SKINNING	= 1 << 0,	// VS: ό`(SetBones
+		FEATURE_INSTANCING	= 1 << 1,	// VS: CX^X`
+		FEATURE_TEXTURE		= 1 << 2,	// PS: eNX`(ݒ莞͔
+		FEATURE_SPECULAR	= 1 << 3,	// PS: ɂ鋾ʔ(SetCameraPos
+		FEATURE_TOON		= 1 << 4,	// PS: gD[
+		FEATURE_FOG			= 1 << 5,	// PS: tHO(SetFog, SetCameraPos
+		FEATURE_VS_MASK		= FEATURE_SKINNING | FEATURE_INSTANCING,
+		FEATURE_PS_MASK		= FEATURE_TEXTURE | FEATURE_SPECULAR | FEATURE_TOON | FEATURE_FOG,
+	};
+	// SVF[_[ŋL萔obt@̃WX^ԍ
+	// (x݁A_/sNZVF[_[̗֐ݒ肵܂܂ɂ
+	// SLOT_OBJECT͕`悲Ƃɕς邽߁A萔obt@̃O֏ňʒuw肵Đݒ肷
+	enum SharedSlot
+	{
+		SLOT_OBJECT = Shader::SHARED_SLOT, // SetWVP,SetWorld
+		SLOT_VIEW, // SetWVP,SetView,SetCameraPos
+		SLOT_LIGHT, // SetLight
+		SLOT_FOG, // SetFog
+		SLOT_MAX
+	};
 
 
 public:
@@ -35,27 +59,60 @@ public:
 	// VF[_[ݒ
 	static VertexShader* GetVS(VSKind vs);
 	static PixelShader* GetPS(PSKind ps);
+	// @\̑gݍ킹VF[_[擾(߂ėvꂽgݍ킹͂̏ŃRpC
+	static VertexShader* GetVS(UINT features);
+	static PixelShader* GetPS(UINT features);
+	// gpgݍ킹܂Ƃ߂ĕʃXbhŃRpC
+	static void Prebuild(const UINT* pVSFeatures, UINT vsNum, const UINT* pPSFeatures, UINT psNum);
 
 	// 萔obt@ւ̐ݒ
 	static void SetWVP(DirectX::XMFLOAT4X4* wvp);
+	static void SetWorld(const DirectX::XMFLOAT4X4& world);
+	static void SetView(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& proj);
 	static void SetBones(DirectX::XMFLOAT4X4* bones200);
 	static void SetMaterial(const Model::Material& material);
 	static void SetLight(DirectX::XMFLOAT4 color, DirectX::XMFLOAT3 dir);
 	static void SetCameraPos(const DirectX::XMFLOAT3 pos);
 	static void SetFog(DirectX::XMFLOAT4 color, float start, float range);
+	// L̒萔obt@ݒ肵(ClearStateȂǂŐݒ肪Oꂽꍇ
+	static void BindShared();
 	
 private:
-	static void MakeWorldVS();
-	static void MakeAnimeVS();
-	static void MakeLambertPS();
-	static void MakeSpecularPS();
-	static void MakeToonPS();
-	static void MakeFogPS();
+	static void WriteShared(SharedSlot slot, const void* pData);
+	// SLOT_OBJECT݂̏Ɛݒ(OgȂ΋L̃obt@֏
+	static void WriteObject();
+	static void BindObject();
+	// OmۂꂽۂSLOT_OBJECTݒ
+	static void OnRingDiscard();
+	// jeNX`SetMaterial̓eO
+	static void OnTextureRelease(Texture* pTexture);
+	static void MakeDefines(UINT features, std::vector<D3D_SHADER_MACRO>* pDefines);
 
 private:
-	static VertexShader* m_pVS[VS_KIND_MAX];
-	static PixelShader* m_pPS[PS_KIND_MAX];
+	// SetMaterial̓eɕ`֎gpۂɔfsNZVF[_[
+	class MaterialPS;
+	// SLOT_VIEW̓e
+	struct ViewParam
+	{
+		DirectX::XMFLOAT4X4 view;
+		DirectX::XMFLOAT4X4 proj;
+		DirectX::XMFLOAT4 cameraPos;
+	};
+	static const UINT SHARED_NUM = SLOT_MAX - Shader::SHARED_SLOT;
+	static const UINT VS_KIND_FEATURES[VS_KIND_MAX];
+	static const UINT PS_KIND_FEATURES[PS_KIND_MAX];
+
+	static std::map<UINT, VertexShader*> m_vsVariants;	// @\̑gݍ킹Ƃ̃VF[_[
+	static std::map<UINT, PixelShader*> m_psVariants;
+	static ID3D11Buffer* m_pShared[SHARED_NUM];
+	static thread_local DirectX::XMFLOAT4X4 m_world;	// SLOT_OBJECT̓e(s悪XbhƂɈقȂ邽
+	static thread_local ConstantBufferRing::Block m_objectBlock;	// SLOT_OBJECT񂾃Öʒu(gĂȂpBuffernullptr
+	static ViewParam m_view;
+	static Model::Material m_material;	// SetMaterial̓e
+	static UINT m_materialVersion;		// SetMaterial̂тɕςԍ(قȂVF[_[֔f
+	static MaterialPS* m_pBindPS;		// `XbhōŌɐݒ肵sNZVF[_[
+	static Texture* m_pWhite;	// eNX`ݒ莞Ɏgp锒
 	
 };
 
-#endif // __SHADER_LIST_H__
\ No newline at end of file
+#endif // __SHADER_LIST_H__
@@ -0,0 +1,83 @@
+#include "SkinWeight.h"
+#include <assimp/mesh.h>
+#include <algorithm>
+#include <cstring>
+
+/*
+* @brief _Ƃ̃EFCg̍쐬
+* @param[in] pArena Ɨp̔zƌʂ̊mې
+* @param[in] pMesh {[bV
+* @param[in] pBoneValid {[Ƃ̎gp(nullptrׂ͂Ďgp
+* @return _̃EFCg
+*/
+SkinWeight::Weight* SkinWeight::Make(Arena* pArena, const aiMesh* pMesh, const bool* pBoneValid)
+{
+	struct WeightPair
+	{
+		unsigned int idx;
+		float weight;
+	};
+
+	unsigned int vtxNum = pMesh->mNumVertices;
+	Weight* pOut = pArena->Alloc<Weight>(vtxNum);
+	memset(pOut, 0, sizeof(Weight) * vtxNum);
+
+	// _Ƃ̃EFCg̔zɋl߂Ċi[
+	// (_ĩEFCg weights[offsets[i]] ` weights[offsets[i + 1] - 1]
+	unsigned int* offsets = pArena->Alloc<unsigned int>(vtxNum + 1);
+	memset(offsets, 0, sizeof(unsigned int) * (vtxNum + 1));
+	for (unsigned int i = 0; i < pMesh->mNumBones; ++i)
+	{
+		if (pBoneValid && !pBoneValid[i]) { continue; }
+		const aiBone* assimpBone = pMesh->mBones[i];
+		for (unsigned int j = 0; j < assimpBone->mNumWeights; ++j)
+		{
+			++offsets[assimpBone->mWeights[j].mVertexId + 1];
+		}
+	}
+	for (unsigned int i = 0; i < vtxNum; ++i)
+	{
+		offsets[i + 1] += offsets[i];
+	}
+
+	// EFCg̐ݒ
+	WeightPair* weights = pArena->Alloc<WeightPair>(offsets[vtxNum]);
+	unsigned int* cursor = pArena->Alloc<unsigned int>(vtxNum);
+	memcpy(cursor, offsets, sizeof(unsigned int) * vtxNum);
+	for (unsigned int i = 0; i < pMesh->mNumBones; ++i)
+	{
+		if (pBoneValid && !pBoneValid[i]) { continue; }
+		const aiBone* assimpBone = pMesh->mBones[i];
+		for (unsigned int j = 0; j < assimpBone->mNumWeights; ++j)
+		{
+			aiVertexWeight weight = assimpBone->mWeights[j];
+			weights[cursor[weight.mVertexId]++] = { i, weight.mWeight };
+		}
+	}
+
+	// _Ƃɉȇ傫4I
+	for (unsigned int i = 0; i < vtxNum; ++i)
+	{
+		WeightPair* pWeight = weights + offsets[i];
+		unsigned int weightNum = offsets[i + 1] - offsets[i];
+		if (weightNum >= 4)
+		{
+			// ȇ傫4בւ
+			std::partial_sort(pWeight, pWeight + 4, pWeight + weightNum, [](const WeightPair& a, const WeightPair& b) {
+				return a.weight > b.weight;
+			});
+			// EFCg4ɍ킹ĐK
+			float total = 0.0f;
+			for (int j = 0; j < 4; ++j)
+				total += pWeight[j].weight;
+			for (int j = 0; j < 4; ++j)
+				pWeight[j].weight /= total;
+		}
+		for (unsigned int j = 0; j < weightNum && j < 4; ++j)
+		{
+			pOut[i].index[j] = pWeight[j].idx;
+			pOut[i].weight[j] = pWeight[j].weight;
+		}
+	}
+	return pOut;
+}
@@ -0,0 +1,29 @@
+#ifndef __SKIN_WEIGHT_H__
+#define __SKIN_WEIGHT_H__
+
+#include "Arena.h"
+
+struct aiMesh;
+
+/*
+* @brief _Ƃ̃{[EFCg̍쐬
+*  assimp̃{[Ƃ̃EFCgꗗA_Ƃɉȇ傫4ւ܂Ƃߒ
+*  Ɨp̔zArenamۂA_Ƃ̃q[vmۂ͍sȂ
+*/
+class SkinWeight
+{
+public:
+	// _Ƃ̃EFCg(gpȂvf0
+	struct Weight
+	{
+		float			weight[4];
+		unsigned int	index[4];	// bṼ{[ԍ
+	};
+
+public:
+	// _̃EFCgpArenamۂč쐬
+	// pBoneValid: {[Ƃ̎gp(falsẽ{[͖Anullptrׂ͂Ďgp
+	static Weight* Make(Arena* pArena, const aiMesh* pMesh, const bool* pBoneValid);
+};
+
+#endif // __SKIN_WEIGHT_H__
@@ -71,6 +71,7 @@ float4 main(PS_IN pin) : SV_TARGET {
 	desc.vtxSize = sizeof(Vertex);
 	desc.vtxCount = _countof(vtx);
 	desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+	desc.isGPUOnly = true;
 	m_data.mesh = std::make_shared<MeshBuffer>();
 	m_data.mesh->Create(desc);
 
@@ -0,0 +1,444 @@
+#include "SpriteBatch.h"
+#include "DirectXTex/TextureLoad.h"
+#include <string.h>
+#include <algorithm>
+
+//--- ÓIo
+std::vector<SpriteBatch::Vertex>	SpriteBatch::m_vertices;
+std::vector<Texture*>				SpriteBatch::m_textures;
+std::vector<uint64_t>				SpriteBatch::m_keys;
+DirectX::XMFLOAT4X4					SpriteBatch::m_matrix[2];
+std::shared_ptr<VertexShader>		SpriteBatch::m_pVS;
+std::shared_ptr<PixelShader>		SpriteBatch::m_pPS;
+ID3D11Buffer*						SpriteBatch::m_pRingBuffer = nullptr;
+UINT								SpriteBatch::m_ringQuadNum = 0;
+UINT								SpriteBatch::m_ringOffset = 0;
+UINT								SpriteBatch::m_ringMapNum = 0;
+ID3D11Buffer*						SpriteBatch::m_pIndexBuffer = nullptr;
+SpriteBatch::Stats					SpriteBatch::m_stats;
+
+//----------
+// SpriteAtlas
+//----------
+SpriteAtlas::SpriteAtlas()
+	: m_pTexture(nullptr)
+{
+}
+SpriteAtlas::~SpriteAtlas()
+{
+}
+
+HRESULT SpriteAtlas::Create(const char** fileNames, UINT num, UINT padding)
+{
+	HRESULT hr = S_OK;
+	if (num == 0) { return E_FAIL; }
+
+	// 摜ׂēǂݍRGBA8ɑ
+	std::vector<DirectX::ScratchImage> images(num);
+	for (UINT i = 0; i < num; ++i)
+	{
+		wchar_t wPath[MAX_PATH];
+		MultiByteToWideChar(0, 0, fileNames[i], -1, wPath, MAX_PATH);
+		DirectX::TexMetadata mdata;
+		DirectX::ScratchImage image;
+		if (strstr(fileNames[i], ".tga"))
+			hr = DirectX::LoadFromTGAFile(wPath, &mdata, image);
+		else
+			hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, &mdata, image);
+		if (FAILED(hr)) { return hr; }
+
+		if (mdata.format != DXGI_FORMAT_R8G8B8A8_UNORM)
+		{
+			hr = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM,
+				DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, images[i]);
+			if (FAILED(hr)) { return hr; }
+		}
+		else
+			images[i] = std::move(image);
+	}
+
+	// ɕׂāAɋl߂Ȃid˂
+	std::vector<UINT> order(num);
+	UINT64 area = 0;
+	UINT maxWidth = 0;
+	for (UINT i = 0; i < num; ++i)
+	{
+		const DirectX::Image* pImage = images[i].GetImage(0, 0, 0);
+		order[i] = i;
+		area += static_cast<UINT64>(pImage->width + padding) * (pImage->height + padding);
+		maxWidth = std::max(maxWidth, static_cast<UINT>(pImage->width) + padding * 2);
+	}
+	std::stable_sort(order.begin(), order.end(), [&images](UINT a, UINT b) {
+		return images[a].GetImage(0, 0, 0)->height > images[b].GetImage(0, 0, 0)->height;
+	});
+
+	// ͖ʐς̕ȏ2ׂ̂
+	UINT width = 64;
+	while (static_cast<UINT64>(width) * width < area || width < maxWidth)
+		width *= 2;
+
+	std::vector<DirectX::XMUINT2> pos(num);
+	UINT x = padding, y = padding, rowHeight = 0;
+	for (UINT i = 0; i < num; ++i)
+	{
+		const DirectX::Image* pImage = images[order[i]].GetImage(0, 0, 0);
+		UINT w = static_cast<UINT>(pImage->width);
+		UINT h = static_cast<UINT>(pImage->height);
+		if (x + w + padding > width)
+		{
+			x = padding;
+			y += rowHeight + padding;
+			rowHeight = 0;
+		}
+		pos[order[i]] = DirectX::XMUINT2(x, y);
+		x += w + padding;
+		rowHeight = std::max(rowHeight, h);
+	}
+	UINT height = 64;
+	while (height < y + rowHeight + padding)
+		height *= 2;
+	if (width > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || height > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+		return E_FAIL;
+
+	// ꖇ̉摜ɏ(Ԃ͓
+	std::vector<uint32_t> pixels(static_cast<size_t>(width) * height, 0);
+	for (UINT i = 0; i < num; ++i)
+	{
+		const DirectX::Image* pImage = images[i].GetImage(0, 0, 0);
+		for (size_t row = 0; row < pImage->height; ++row)
+		{
+			memcpy(&pixels[(pos[i].y + row) * width + pos[i].x],
+				pImage->pixels + row * pImage->rowPitch, pImage->width * sizeof(uint32_t));
+		}
+	}
+	std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+	hr = texture->Create(DXGI_FORMAT_R8G8B8A8_UNORM, width, height, pixels.data());
+	if (FAILED(hr)) { return hr; }
+
+	m_texture = texture;
+	m_pTexture = m_texture.get();
+	m_regions.clear();
+	for (UINT i = 0; i < num; ++i)
+	{
+		const DirectX::Image* pImage = images[i].GetImage(0, 0, 0);
+		AddRegion(pos[i].x, pos[i].y, static_cast<UINT>(pImage->width), static_cast<UINT>(pImage->height));
+	}
+	return hr;
+}
+void SpriteAtlas::SetTexture(Texture* pTexture)
+{
+	m_texture.reset();
+	m_pTexture = pTexture;
+	m_regions.clear();
+}
+
+UINT SpriteAtlas::AddRegion(UINT x, UINT y, UINT width, UINT height)
+{
+	float texW = m_pTexture && m_pTexture->GetWidth() ? static_cast<float>(m_pTexture->GetWidth()) : 1.0f;
+	float texH = m_pTexture && m_pTexture->GetHeight() ? static_cast<float>(m_pTexture->GetHeight()) : 1.0f;
+	Region region;
+	region.uv = DirectX::XMFLOAT4(x / texW, y / texH, width / texW, height / texH);
+	region.width = width;
+	region.height = height;
+	m_regions.push_back(region);
+	return static_cast<UINT>(m_regions.size() - 1);
+}
+void SpriteAtlas::AddGrid(UINT cols, UINT rows)
+{
+	if (!m_pTexture || cols == 0 || rows == 0) { return; }
+	UINT w = m_pTexture->GetWidth() / cols;
+	UINT h = m_pTexture->GetHeight() / rows;
+	for (UINT j = 0; j < rows; ++j)
+		for (UINT i = 0; i < cols; ++i)
+			AddRegion(i * w, j * h, w, h);
+}
+
+Texture* SpriteAtlas::GetTexture() const
+{
+	return m_pTexture;
+}
+UINT SpriteAtlas::GetRegionNum() const
+{
+	return static_cast<UINT>(m_regions.size());
+}
+const DirectX::XMFLOAT4& SpriteAtlas::GetUV(UINT region) const
+{
+	return m_regions[region].uv;
+}
+DirectX::XMFLOAT2 SpriteAtlas::GetSize(UINT region) const
+{
+	return DirectX::XMFLOAT2(
+		static_cast<float>(m_regions[region].width),
+		static_cast<float>(m_regions[region].height));
+}
+
+//----------
+// SpriteBatch
+//----------
+void SpriteBatch::Init()
+{
+	const char* VS = R"EOT(
+struct VS_IN {
+	float3 pos : POSITION0;
+	float2 uv : TEXCOORD0;
+	float4 color : COLOR0;
+};
+struct VS_OUT {
+	float4 pos : SV_POSITION;
+	float2 uv : TEXCOORD0;
+	float4 color : COLOR0;
+};
+cbuffer Matrix : register(b0) {
+	float4x4 view;
+	float4x4 proj;
+};
+VS_OUT main(VS_IN vin) {
+	VS_OUT vout;
+	vout.pos = float4(vin.pos, 1.0f);
+	vout.pos = mul(vout.pos, view);
+	vout.pos = mul(vout.pos, proj);
+	vout.uv = vin.uv;
+	vout.color = vin.color;
+	return vout;
+})EOT";
+	const char* PS = R"EOT(
+struct PS_IN {
+	float4 pos : SV_POSITION;
+	float2 uv : TEXCOORD0;
+	float4 color : COLOR0;
+};
+Texture2D tex : register(t0);
+SamplerState samp : register(s0);
+float4 main(PS_IN pin) : SV_TARGET {
+	return tex.Sample(samp, pin.uv) * pin.color;
+})EOT";
+
+	// VF[_[
+	m_pVS = std::make_shared<VertexShader>();
+	m_pVS->Compile(VS);
+	m_pPS = std::make_shared<PixelShader>();
+	m_pPS->Compile(PS);
+
+	// CfbNX(lp`ƂɓтȂ̂ňx쐬
+	std::vector<WORD> idx(MAX_QUAD_PER_DRAW * 6);
+	for (UINT i = 0; i < MAX_QUAD_PER_DRAW; ++i)
+	{
+		WORD v = static_cast<WORD>(i * 4);
+		WORD* pIdx = &idx[i * 6];
+		pIdx[0] = v + 0; pIdx[1] = v + 1; pIdx[2] = v + 2;
+		pIdx[3] = v + 2; pIdx[4] = v + 1; pIdx[5] = v + 3;
+	}
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = static_cast<UINT>(sizeof(WORD) * idx.size());
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	D3D11_SUBRESOURCE_DATA data = {};
+	data.pSysMem = idx.data();
+	GetDevice()->CreateBuffer(&desc, &data, &m_pIndexBuffer);
+
+	DirectX::XMStoreFloat4x4(&m_matrix[0], DirectX::XMMatrixIdentity());
+	DirectX::XMStoreFloat4x4(&m_matrix[1], DirectX::XMMatrixIdentity());
+	m_vertices.reserve(RING_QUAD_MIN * 4);
+	m_textures.reserve(RING_QUAD_MIN);
+	m_keys.reserve(RING_QUAD_MIN);
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+void SpriteBatch::Uninit()
+{
+	Clear();
+	m_vertices.shrink_to_fit();
+	m_textures.shrink_to_fit();
+	m_keys.shrink_to_fit();
+	SAFE_RELEASE(m_pIndexBuffer);
+	SAFE_RELEASE(m_pRingBuffer);
+	m_ringQuadNum = 0;
+	m_ringOffset = 0;
+	m_pPS.reset();
+	m_pVS.reset();
+}
+
+void SpriteBatch::Add(Texture* pTexture, const DirectX::XMFLOAT4X4& world,
+	const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer)
+{
+	AddQuad(pTexture, DirectX::XMLoadFloat4x4(&world), uv, color, layer);
+}
+void SpriteBatch::Add(Texture* pTexture, DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size, float angle,
+	const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer)
+{
+	DirectX::XMMATRIX world =
+		DirectX::XMMatrixScaling(size.x, size.y, 1.0f) *
+		DirectX::XMMatrixRotationZ(angle) *
+		DirectX::XMMatrixTranslation(pos.x, pos.y, 0.0f);
+	AddQuad(pTexture, world, uv, color, layer);
+}
+void SpriteBatch::Add(const SpriteAtlas& atlas, UINT region, DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size,
+	float angle, const DirectX::XMFLOAT4& color, UINT layer)
+{
+	Add(atlas.GetTexture(), pos, size, angle, atlas.GetUV(region), color, layer);
+}
+
+void SpriteBatch::AddQuad(Texture* pTexture, DirectX::FXMMATRIX world,
+	const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer)
+{
+	// SpriteƓ(AEAAE
+	static const float CORNER[4][2] = {
+		{-0.5f, 0.5f}, { 0.5f, 0.5f}, {-0.5f,-0.5f}, { 0.5f,-0.5f},
+	};
+	UINT index = static_cast<UINT>(m_textures.size());
+	for (int i = 0; i < 4; ++i)
+	{
+		Vertex vtx;
+		DirectX::XMStoreFloat3(&vtx.pos, DirectX::XMVector3TransformCoord(
+			DirectX::XMVectorSet(CORNER[i][0], CORNER[i][1], 0.0f, 1.0f), world));
+		vtx.uv.x = uv.x + uv.z * (i & 1);
+		vtx.uv.y = uv.y + uv.w * (i >> 1);
+		vtx.color = color;
+		m_vertices.push_back(vtx);
+	}
+	m_textures.push_back(pTexture);
+
+	uint64_t texKey = pTexture ? (pTexture->GetID() & 0x0fffffff) : 0;
+	uint64_t key = static_cast<uint64_t>(layer & (LAYER_MAX - 1)) << 60;
+	key |= texKey << 32;
+	key |= index;
+	m_keys.push_back(key);
+}
+
+void SpriteBatch::Flush()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	UINT num = static_cast<UINT>(m_keys.size());
+	m_stats.quadNum = num;
+	if (num == 0) { return; }
+
+	// ʂɒǉĂ邽߁AC[AeNX`ł͒ǉ̂܂ܕ
+	std::sort(m_keys.begin(), m_keys.end());
+
+	UINT start;
+	Vertex* pDst = MapRing(num, &start);
+	if (!pDst)
+	{
+		Clear();
+		return;
+	}
+	for (UINT i = 0; i < num; ++i)
+	{
+		UINT index = static_cast<UINT>(m_keys[i] & 0xffffffff);
+		memcpy(pDst + i * 4, &m_vertices[index * 4], sizeof(Vertex) * 4);
+	}
+	UnmapRing();
+
+	m_pVS->WriteBuffer(0, m_matrix);
+	m_pVS->Bind();
+	m_pPS->Bind();
+	RenderContext* pContext = GetContext();
+	UINT stride = sizeof(Vertex);
+	UINT offset = 0;
+	pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pContext->IASetVertexBuffers(0, 1, &m_pRingBuffer, &stride, &offset);
+	pContext->IASetIndexBuffer(m_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+
+	// eNX`͈͂܂Ƃ߂ĕ`
+	UINT begin = 0;
+	Texture* pTex = m_textures[m_keys[0] & 0xffffffff];
+	for (UINT i = 1; i < num; ++i)
+	{
+		Texture* pNext = m_textures[m_keys[i] & 0xffffffff];
+		if (pNext != pTex)
+		{
+			DrawRun(start, begin, i, pTex);
+			begin = i;
+			pTex = pNext;
+		}
+	}
+	DrawRun(start, begin, num, pTex);
+
+	Clear();
+}
+void SpriteBatch::Clear()
+{
+	m_vertices.clear();
+	m_textures.clear();
+	m_keys.clear();
+}
+
+void SpriteBatch::SetView(DirectX::XMFLOAT4X4 view)
+{
+	m_matrix[0] = view;
+}
+void SpriteBatch::SetProjection(DirectX::XMFLOAT4X4 proj)
+{
+	m_matrix[1] = proj;
+}
+
+const SpriteBatch::Stats& SpriteBatch::GetStats()
+{
+	return m_stats;
+}
+
+// ёւlp`begin`end`(CfbNX̏𒴂镪͕ĕ`
+void SpriteBatch::DrawRun(UINT start, UINT begin, UINT end, Texture* pTexture)
+{
+	RenderContext* pContext = GetContext();
+	Texture* pBind = pTexture ? pTexture : Shader::GetDefaultTexture();
+	ID3D11ShaderResourceView* pSRV = pBind ? pBind->GetResource() : nullptr;
+	pContext->PSSetShaderResources(0, 1, &pSRV);
+	++m_stats.texChangeNum;
+	ConstantBufferRing::Flush();
+
+	while (begin < end)
+	{
+		UINT num = end - begin < MAX_QUAD_PER_DRAW ? end - begin : MAX_QUAD_PER_DRAW;
+		pContext->DrawIndexed(num * 6, 0, static_cast<INT>((start + begin) * 4));
+		++m_stats.drawNum;
+		begin += num;
+	}
+}
+
+SpriteBatch::Vertex* SpriteBatch::MapRing(UINT num, UINT* pStart)
+{
+	if (FAILED(ReserveRing(num))) { return nullptr; }
+
+	// Ȍ݂ɑď݁A肫ȂΔjĐ擪
+	UINT start = m_ringOffset;
+	D3D11_MAP type = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (start + num > m_ringQuadNum)
+	{
+		type = D3D11_MAP_WRITE_DISCARD;
+		start = 0;
+	}
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(GetContext()->Map(m_pRingBuffer, 0, type, 0, &mapped))) { return nullptr; }
+	m_ringOffset = start + num;
+	m_ringMapNum = num;
+	*pStart = start;
+	return static_cast<Vertex*>(mapped.pData) + start * 4;
+}
+void SpriteBatch::UnmapRing()
+{
+	const UINT QUAD_SIZE = sizeof(Vertex) * 4;
+	GetContext()->UnmapRange(m_pRingBuffer, 0, (m_ringOffset - m_ringMapNum) * QUAD_SIZE, m_ringMapNum * QUAD_SIZE);
+}
+HRESULT SpriteBatch::ReserveRing(UINT num)
+{
+	if (m_pRingBuffer && num <= m_ringQuadNum) { return S_OK; }
+
+	UINT quadNum = m_ringQuadNum > RING_QUAD_MIN ? m_ringQuadNum : RING_QUAD_MIN;
+	while (quadNum < num)
+		quadNum *= 2;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = sizeof(Vertex) * 4 * quadNum;
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	ID3D11Buffer* pBuffer = nullptr;
+	HRESULT hr = GetDevice()->CreateBuffer(&desc, nullptr, &pBuffer);
+	if (FAILED(hr)) { return hr; }
+
+	SAFE_RELEASE(m_pRingBuffer);
+	m_pRingBuffer = pBuffer;
+	m_ringQuadNum = quadNum;
+	m_ringOffset = quadNum;	// 쐬DISCARDŏ܂
+	return S_OK;
+}
@@ -0,0 +1,129 @@
+#ifndef __SPRITE_BATCH_H__
+#define __SPRITE_BATCH_H__
+
+#include <DirectXMath.h>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+#include "Shader.h"
+#include "Texture.h"
+
+// XvCgAgX
+// ꖇ̃eNX`̗̈ɔԍtĊǗ
+// ̉摜쐬ꍇ͉摜̏Ԃ̂܂ܗ̈̔ԍɂȂ
+class SpriteAtlas
+{
+public:
+	SpriteAtlas();
+	~SpriteAtlas();
+
+	// ̉摜ꖇ̃eNX`֋l߂č쐬(padding: 摜m̌
+	HRESULT Create(const char** fileNames, UINT num, UINT padding = 1);
+	// 쐬ς݂̃eNX`gp(̈AddRegion,AddGridŒǉ
+	void SetTexture(Texture* pTexture);
+
+	// ̈̒ǉ(sNZP)A߂l͗̈̔ԍ
+	UINT AddRegion(UINT x, UINT y, UINT width, UINT height);
+	// eNX`𓙕̈ォ珇ɒǉ
+	void AddGrid(UINT cols, UINT rows);
+
+	Texture* GetTexture() const;
+	UINT GetRegionNum() const;
+	// xy:UV̈ʒu zw:UV̑傫(Sprite::SetUVPos,SetUVScaleƓ
+	const DirectX::XMFLOAT4& GetUV(UINT region) const;
+	// ̈̃sNZ
+	DirectX::XMFLOAT2 GetSize(UINT region) const;
+
+private:
+	struct Region
+	{
+		DirectX::XMFLOAT4 uv;
+		UINT width;
+		UINT height;
+	};
+	std::shared_ptr<Texture> m_texture;	// Createō쐬eNX`
+	Texture* m_pTexture;
+	std::vector<Region> m_regions;
+};
+
+// XvCĝ܂Ƃߕ`
+// ǉꂽlp`CPUŒ_ɓWJė߂ĂAFlush
+// C[ > eNX` ̏ɕёւāAeNX`͈͂ŕ`悷
+// EC[0珇ɕ`悷(C[ł͈قȂeNX`m̑O͕ۏ؂Ȃ
+// EeNX`ł͒ǉɕ`悷
+// EUIAgXɂ܂Ƃ߂Ă΁AC[UI͈̕`ɂȂ
+class SpriteBatch
+{
+public:
+	// `̏Wv
+	struct Stats
+	{
+		UINT quadNum;	// lp`̐
+		UINT drawNum;	// `施߂̐
+		UINT texChangeNum;	// eNX`̐؂ւ
+	};
+
+	// 萔`
+	static const UINT LAYER_MAX = 16;	// C[(0珇ɕ`
+	static const UINT MAX_QUAD_PER_DRAW = 0x4000;	// ŕ`悷lp`̏(16bitCfbNX͈̔
+
+public:
+	static void Init();
+	static void Uninit();
+
+	// lp`̒ǉ
+	// world: -0.5`0.5̎lp`ό`s(]uȂ
+	// uv: xy:UV̈ʒu zw:UV̑傫
+	static void Add(Texture* pTexture, const DirectX::XMFLOAT4X4& world,
+		const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer = 0);
+	// pos:S size:傫 angle:Z](WA
+	static void Add(Texture* pTexture, DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size, float angle,
+		const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer = 0);
+	// AgẌ̗`
+	static void Add(const SpriteAtlas& atlas, UINT region, DirectX::XMFLOAT2 pos, DirectX::XMFLOAT2 size,
+		float angle, const DirectX::XMFLOAT4& color, UINT layer = 0);
+
+	// ёւĕ`悵A߂lp`ɂ
+	static void Flush();
+	// `悹ɋɂ
+	static void Clear();
+
+	// ]uς݂̍sݒ(SpriteƓ
+	static void SetView(DirectX::XMFLOAT4X4 view);
+	static void SetProjection(DirectX::XMFLOAT4X4 proj);
+
+	static const Stats& GetStats();
+
+private:
+	struct Vertex
+	{
+		DirectX::XMFLOAT3 pos;
+		DirectX::XMFLOAT2 uv;
+		DirectX::XMFLOAT4 color;
+	};
+
+	static void AddQuad(Texture* pTexture, DirectX::FXMMATRIX world,
+		const DirectX::XMFLOAT4& uv, const DirectX::XMFLOAT4& color, UINT layer);
+	static void DrawRun(UINT start, UINT begin, UINT end, Texture* pTexture);
+	static Vertex* MapRing(UINT num, UINT* pStart);
+	static void UnmapRing();
+	static HRESULT ReserveRing(UINT num);
+
+private:
+	static const UINT RING_QUAD_MIN = 1024;	// _obt@̍ŏ̎lp`
+
+	static std::vector<Vertex>		m_vertices;	// ǉ̒_(lp`Ƃ4
+	static std::vector<Texture*>	m_textures;	// ǉ̃eNX`
+	static std::vector<uint64_t>	m_keys;		// [63-60]C[ [59-32]eNX` [31-0]ǉ
+	static DirectX::XMFLOAT4X4		m_matrix[2];
+	static std::shared_ptr<VertexShader> m_pVS;
+	static std::shared_ptr<PixelShader> m_pPS;
+	static ID3D11Buffer*	m_pRingBuffer;	// ёւ_(ȂȂΑ傫
+	static UINT				m_ringQuadNum;	// _obt@ɓlp`̐
+	static UINT				m_ringOffset;	// ɏގlp`̈ʒu
+	static UINT				m_ringMapNum;	// MapRingŏ܂Ălp`̐
+	static ID3D11Buffer*	m_pIndexBuffer;
+	static Stats			m_stats;
+};
+
+#endif // __SPRITE_BATCH_H__
@@ -1,14 +1,21 @@
 #include <windows.h>
 #include "Defines.h"
 #include "Main.h"
+#include "DirectX.h"
 #include <stdio.h>
 #include <crtdbg.h>
 
 // timeGetTime̎gp
 #pragma comment(lib, "winmm.lib")
 
+// wbhXv̊̃t[
+static const int HEADLESS_FRAME_NUM = 300;
+// wbhXv̌ʂ̏o͐
+static const char* HEADLESS_RESULT_PATH = "HeadlessResult.csv";
+
 //--- vg^Cv錾
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
+int RunHeadless(int frameNum);
 
 
 // Gg|Cg
@@ -16,6 +23,15 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 {
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 
+	// R}hC -headless [t[] ΃EBhE炸Ɍv
+	const char* pHeadless = strstr(lpCmdLine, "-headless");
+	if (pHeadless)
+	{
+		int frameNum = 0;
+		sscanf_s(pHeadless, "-headless %d", &frameNum);
+		return RunHeadless(frameNum > 0 ? frameNum : HEADLESS_FRAME_NUM);
+	}
+
 	//--- ϐ錾
 	WNDCLASSEX wcex;
 	HWND hWnd;
@@ -118,4 +134,44 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 		break;
 	}
 	return DefWindowProc(hWnd, message, wParam, lParam);
+}
+
+// wbhXv
+// `͋L^̂ݍsAt[Ƃ̍XVƕ`ɂԁAL^R}h̏WvCSV֏o
+int RunHeadless(int frameNum)
+{
+	if (FAILED(Init(NULL, SCREEN_WIDTH, SCREEN_HEIGHT)))
+	{
+		Uninit();
+		return 1;
+	}
+
+	FILE* fp = nullptr;
+	fopen_s(&fp, HEADLESS_RESULT_PATH, "w");
+	if (fp)
+		fprintf(fp, "frame,cpuMs,commands,draws,states,uploads,uploadBytes\n");
+
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	for (int i = 0; i < frameNum; ++i)
+	{
+		QueryPerformanceCounter(&start);
+		Update();
+		Draw();
+		QueryPerformanceCounter(&end);
+
+		const RenderContextRecord::Stats& stats = GetRecordContext()->GetStats();
+		double ms = (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+		if (fp)
+		{
+			fprintf(fp, "%d,%.3f,%u,%u,%u,%u,%llu\n", i, ms,
+				stats.commandNum, stats.drawNum, stats.stateNum, stats.uploadNum,
+				static_cast<unsigned long long>(stats.uploadBytes));
+		}
+	}
+
+	if (fp)
+		fclose(fp);
+	Uninit();
+	return 0;
 }
\ No newline at end of file
@@ -1,17 +1,114 @@
 #include "Texture.h"
 #include "DirectXTex/TextureLoad.h"
+#include <string>
+
+UINT Texture::m_idCount = 0;
+bool Texture::m_isCook = false;
+TextureCook::Format Texture::m_cookFormat = TextureCook::FORMAT_AUTO;
+std::vector<Texture::ReleaseCallback> Texture::m_releaseCallbacks;
+
+static const char* TEXTURE_CACHE_DIR = "TextureCache/";
+
+// ϊς݃t@C̃pX(t@CɌ̃pX̃nbVƗvtH[}bgtċʂ
+static std::string MakeCookPath(const char* fileName, TextureCook::Format format)
+{
+	const char* name = fileName;
+	for (const char* p = fileName; *p; ++p)
+	{
+		if (*p == '/' || *p == '\\' || *p == ':')
+			name = p + 1;
+	}
+	char suffix[32];
+	sprintf_s(suffix, "_%016llx_%d.dds", static_cast<unsigned long long>(TextureCook::HashPath(fileName)), format);
+	return TEXTURE_CACHE_DIR + std::string(name) + suffix;
+}
+// ϊς݃t@Cgpł邩
+// Ẽt@CV(̃t@CȂΕϊς݃t@Cgp
+// Ewb_[̎ʒl̃pXAvtH[}bgAsRGBƈv
+static bool IsCookValid(const char* fileName, const char* cookPath, TextureCook::Format format)
+{
+	WIN32_FILE_ATTRIBUTE_DATA src, cook;
+	if (!GetFileAttributesExA(cookPath, GetFileExInfoStandard, &cook)) { return false; }
+	if (GetFileAttributesExA(fileName, GetFileExInfoStandard, &src) &&
+		CompareFileTime(&cook.ftLastWriteTime, &src.ftLastWriteTime) < 0)
+		return false;
+
+	FILE* fp = nullptr;
+	fopen_s(&fp, cookPath, "rb");
+	if (!fp) { return false; }
+	uint8_t header[TextureCook::DDS_HEADER_SIZE];
+	size_t size = fread(header, 1, sizeof(header), fp);
+	fclose(fp);
+	TextureCook::DDSInfo info;
+	if (!TextureCook::ReadDDSHeader(header, size, &info)) { return false; }
+	return info.key == TextureCook::MakeKey(fileName, format, info.isSRGB);
+}
+// gqɉēǂݍ
+static HRESULT LoadImageFile(const char* fileName, DirectX::TexMetadata* pMetadata, DirectX::ScratchImage& image)
+{
+	// ϊ
+	wchar_t wPath[MAX_PATH];
+	MultiByteToWideChar(0, 0, fileName, -1, wPath, MAX_PATH);
+
+	if (strstr(fileName, ".dds"))
+		return DirectX::LoadFromDDSFile(wPath, DirectX::DDS_FLAGS_NONE, pMetadata, image);
+	else if (strstr(fileName, ".tga"))
+		return DirectX::LoadFromTGAFile(wPath, pMetadata, image);
+	else
+		return DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, pMetadata, image);
+}
+static HRESULT WriteCookFile(const char* cookPath, const std::vector<uint8_t>& dds)
+{
+	CreateDirectoryA(TEXTURE_CACHE_DIR, NULL);
+	FILE* fp = nullptr;
+	fopen_s(&fp, cookPath, "wb");
+	if (!fp) { return E_FAIL; }
+	fwrite(dds.data(), dds.size(), 1, fp);
+	fclose(fp);
+	return S_OK;
+}
+// ǂݍ񂾉摜RGBA8ɑDDS֕ϊ(F̃eNX`ƂăK}lďk
+static HRESULT CookImage(const char* fileName, const DirectX::ScratchImage& image, const DirectX::TexMetadata& mdata,
+	TextureCook::Format format, std::vector<uint8_t>* pDDS)
+{
+	// sRGB̃tH[}bg͂̂܂܈(UNORM֕ϊƃK}O邽
+	bool isSRGB = DirectX::IsSRGB(mdata.format);
+	DXGI_FORMAT rgba = isSRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+	const DirectX::Image* pImage = image.GetImage(0, 0, 0);
+	DirectX::ScratchImage converted;
+	if (mdata.format != rgba)
+	{
+		HRESULT hr = DirectX::Convert(*pImage, rgba, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+		if (FAILED(hr)) { return hr; }
+		pImage = converted.GetImage(0, 0, 0);
+	}
+
+	// s̊Ԃɗ]ꍇ͋l߂
+	UINT width = static_cast<UINT>(pImage->width);
+	UINT height = static_cast<UINT>(pImage->height);
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	for (UINT y = 0; y < height; ++y)
+		memcpy(&pixels[static_cast<size_t>(y) * width * 4], pImage->pixels + y * pImage->rowPitch, width * 4);
+
+	TextureCook::Cook(pixels.data(), width, height, format, true, isSRGB, pDDS,
+		TextureCook::MakeKey(fileName, format, isSRGB));
+	return pDDS->empty() ? E_FAIL : S_OK;
+}
 
 /// <summary>
 /// eNX`
 /// </summary>
 Texture::Texture()
-	: m_width(0), m_height(0)
+	: m_id(++m_idCount)
+	, m_width(0), m_height(0)
 	, m_pTex(nullptr)
 	, m_pSRV(nullptr)
 {
 }
 Texture::~Texture()
 {
+	for (size_t i = 0; i < m_releaseCallbacks.size(); ++i)
+		m_releaseCallbacks[i](this);
 	SAFE_RELEASE(m_pSRV);
 	SAFE_RELEASE(m_pTex);
 }
@@ -19,20 +116,35 @@ HRESULT Texture::Create(const char* fileName)
 {
 	HRESULT hr = S_OK;
 
-	// ϊ
-	wchar_t wPath[MAX_PATH];
-	size_t wLen = 0;
-	MultiByteToWideChar(0, 0, fileName, -1, wPath, MAX_PATH);
-
-	// t@Cʓǂݍ
+	// ϊς݂̃t@CΗD悵Ďgp
 	DirectX::TexMetadata mdata;
 	DirectX::ScratchImage image;
-	if (strstr(fileName, ".tga"))
-		hr = DirectX::LoadFromTGAFile(wPath, &mdata, image);
+	std::string cookPath = MakeCookPath(fileName, m_cookFormat);
+	if (m_isCook && IsCookValid(fileName, cookPath.c_str(), m_cookFormat))
+		hr = LoadImageFile(cookPath.c_str(), &mdata, image);
 	else
-		hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, &mdata, image);
-	if (FAILED(hr)) {
-		return E_FAIL;
+		hr = E_FAIL;
+
+	// t@Cʓǂݍ
+	if (FAILED(hr))
+	{
+		hr = LoadImageFile(fileName, &mdata, image);
+		if (FAILED(hr)) {
+			return E_FAIL;
+		}
+
+		// ~bv}bv̍쐬ƈksA񂩂gpt@Co
+		if (m_isCook && mdata.mipLevels == 1 && !DirectX::IsCompressed(mdata.format))
+		{
+			std::vector<uint8_t> dds;
+			if (SUCCEEDED(CookImage(fileName, image, mdata, m_cookFormat, &dds)))
+			{
+				WriteCookFile(cookPath.c_str(), dds);
+				DirectX::ScratchImage cooked;
+				if (SUCCEEDED(DirectX::LoadFromDDSMemory(dds.data(), dds.size(), DirectX::DDS_FLAGS_NONE, &mdata, cooked)))
+					image = std::move(cooked);
+			}
+		}
 	}
 
 	// VF[_\[X
@@ -62,6 +174,47 @@ ID3D11ShaderResourceView* Texture::GetResource() const
 {
 	return m_pSRV;
 }
+UINT Texture::GetID() const
+{
+	return m_id;
+}
+void Texture::SetCook(bool isCook, TextureCook::Format format)
+{
+	m_isCook = isCook;
+	m_cookFormat = format;
+}
+HRESULT Texture::CookFile(const char* fileName, std::string* pCookPath)
+{
+	*pCookPath = MakeCookPath(fileName, m_cookFormat);
+	if (IsCookValid(fileName, pCookPath->c_str(), m_cookFormat)) { return S_OK; }
+
+	DirectX::TexMetadata mdata;
+	DirectX::ScratchImage image;
+	HRESULT hr = LoadImageFile(fileName, &mdata, image);
+	if (FAILED(hr)) { return hr; }
+	if (mdata.mipLevels != 1 || DirectX::IsCompressed(mdata.format)) { return E_FAIL; }
+
+	std::vector<uint8_t> dds;
+	hr = CookImage(fileName, image, mdata, m_cookFormat, &dds);
+	if (FAILED(hr)) { return hr; }
+	return WriteCookFile(pCookPath->c_str(), dds);
+}
+
+void Texture::AddReleaseCallback(ReleaseCallback func)
+{
+	m_releaseCallbacks.push_back(func);
+}
+void Texture::RemoveReleaseCallback(ReleaseCallback func)
+{
+	for (auto it = m_releaseCallbacks.begin(); it != m_releaseCallbacks.end(); ++it)
+	{
+		if (*it == func)
+		{
+			m_releaseCallbacks.erase(it);
+			return;
+		}
+	}
+}
 
 D3D11_TEXTURE2D_DESC Texture::MakeTexDesc(DXGI_FORMAT format, UINT width, UINT height)
 {
@@ -2,12 +2,19 @@
 #define __TEXTURE_H__
 
 #include "DirectX.h"
+#include "TextureCook.h"
+#include <string>
+#include <vector>
 
 /// <summary>
 /// eNX`
 /// </summary>
 class Texture
 {
+public:
+	// j̒OɌĂяo(ێĂeNX`O
+	using ReleaseCallback = void(*)(Texture* pTexture);
+
 public:
 	Texture();
 	virtual ~Texture();
@@ -17,16 +24,37 @@ public:
 	UINT GetWidth() const;
 	UINT GetHeight() const;
 	ID3D11ShaderResourceView* GetResource() const;
+	UINT GetID() const;
+
+	// 摜t@Cǂݍݎ̕ϊݒ(Ԃ͖
+	// LȏꍇAϊς݂DDS(~bv}bvAubNk)΂ǂݍ݁A
+	// ȂΕϊďoĂgp
+	// ϊς݂DDS͌̃pX̃nbVƗvtH[}bgƂɕʂ̃t@CƂȂ
+	static void SetCook(bool isCook, TextureCook::Format format = TextureCook::FORMAT_AUTO);
+	// ϊς݂DDSpӂăpXԂ(ϊłȂ`̏ꍇ͎s
+	// LA̐ݒɊ֌WȂϊ(f̃eNX`̒iKIȓǂݍ݂Ŏgp
+	static HRESULT CookFile(const char* fileName, std::string* pCookPath);
+
+	// j̏̓o^A
+	static void AddReleaseCallback(ReleaseCallback func);
+	static void RemoveReleaseCallback(ReleaseCallback func);
 
 protected:
 	D3D11_TEXTURE2D_DESC MakeTexDesc(DXGI_FORMAT format, UINT width, UINT height);
 	virtual HRESULT CreateResource(D3D11_TEXTURE2D_DESC &desc, const void* pData);
 
 protected:
+	UINT m_id;		///< ʔԍ(`̕ёւɎgp
 	UINT m_width;	///< 
 	UINT m_height;	///< c
 	ID3D11ShaderResourceView *m_pSRV;
 	ID3D11Texture2D* m_pTex;
+
+private:
+	static UINT m_idCount;
+	static bool m_isCook;
+	static TextureCook::Format m_cookFormat;
+	static std::vector<ReleaseCallback> m_releaseCallbacks;
 };
 
 /// <summary>
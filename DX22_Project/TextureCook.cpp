@@ -0,0 +1,789 @@
+#include "TextureCook.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//--- DDS̒`(ddraw.hAdxgiformat.hg킸ɋLq
+static const uint32_t DDS_MAGIC				= 0x20534444;	// "DDS "
+static const uint32_t DDS_FOURCC_DX10		= 0x30315844;	// "DX10"
+static const uint32_t DDSD_CAPS				= 0x1;
+static const uint32_t DDSD_HEIGHT			= 0x2;
+static const uint32_t DDSD_WIDTH			= 0x4;
+static const uint32_t DDSD_PIXELFORMAT		= 0x1000;
+static const uint32_t DDSD_MIPMAPCOUNT		= 0x20000;
+static const uint32_t DDSD_LINEARSIZE		= 0x80000;
+static const uint32_t DDPF_FOURCC			= 0x4;
+static const uint32_t DDSCAPS_COMPLEX		= 0x8;
+static const uint32_t DDSCAPS_TEXTURE		= 0x1000;
+static const uint32_t DDSCAPS_MIPMAP		= 0x400000;
+static const uint32_t DDS_DIMENSION_TEXTURE2D	= 3;
+static const uint32_t DDS_ALPHA_MODE_STRAIGHT	= 1;
+
+// DXGI_FORMAT̒l(UNORMA+1UNORM_SRGB
+static const uint32_t DXGI_RGBA8	= 28;
+static const uint32_t DXGI_BC1		= 71;
+static const uint32_t DXGI_BC3		= 77;
+static const uint32_t DXGI_BC7		= 98;
+
+struct DDSPixelFormat
+{
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t mask[4];
+};
+struct DDSHeader
+{
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	DDSPixelFormat ddspf;
+	uint32_t caps[4];
+	uint32_t reserved2;
+};
+struct DDSHeaderDX10
+{
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+
+// BC74bitԍ̕Ԃ̏d(/64
+static const int BC7_WEIGHT[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+//----------
+// ʏ
+//----------
+// 0`num-1󂢂ĂXbh珇ɏ(minNum: 1Xbh̍ŏ̐
+template<class Func>
+static void ParallelFor(uint32_t num, uint32_t minNum, Func func)
+{
+	std::atomic<uint32_t> next(0);
+	auto worker = [&]() {
+		uint32_t i;
+		while ((i = next++) < num)
+			func(i);
+	};
+	uint32_t threadNum = std::min(std::max(std::thread::hardware_concurrency(), 1u), num / minNum);
+	std::vector<std::future<void>> tasks;
+	for (uint32_t i = 1; i < threadNum; ++i)
+		tasks.push_back(std::async(std::launch::async, worker));
+	worker();
+	for (size_t i = 0; i < tasks.size(); ++i)
+		tasks[i].get();
+}
+
+// sRGBƐ`̕ϊe[u
+struct GammaTable
+{
+	static const int LINEAR_STEP = 4096;	// `߂ۂ̕(Â1iȓ̌덷
+	float	toLinear[256];
+	uint8_t	toSRGB[LINEAR_STEP];
+
+	GammaTable()
+	{
+		for (int i = 0; i < 256; ++i)
+		{
+			float c = i / 255.0f;
+			toLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+		}
+		for (int i = 0; i < LINEAR_STEP; ++i)
+		{
+			float c = i / static_cast<float>(LINEAR_STEP - 1);
+			float s = c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+			toSRGB[i] = static_cast<uint8_t>(std::min(std::max(s, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+	}
+};
+static const GammaTable& GetGamma()
+{
+	static const GammaTable table;
+	return table;
+}
+
+// 听̕ɉ[߂(channels: gp`l
+static void FitLine(const float (*pPixels)[4], int channels, float* pA, float* pB)
+{
+	float mean[4] = {};
+	float minV[4] = { 255.0f, 255.0f, 255.0f, 255.0f };
+	float maxV[4] = {};
+	for (int i = 0; i < 16; ++i)
+	{
+		for (int c = 0; c < channels; ++c)
+		{
+			mean[c] += pPixels[i][c] / 16.0f;
+			minV[c] = std::min(minV[c], pPixels[i][c]);
+			maxV[c] = std::max(maxV[c], pPixels[i][c]);
+		}
+	}
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; ++i)
+	{
+		float d[4] = {};
+		for (int c = 0; c < channels; ++c)
+			d[c] = pPixels[i][c] - mean[c];
+		for (int j = 0; j < channels; ++j)
+			for (int k = 0; k < channels; ++k)
+				cov[j][k] += d[j] * d[k];
+	}
+
+	// ׂ@ōłȖ傫߂(l͒l͈̔
+	float axis[4] = {};
+	for (int c = 0; c < channels; ++c)
+		axis[c] = maxV[c] - minV[c];
+	for (int iter = 0; iter < 8; ++iter)
+	{
+		float next[4] = {};
+		float scale = 0.0f;
+		for (int j = 0; j < channels; ++j)
+		{
+			for (int k = 0; k < channels; ++k)
+				next[j] += cov[j][k] * axis[k];
+			scale = std::max(scale, fabsf(next[j]));
+		}
+		if (scale <= 0.0f) { break; }
+		for (int c = 0; c < channels; ++c)
+			axis[c] = next[c] / scale;
+	}
+	float len = 0.0f;
+	for (int c = 0; c < channels; ++c)
+		len += axis[c] * axis[c];
+	if (len <= 0.0f)
+	{
+		for (int c = 0; c < 4; ++c)
+			pA[c] = pB[c] = mean[c];
+		return;
+	}
+	len = 1.0f / sqrtf(len);
+	for (int c = 0; c < channels; ++c)
+		axis[c] *= len;
+
+	// ̍ŏAő̈ʒu[_Ƃ
+	float minT = 0.0f, maxT = 0.0f;
+	for (int i = 0; i < 16; ++i)
+	{
+		float t = 0.0f;
+		for (int c = 0; c < channels; ++c)
+			t += (pPixels[i][c] - mean[c]) * axis[c];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	for (int c = 0; c < 4; ++c)
+	{
+		pA[c] = c < channels ? std::min(std::max(mean[c] + axis[c] * minT, 0.0f), 255.0f) : mean[c];
+		pB[c] = c < channels ? std::min(std::max(mean[c] + axis[c] * maxT, 0.0f), 255.0f) : mean[c];
+	}
+}
+
+// I񂾔ԍ̕Ԉʒu(pT: 0AA1B)A[_ŏŋߒ
+static bool RefitLine(const float (*pPixels)[4], int channels, const uint8_t* pIndex, const float* pT, float* pA, float* pB)
+{
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ax[4] = {}, bx[4] = {};
+	for (int i = 0; i < 16; ++i)
+	{
+		float t = pT[pIndex[i]];
+		float s = 1.0f - t;
+		aa += s * s;
+		ab += s * t;
+		bb += t * t;
+		for (int c = 0; c < channels; ++c)
+		{
+			ax[c] += s * pPixels[i][c];
+			bx[c] += t * pPixels[i][c];
+		}
+	}
+	float det = aa * bb - ab * ab;
+	if (fabsf(det) < 1.0e-6f) { return false; }
+	det = 1.0f / det;
+	for (int c = 0; c < channels; ++c)
+	{
+		pA[c] = std::min(std::max((bb * ax[c] - ab * bx[c]) * det, 0.0f), 255.0f);
+		pB[c] = std::min(std::max((aa * bx[c] - ab * ax[c]) * det, 0.0f), 255.0f);
+	}
+	return true;
+}
+
+
+//----------
+// BC1(BC3̐F
+//----------
+static uint16_t To565(const float* pColor)
+{
+	uint16_t r = static_cast<uint16_t>(pColor[0] * 31.0f / 255.0f + 0.5f);
+	uint16_t g = static_cast<uint16_t>(pColor[1] * 63.0f / 255.0f + 0.5f);
+	uint16_t b = static_cast<uint16_t>(pColor[2] * 31.0f / 255.0f + 0.5f);
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+static void From565(uint16_t color, int* pColor)
+{
+	int r = (color >> 11) & 0x1f;
+	int g = (color >> 5) & 0x3f;
+	int b = color & 0x1f;
+	pColor[0] = (r << 3) | (r >> 2);
+	pColor[1] = (g << 2) | (g >> 4);
+	pColor[2] = (b << 3) | (b >> 2);
+}
+// [_Ԃ4F̂ł߂FIсA덷̍vԂ
+static int SelectColor(const float (*pPixels)[4], uint16_t c0, uint16_t c1, uint8_t* pIndex)
+{
+	int pal[4][3];
+	From565(c0, pal[0]);
+	From565(c1, pal[1]);
+	for (int c = 0; c < 3; ++c)
+	{
+		pal[2][c] = (pal[0][c] * 2 + pal[1][c]) / 3;
+		pal[3][c] = (pal[0][c] + pal[1][c] * 2) / 3;
+	}
+	int total = 0;
+	for (int i = 0; i < 16; ++i)
+	{
+		int best = INT32_MAX;
+		for (int j = 0; j < 4; ++j)
+		{
+			int err = 0;
+			for (int c = 0; c < 3; ++c)
+			{
+				int d = static_cast<int>(pPixels[i][c]) - pal[j][c];
+				err += d * d;
+			}
+			if (err < best)
+			{
+				best = err;
+				pIndex[i] = static_cast<uint8_t>(j);
+			}
+		}
+		total += best;
+	}
+	return total;
+}
+static void EncodeColor(const float (*pPixels)[4], uint8_t* pOut)
+{
+	static const float T[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	float a[4], b[4];
+	FitLine(pPixels, 3, a, b);
+	uint16_t c0 = To565(a);
+	uint16_t c1 = To565(b);
+	uint8_t index[16];
+	int err = SelectColor(pPixels, c0, c1, index);
+
+	// I񂾔ԍ[_ߒA덷Ύgp
+	if (c0 != c1 && RefitLine(pPixels, 3, index, T, a, b))
+	{
+		uint16_t r0 = To565(a);
+		uint16_t r1 = To565(b);
+		uint8_t refit[16];
+		if (SelectColor(pPixels, r0, r1, refit) < err)
+		{
+			c0 = r0;
+			c1 = r1;
+			memcpy(index, refit, sizeof(index));
+		}
+	}
+
+	// c0 > c1 4F̕ԂɂȂ(ꍇׂ͂Ē[_̐F
+	if (c0 < c1)
+	{
+		std::swap(c0, c1);
+		for (int i = 0; i < 16; ++i)
+			index[i] ^= 1;
+	}
+	uint32_t bits = 0;
+	if (c0 != c1)
+	{
+		for (int i = 0; i < 16; ++i)
+			bits |= static_cast<uint32_t>(index[i]) << (i * 2);
+	}
+	pOut[0] = static_cast<uint8_t>(c0);
+	pOut[1] = static_cast<uint8_t>(c0 >> 8);
+	pOut[2] = static_cast<uint8_t>(c1);
+	pOut[3] = static_cast<uint8_t>(c1 >> 8);
+	for (int i = 0; i < 4; ++i)
+		pOut[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+}
+
+
+//----------
+// BC3̃At@
+//----------
+static void EncodeAlpha(const float (*pPixels)[4], uint8_t* pOut)
+{
+	int a0 = 0, a1 = 255;
+	for (int i = 0; i < 16; ++i)
+	{
+		a0 = std::max(a0, static_cast<int>(pPixels[i][3]));
+		a1 = std::min(a1, static_cast<int>(pPixels[i][3]));
+	}
+
+	// a0 > a1 8iK̕ԂɂȂ(ꍇׂ͂a0
+	uint64_t bits = 0;
+	if (a0 > a1)
+	{
+		int pal[8] = { a0, a1 };
+		for (int i = 1; i < 7; ++i)
+			pal[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+		for (int i = 0; i < 16; ++i)
+		{
+			int best = INT32_MAX;
+			uint64_t index = 0;
+			for (int j = 0; j < 8; ++j)
+			{
+				int d = abs(static_cast<int>(pPixels[i][3]) - pal[j]);
+				if (d < best)
+				{
+					best = d;
+					index = j;
+				}
+			}
+			bits |= index << (i * 3);
+		}
+	}
+	pOut[0] = static_cast<uint8_t>(a0);
+	pOut[1] = static_cast<uint8_t>(a1);
+	for (int i = 0; i < 6; ++i)
+		pOut[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+}
+
+
+//----------
+// BC7([h6: 1̈ARGBAe7bit+prbg̒[_A4bit̔ԍ
+//----------
+// [_7bitprbg֗ʎq(덷̏ȂprbgI
+static void QuantizeBC7(const float* pColor, uint8_t* pQuant, uint8_t* pBit)
+{
+	float bestErr = FLT_MAX;
+	for (uint8_t p = 0; p < 2; ++p)
+	{
+		uint8_t q[4];
+		float err = 0.0f;
+		for (int c = 0; c < 4; ++c)
+		{
+			int v = static_cast<int>((pColor[c] - p) * 0.5f + 0.5f);
+			q[c] = static_cast<uint8_t>(std::min(std::max(v, 0), 127));
+			float d = (q[c] * 2 + p) - pColor[c];
+			err += d * d;
+		}
+		if (err < bestErr)
+		{
+			bestErr = err;
+			memcpy(pQuant, q, 4);
+			*pBit = p;
+		}
+	}
+}
+// [_Ԃ16F̂ł߂FIсA덷̍vԂ
+static float SelectBC7(const float (*pPixels)[4], const uint8_t* pQuant0, uint8_t p0,
+	const uint8_t* pQuant1, uint8_t p1, uint8_t* pIndex)
+{
+	DirectX::XMVECTOR pal[16];
+	for (int j = 0; j < 16; ++j)
+	{
+		float c[4];
+		for (int k = 0; k < 4; ++k)
+		{
+			int e0 = pQuant0[k] * 2 + p0;
+			int e1 = pQuant1[k] * 2 + p1;
+			c[k] = static_cast<float>(((64 - BC7_WEIGHT[j]) * e0 + BC7_WEIGHT[j] * e1 + 32) >> 6);
+		}
+		pal[j] = DirectX::XMVectorSet(c[0], c[1], c[2], c[3]);
+	}
+	float total = 0.0f;
+	for (int i = 0; i < 16; ++i)
+	{
+		DirectX::XMVECTOR v = DirectX::XMVectorSet(pPixels[i][0], pPixels[i][1], pPixels[i][2], pPixels[i][3]);
+		float best = FLT_MAX;
+		for (int j = 0; j < 16; ++j)
+		{
+			float err = DirectX::XMVectorGetX(DirectX::XMVector4LengthSq(DirectX::XMVectorSubtract(v, pal[j])));
+			if (err < best)
+			{
+				best = err;
+				pIndex[i] = static_cast<uint8_t>(j);
+			}
+		}
+		total += best;
+	}
+	return total;
+}
+// bit珇ɏ
+struct BitWriter
+{
+	uint8_t* pOut;
+	uint32_t pos;
+	void Write(uint32_t value, uint32_t bits)
+	{
+		for (uint32_t i = 0; i < bits; ++i, ++pos)
+		{
+			if ((value >> i) & 1)
+				pOut[pos >> 3] |= static_cast<uint8_t>(1 << (pos & 7));
+		}
+	}
+};
+static void EncodeBC7(const float (*pPixels)[4], uint8_t* pOut)
+{
+	static const float T[16] = {
+		 0 / 64.0f,  4 / 64.0f,  9 / 64.0f, 13 / 64.0f, 17 / 64.0f, 21 / 64.0f, 26 / 64.0f, 30 / 64.0f,
+		34 / 64.0f, 38 / 64.0f, 43 / 64.0f, 47 / 64.0f, 51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 64 / 64.0f,
+	};
+
+	float a[4], b[4];
+	FitLine(pPixels, 4, a, b);
+	uint8_t q[2][4], p[2];
+	QuantizeBC7(a, q[0], &p[0]);
+	QuantizeBC7(b, q[1], &p[1]);
+	uint8_t index[16];
+	float err = SelectBC7(pPixels, q[0], p[0], q[1], p[1], index);
+
+	// I񂾔ԍ[_ߒA덷Ύgp
+	if (RefitLine(pPixels, 4, index, T, a, b))
+	{
+		uint8_t rq[2][4], rp[2], refit[16];
+		QuantizeBC7(a, rq[0], &rp[0]);
+		QuantizeBC7(b, rq[1], &rp[1]);
+		if (SelectBC7(pPixels, rq[0], rp[0], rq[1], rp[1], refit) < err)
+		{
+			memcpy(q, rq, sizeof(q));
+			memcpy(p, rp, sizeof(p));
+			memcpy(index, refit, sizeof(index));
+		}
+	}
+
+	// 擪̃sNZ̔ԍ͍ŏbitȗ邽߁A8ȏȂ[_ւĔԍ𔽓]
+	if (index[0] >= 8)
+	{
+		for (int c = 0; c < 4; ++c)
+			std::swap(q[0][c], q[1][c]);
+		std::swap(p[0], p[1]);
+		for (int i = 0; i < 16; ++i)
+			index[i] = static_cast<uint8_t>(15 - index[i]);
+	}
+
+	// [h(0000001) > [_(R0,R1,G0,G1,B0,B1,A0,A1) > prbg > ԍ
+	memset(pOut, 0, 16);
+	BitWriter writer = { pOut, 0 };
+	writer.Write(1 << 6, 7);
+	for (int c = 0; c < 4; ++c)
+	{
+		writer.Write(q[0][c], 7);
+		writer.Write(q[1][c], 7);
+	}
+	writer.Write(p[0], 1);
+	writer.Write(p[1], 1);
+	writer.Write(index[0], 3);
+	for (int i = 1; i < 16; ++i)
+		writer.Write(index[i], 4);
+}
+
+
+//----------
+// TextureCook
+//----------
+void TextureCook::GenerateMips(const uint8_t* pRGBA, uint32_t width, uint32_t height,
+	bool gammaCorrect, std::vector<Image>* pMips)
+{
+	const GammaTable& gamma = GetGamma();
+
+	pMips->clear();
+	pMips->push_back(Image());
+	Image& top = pMips->back();
+	top.width = width;
+	top.height = height;
+	top.data.assign(pRGBA, pRGBA + static_cast<size_t>(width) * height * 4);
+
+	// At@Z`̒lŏk(̐Fɂɂ܂Ȃ悤
+	std::vector<DirectX::XMFLOAT4> src(static_cast<size_t>(width) * height);
+	std::vector<DirectX::XMFLOAT4> dst;
+	for (size_t i = 0; i < src.size(); ++i)
+	{
+		const uint8_t* p = pRGBA + i * 4;
+		float alpha = p[3] / 255.0f;
+		for (int c = 0; c < 3; ++c)
+		{
+			float v = gammaCorrect ? gamma.toLinear[p[c]] : p[c] / 255.0f;
+			(&src[i].x)[c] = v * alpha;
+		}
+		src[i].w = alpha;
+	}
+
+	while (width > 1 || height > 1)
+	{
+		uint32_t w = std::max(width / 2, 1u);
+		uint32_t h = std::max(height / 2, 1u);
+		dst.resize(static_cast<size_t>(w) * h);
+		Image mip;
+		mip.width = w;
+		mip.height = h;
+		mip.data.resize(static_cast<size_t>(w) * h * 4);
+
+		// 2x2̕(̏ꍇ͒[̃sNZJԂ
+		ParallelFor(h, 16, [&](uint32_t y) {
+			const DirectX::XMFLOAT4* pRow0 = &src[static_cast<size_t>(std::min(y * 2, height - 1)) * width];
+			const DirectX::XMFLOAT4* pRow1 = &src[static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width];
+			DirectX::XMFLOAT4* pDst = &dst[static_cast<size_t>(y) * w];
+			uint8_t* pOut = &mip.data[static_cast<size_t>(y) * w * 4];
+			for (uint32_t x = 0; x < w; ++x)
+			{
+				uint32_t x0 = std::min(x * 2, width - 1);
+				uint32_t x1 = std::min(x * 2 + 1, width - 1);
+				DirectX::XMVECTOR v = DirectX::XMVectorAdd(
+					DirectX::XMVectorAdd(DirectX::XMLoadFloat4(&pRow0[x0]), DirectX::XMLoadFloat4(&pRow0[x1])),
+					DirectX::XMVectorAdd(DirectX::XMLoadFloat4(&pRow1[x0]), DirectX::XMLoadFloat4(&pRow1[x1])));
+				v = DirectX::XMVectorScale(v, 0.25f);
+				DirectX::XMStoreFloat4(&pDst[x], v);
+
+				// At@̏Z߂8bit
+				float alpha = DirectX::XMVectorGetW(v);
+				DirectX::XMFLOAT4 color;
+				DirectX::XMStoreFloat4(&color, DirectX::XMVectorSaturate(
+					alpha > 0.0f ? DirectX::XMVectorScale(v, 1.0f / alpha) : DirectX::XMVectorZero()));
+				for (int c = 0; c < 3; ++c)
+				{
+					float value = (&color.x)[c];
+					pOut[x * 4 + c] = gammaCorrect ?
+						gamma.toSRGB[static_cast<int>(value * (GammaTable::LINEAR_STEP - 1) + 0.5f)] :
+						static_cast<uint8_t>(value * 255.0f + 0.5f);
+				}
+				pOut[x * 4 + 3] = static_cast<uint8_t>(std::min(alpha, 1.0f) * 255.0f + 0.5f);
+			}
+		});
+
+		pMips->push_back(std::move(mip));
+		src.swap(dst);
+		width = w;
+		height = h;
+	}
+}
+
+void TextureCook::Compress(const Image& src, Format format, Image* pDst)
+{
+	pDst->width = src.width;
+	pDst->height = src.height;
+	uint32_t blockSize = GetBlockSize(format);
+	if (blockSize == 0)
+	{
+		pDst->data = src.data;
+		return;
+	}
+
+	uint32_t blockX = (src.width + 3) / 4;
+	uint32_t blockY = (src.height + 3) / 4;
+	pDst->data.resize(static_cast<size_t>(blockX) * blockY * blockSize);
+	ParallelFor(blockY, 4, [&](uint32_t by) {
+		for (uint32_t bx = 0; bx < blockX; ++bx)
+		{
+			// 4x4sNZo(摜̊O͒[̃sNZ
+			float pixels[16][4];
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t x = std::min(bx * 4 + (i & 3), src.width - 1);
+				uint32_t y = std::min(by * 4 + (i >> 2), src.height - 1);
+				const uint8_t* p = &src.data[(static_cast<size_t>(y) * src.width + x) * 4];
+				for (int c = 0; c < 4; ++c)
+					pixels[i][c] = p[c];
+			}
+
+			uint8_t* pOut = &pDst->data[(static_cast<size_t>(by) * blockX + bx) * blockSize];
+			switch (format)
+			{
+			case FORMAT_BC1:
+				EncodeColor(pixels, pOut);
+				break;
+			case FORMAT_BC3:
+				EncodeAlpha(pixels, pOut);
+				EncodeColor(pixels, pOut + 8);
+				break;
+			case FORMAT_BC7:
+				EncodeBC7(pixels, pOut);
+				break;
+			default:
+				break;
+			}
+		}
+	});
+}
+
+void TextureCook::MakeDDS(const std::vector<Image>& mips, Format format, bool isSRGB, std::vector<uint8_t>* pOut, uint64_t key)
+{
+	pOut->clear();
+	if (mips.empty()) { return; }
+
+	uint32_t dxgiFormat;
+	switch (format)
+	{
+	case FORMAT_BC1:	dxgiFormat = DXGI_BC1;	break;
+	case FORMAT_BC3:	dxgiFormat = DXGI_BC3;	break;
+	case FORMAT_BC7:	dxgiFormat = DXGI_BC7;	break;
+	default:			dxgiFormat = DXGI_RGBA8;	break;
+	}
+	if (isSRGB)
+		++dxgiFormat;
+
+	DDSHeader header = {};
+	header.size = sizeof(DDSHeader);
+	header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+	header.height = mips[0].height;
+	header.width = mips[0].width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(mips[0].data.size());
+	header.mipMapCount = static_cast<uint32_t>(mips.size());
+	header.ddspf.size = sizeof(DDSPixelFormat);
+	header.ddspf.flags = DDPF_FOURCC;
+	header.ddspf.fourCC = DDS_FOURCC_DX10;
+	header.caps[0] = DDSCAPS_TEXTURE | (mips.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+	header.reserved1[0] = static_cast<uint32_t>(key);
+	header.reserved1[1] = static_cast<uint32_t>(key >> 32);
+
+	DDSHeaderDX10 dx10 = {};
+	dx10.dxgiFormat = dxgiFormat;
+	dx10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+	dx10.arraySize = 1;
+	dx10.miscFlags2 = DDS_ALPHA_MODE_STRAIGHT;
+
+	size_t size = sizeof(DDS_MAGIC) + sizeof(header) + sizeof(dx10);
+	for (size_t i = 0; i < mips.size(); ++i)
+		size += mips[i].data.size();
+	pOut->resize(size);
+	uint8_t* p = pOut->data();
+	memcpy(p, &DDS_MAGIC, sizeof(DDS_MAGIC));	p += sizeof(DDS_MAGIC);
+	memcpy(p, &header, sizeof(header));			p += sizeof(header);
+	memcpy(p, &dx10, sizeof(dx10));				p += sizeof(dx10);
+	for (size_t i = 0; i < mips.size(); ++i)
+	{
+		memcpy(p, mips[i].data.data(), mips[i].data.size());
+		p += mips[i].data.size();
+	}
+}
+
+TextureCook::Format TextureCook::Cook(const uint8_t* pRGBA, uint32_t width, uint32_t height, Format format,
+	bool gammaCorrect, bool isSRGB, std::vector<uint8_t>* pDDS, uint64_t key)
+{
+	if (format == FORMAT_AUTO)
+		format = HasAlpha(pRGBA, width, height) ? FORMAT_BC3 : FORMAT_BC1;
+	if (width % 4 != 0 || height % 4 != 0)
+		format = FORMAT_RGBA8;
+
+	std::vector<Image> mips;
+	GenerateMips(pRGBA, width, height, gammaCorrect, &mips);
+	if (format != FORMAT_RGBA8)
+	{
+		std::vector<Image> blocks(mips.size());
+		for (size_t i = 0; i < mips.size(); ++i)
+			Compress(mips[i], format, &blocks[i]);
+		mips.swap(blocks);
+	}
+	MakeDDS(mips, format, isSRGB, pDDS, key);
+	return format;
+}
+
+bool TextureCook::ReadDDSHeader(const void* pData, size_t size, DDSInfo* pInfo)
+{
+	if (size < DDS_HEADER_SIZE) { return false; }
+	const uint8_t* p = static_cast<const uint8_t*>(pData);
+	uint32_t magic;
+	DDSHeader header;
+	DDSHeaderDX10 dx10;
+	memcpy(&magic, p, sizeof(magic));
+	memcpy(&header, p + sizeof(magic), sizeof(header));
+	memcpy(&dx10, p + sizeof(magic) + sizeof(header), sizeof(dx10));
+	if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) ||
+		header.ddspf.fourCC != DDS_FOURCC_DX10 ||
+		dx10.resourceDimension != DDS_DIMENSION_TEXTURE2D || dx10.arraySize != 1)
+		return false;
+
+	// UNORMUNORM_SRGB͘A
+	static const uint32_t DXGI_LIST[] = { DXGI_RGBA8, DXGI_BC1, DXGI_BC3, DXGI_BC7 };
+	static const Format FORMAT_LIST[] = { FORMAT_RGBA8, FORMAT_BC1, FORMAT_BC3, FORMAT_BC7 };
+	int found = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (dx10.dxgiFormat == DXGI_LIST[i] || dx10.dxgiFormat == DXGI_LIST[i] + 1)
+			found = i;
+	}
+	if (found < 0) { return false; }
+	pInfo->format = FORMAT_LIST[found];
+	pInfo->isSRGB = dx10.dxgiFormat != DXGI_LIST[found];
+	pInfo->width = header.width;
+	pInfo->height = header.height;
+	pInfo->mipNum = (header.flags & DDSD_MIPMAPCOUNT) && header.mipMapCount ? header.mipMapCount : 1;
+	pInfo->key = header.reserved1[0] | (static_cast<uint64_t>(header.reserved1[1]) << 32);
+	return pInfo->width > 0 && pInfo->height > 0;
+}
+uint64_t TextureCook::HashPath(const char* path)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (const char* p = path; *p; ++p)
+	{
+		char c = *p;
+		if (c == '\\')
+			c = '/';
+		else if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+	}
+	return hash;
+}
+uint64_t TextureCook::MakeKey(const char* path, Format format, bool isSRGB)
+{
+	uint64_t hash = HashPath(path);
+	hash = (hash ^ static_cast<uint8_t>(format)) * 0x100000001b3ull;
+	hash = (hash ^ (isSRGB ? 1u : 0u)) * 0x100000001b3ull;
+	return hash ? hash : 1;	// 0͎ʒlȂ
+}
+
+uint32_t TextureCook::GetMipOffset(const DDSInfo& info, uint32_t mip)
+{
+	uint32_t offset = DDS_HEADER_SIZE;
+	for (uint32_t i = 0; i < mip; ++i)
+		offset += GetMipSize(info, i);
+	return offset;
+}
+uint32_t TextureCook::GetMipSize(const DDSInfo& info, uint32_t mip)
+{
+	uint32_t width = std::max(info.width >> mip, 1u);
+	uint32_t height = std::max(info.height >> mip, 1u);
+	uint32_t rows = GetBlockSize(info.format) ? (height + 3) / 4 : height;
+	return GetRowPitch(info.format, width) * rows;
+}
+uint32_t TextureCook::GetRowPitch(Format format, uint32_t width)
+{
+	uint32_t blockSize = GetBlockSize(format);
+	return blockSize ? (width + 3) / 4 * blockSize : width * 4;
+}
+
+bool TextureCook::HasAlpha(const uint8_t* pRGBA, uint32_t width, uint32_t height)
+{
+	size_t num = static_cast<size_t>(width) * height;
+	for (size_t i = 0; i < num; ++i)
+	{
+		if (pRGBA[i * 4 + 3] != 0xff)
+			return true;
+	}
+	return false;
+}
+
+uint32_t TextureCook::GetBlockSize(Format format)
+{
+	switch (format)
+	{
+	case FORMAT_BC1:	return 8;
+	case FORMAT_BC3:	return 16;
+	case FORMAT_BC7:	return 16;
+	default:			return 0;
+	}
+}
@@ -0,0 +1,78 @@
+#ifndef __TEXTURE_COOK_H__
+#define __TEXTURE_COOK_H__
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// eNX`̎Oϊ(CPÛ݂ŏAD3D11ɈˑȂ
+// E~bv}bv: At@Z`̒l(K}Ol)2x2sNZ𕽋ς1x1܂ō쐬
+// EubNk: 4x4sNZPʂBC1(s)ABC3ABC7([h6)֕ϊAubN̍sƂɕXbhŏ
+// EDDS: S~bv܂DDS(DX10wb_[)̓eɍ쐬
+class TextureCook
+{
+public:
+	enum Format
+	{
+		FORMAT_AUTO,	// sBC1ABC3
+		FORMAT_RGBA8,
+		FORMAT_BC1,		// ŝ(At@͖
+		FORMAT_BC3,
+		FORMAT_BC7,
+	};
+
+	// 1ỉ摜
+	struct Image
+	{
+		uint32_t width;
+		uint32_t height;
+		std::vector<uint8_t> data;	// RGBA8A͈kubN(ォs
+	};
+
+	// MakeDDSō쐬DDS̏
+	struct DDSInfo
+	{
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipNum;
+		Format format;
+		bool isSRGB;
+		uint64_t key;	// MakeDDSŎw肵ʒl
+	};
+	static const uint32_t DDS_HEADER_SIZE = 148;	// 擪̃~bv܂ł̑傫
+
+public:
+	// ~bv}bv̍쐬(pMips[0]͌摜̃Rs[
+	// gammaCorrect: lsRGBƂĈA`ɖ߂Ă畽ς
+	static void GenerateMips(const uint8_t* pRGBA, uint32_t width, uint32_t height,
+		bool gammaCorrect, std::vector<Image>* pMips);
+	// ubNk(4̔{ɖȂ[̃ubN͒[̃sNZJԂ
+	static void Compress(const Image& src, Format format, Image* pDst);
+	// DDSt@C̓e쐬(isSRGB: ǂݍݎsRGB̃tH[}bgƂĈ
+	// key: wb_[̗\̈ɋL^鎯ʒl(ϊς݃t@C̊mFɎgp
+	static void MakeDDS(const std::vector<Image>& mips, Format format, bool isSRGB, std::vector<uint8_t>* pOut, uint64_t key = 0);
+
+	// ~bv}bv̍쐬AkADDS̍쐬܂Ƃ߂čsAgptH[}bgԂ
+	// A4̔{łȂꍇ͈kRGBA8Ƃ
+	static Format Cook(const uint8_t* pRGBA, uint32_t width, uint32_t height, Format format,
+		bool gammaCorrect, bool isSRGB, std::vector<uint8_t>* pDDS, uint64_t key = 0);
+
+	// ̃pX̃nbV(؂/\A啶Ə͋ʂȂ
+	static uint64_t HashPath(const char* path);
+	// ϊς݃t@C̎ʒl(̃pXAvtH[}bgAsRGB̑gݍ킹
+	static uint64_t MakeKey(const char* path, Format format, bool isSRGB);
+
+	// DDS̃wb_[(MakeDDSō쐬`łȂfalse
+	static bool ReadDDSHeader(const void* pData, size_t size, DDSInfo* pInfo);
+	// ~bv̈ʒu(t@C擪)Ƒ傫
+	static uint32_t GetMipOffset(const DDSInfo& info, uint32_t mip);
+	static uint32_t GetMipSize(const DDSInfo& info, uint32_t mip);
+	// 1s(k̓ubN1s)̃oCg
+	static uint32_t GetRowPitch(Format format, uint32_t width);
+
+	static bool HasAlpha(const uint8_t* pRGBA, uint32_t width, uint32_t height);
+	// 1ubÑoCg(RGBA80
+	static uint32_t GetBlockSize(Format format);
+};
+
+#endif // __TEXTURE_COOK_H__
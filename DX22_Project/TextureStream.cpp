@@ -0,0 +1,389 @@
+#include "TextureStream.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+//--- ÓIo
+std::vector<StreamTexture*>	TextureStream::m_textures;
+UINT64						TextureStream::m_budget = TextureStream::DEFAULT_BUDGET;
+UINT						TextureStream::m_lowSize = TextureStream::DEFAULT_LOW_SIZE;
+UINT						TextureStream::m_frame = 0;
+TextureStream::Stats		TextureStream::m_stats;
+
+static DXGI_FORMAT ToDXGIFormat(const TextureCook::DDSInfo& info)
+{
+	switch (info.format)
+	{
+	case TextureCook::FORMAT_BC1:	return info.isSRGB ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+	case TextureCook::FORMAT_BC3:	return info.isSRGB ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+	case TextureCook::FORMAT_BC7:	return info.isSRGB ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+	default:						return info.isSRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+// t@C̈ꕔǂݍ
+static bool ReadFileRange(const char* path, UINT offset, UINT size, std::vector<uint8_t>* pOut)
+{
+	FILE* fp = nullptr;
+	fopen_s(&fp, path, "rb");
+	if (!fp) { return false; }
+	pOut->resize(size);
+	bool result = fseek(fp, offset, SEEK_SET) == 0 && fread(pOut->data(), 1, size, fp) == size;
+	fclose(fp);
+	return result;
+}
+
+//----------
+// StreamTexture
+//----------
+StreamTexture::StreamTexture()
+	: m_info()
+	, m_isStream(false)
+	, m_lowMip(0), m_residentMip(0), m_targetMip(0)
+	, m_bytes(0)
+	, m_requestSize(0.0f)
+	, m_lastUsedFrame(0)
+{
+}
+StreamTexture::~StreamTexture()
+{
+	if (m_isStream)
+	{
+		WaitLoad();
+		TextureStream::Unregister(this);
+	}
+}
+HRESULT StreamTexture::Create(const char* fileName)
+{
+	// ϊς݂DDSpӂłȂΒʏ̓ǂݍ
+	std::vector<uint8_t> header;
+	if (FAILED(Texture::CookFile(fileName, &m_path)) ||
+		!ReadFileRange(m_path.c_str(), 0, TextureCook::DDS_HEADER_SIZE, &header) ||
+		!TextureCook::ReadDDSHeader(header.data(), header.size(), &m_info))
+	{
+		return Texture::Create(fileName);
+	}
+
+	// c̑傫lowSizeȉɂȂ~bvŌ܂łǂݍł
+	// (k`͐擪̃~bv̏c4̔{łȂ΂ȂȂ
+	bool isBlock = TextureCook::GetBlockSize(m_info.format) != 0;
+	m_lowMip = 0;
+	while (m_lowMip + 1 < m_info.mipNum &&
+		std::max(m_info.width >> m_lowMip, m_info.height >> m_lowMip) > TextureStream::GetLowSize())
+	{
+		UINT w = m_info.width >> (m_lowMip + 1);
+		UINT h = m_info.height >> (m_lowMip + 1);
+		if (isBlock && (w == 0 || h == 0 || w % 4 != 0 || h % 4 != 0)) { break; }
+		++m_lowMip;
+	}
+	UINT offset = TextureCook::GetMipOffset(m_info, m_lowMip);
+	UINT size = TextureCook::GetMipOffset(m_info, m_info.mipNum) - offset;
+	Resource resource = {};
+	if (ReadFileRange(m_path.c_str(), offset, size, &m_lowData))
+		resource = CreateMips(m_lowMip, m_lowData.data());
+	if (!resource.pSRV)
+	{
+		m_lowData.clear();
+		return Texture::Create(fileName);
+	}
+
+	Replace(resource);
+	m_width = m_info.width;
+	m_height = m_info.height;
+	m_isStream = true;
+	m_targetMip = m_lowMip;
+	m_lastUsedFrame = TextureStream::GetFrame();
+	TextureStream::Register(this);
+	return S_OK;
+}
+
+void StreamTexture::Request(float screenSize)
+{
+	m_requestSize = std::max(m_requestSize, screenSize);
+	m_lastUsedFrame = TextureStream::GetFrame();
+}
+
+bool StreamTexture::IsStream() const
+{
+	return m_isStream;
+}
+UINT StreamTexture::GetMipNum() const
+{
+	return m_isStream ? m_info.mipNum : 1;
+}
+UINT StreamTexture::GetResidentMip() const
+{
+	return m_residentMip;
+}
+UINT StreamTexture::GetTargetMip() const
+{
+	return m_targetMip;
+}
+UINT64 StreamTexture::GetResidentBytes() const
+{
+	return m_bytes;
+}
+UINT StreamTexture::GetLastUsedFrame() const
+{
+	return m_lastUsedFrame;
+}
+
+// mipȍ~̃~bvŃeNX`쐬(pDatamip̐擪Ō̃~bv܂
+// foCX݂̂gp邽ߕʃXbhĂяoĂ悢
+StreamTexture::Resource StreamTexture::CreateMips(UINT mip, const uint8_t* pData) const
+{
+	Resource resource = { nullptr, nullptr, mip, 0 };
+	UINT mipNum = m_info.mipNum - mip;
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = std::max(m_info.width >> mip, 1u);
+	desc.Height = std::max(m_info.height >> mip, 1u);
+	desc.MipLevels = mipNum;
+	desc.ArraySize = 1;
+	desc.Format = ToDXGIFormat(m_info);
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	std::vector<D3D11_SUBRESOURCE_DATA> data(mipNum);
+	for (UINT i = 0; i < mipNum; ++i)
+	{
+		UINT size = TextureCook::GetMipSize(m_info, mip + i);
+		data[i].pSysMem = pData;
+		data[i].SysMemPitch = TextureCook::GetRowPitch(m_info.format, std::max(desc.Width >> i, 1u));
+		pData += size;
+		resource.bytes += size;
+	}
+	if (FAILED(GetDevice()->CreateTexture2D(&desc, data.data(), &resource.pTex)) ||
+		FAILED(GetDevice()->CreateShaderResourceView(resource.pTex, nullptr, &resource.pSRV)))
+	{
+		SAFE_RELEASE(resource.pTex);
+		resource.bytes = 0;
+	}
+	return resource;
+}
+// mipێĂ~bv̎O܂łt@Cǂݍō쐬(ʃXbhŎs
+StreamTexture::Resource StreamTexture::LoadMips(UINT mip) const
+{
+	if (mip >= m_lowMip)
+		return CreateMips(m_lowMip, m_lowData.data());
+
+	std::vector<uint8_t> data;
+	UINT offset = TextureCook::GetMipOffset(m_info, mip);
+	UINT lowOffset = TextureCook::GetMipOffset(m_info, m_lowMip);
+	if (!ReadFileRange(m_path.c_str(), offset, lowOffset - offset, &data))
+	{
+		Resource resource = { nullptr, nullptr, mip, 0 };
+		return resource;
+	}
+	data.insert(data.end(), m_lowData.begin(), m_lowData.end());
+	return CreateMips(mip, data.data());
+}
+void StreamTexture::Replace(const Resource& resource)
+{
+	SAFE_RELEASE(m_pSRV);
+	SAFE_RELEASE(m_pTex);
+	m_pTex = resource.pTex;
+	m_pSRV = resource.pSRV;
+	m_residentMip = resource.mip;
+	m_bytes = resource.bytes;
+}
+void StreamTexture::WaitLoad()
+{
+	if (!m_load.valid()) { return; }
+	Resource resource = m_load.get();
+	SAFE_RELEASE(resource.pSRV);
+	SAFE_RELEASE(resource.pTex);
+}
+
+
+//----------
+// TextureStream
+//----------
+void TextureStream::Init(UINT64 budget, UINT lowSize)
+{
+	m_budget = budget;
+	m_lowSize = lowSize;
+	m_frame = 0;
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.budget = budget;
+}
+void TextureStream::Uninit()
+{
+	for (size_t i = 0; i < m_textures.size(); ++i)
+		m_textures[i]->WaitLoad();
+	m_textures.clear();
+	m_textures.shrink_to_fit();
+}
+
+void TextureStream::Update()
+{
+	++m_frame;
+	m_stats.upgradeNum = 0;
+	m_stats.evictNum = 0;
+
+	// ǂݍ݂Îւ
+	for (size_t i = 0; i < m_textures.size(); ++i)
+	{
+		StreamTexture* pTex = m_textures[i];
+		if (pTex->m_load.valid() &&
+			pTex->m_load.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			StreamTexture::Resource resource = pTex->m_load.get();
+			if (resource.pSRV)
+			{
+				pTex->Replace(resource);
+				++m_stats.upgradeNum;
+			}
+		}
+	}
+
+	// Õt[Œʒmꂽ傫Kvȃ~bv߂
+	UINT64 videoBytes = 0;
+	UINT loadingNum = 0;
+	for (size_t i = 0; i < m_textures.size(); ++i)
+	{
+		StreamTexture* pTex = m_textures[i];
+		pTex->m_targetMip = CalcTargetMip(pTex);
+		pTex->m_requestSize = 0.0f;
+		videoBytes += pTex->m_bytes;
+		if (pTex->m_load.valid())
+			++loadingNum;
+	}
+
+	// \Z𒴂Ă΁A΂炭gĂȂ̂珬~bv֖߂
+	if (videoBytes > m_budget)
+	{
+		std::vector<StreamTexture*> order;
+		for (size_t i = 0; i < m_textures.size(); ++i)
+		{
+			StreamTexture* pTex = m_textures[i];
+			if (pTex->m_residentMip < pTex->m_lowMip && !pTex->m_load.valid() &&
+				m_frame - pTex->m_lastUsedFrame >= EVICT_FRAME)
+				order.push_back(pTex);
+		}
+		std::sort(order.begin(), order.end(), [](const StreamTexture* a, const StreamTexture* b) {
+			return a->m_lastUsedFrame < b->m_lastUsedFrame;
+		});
+		for (size_t i = 0; i < order.size() && videoBytes > m_budget; ++i)
+		{
+			StreamTexture* pTex = order[i];
+			StreamTexture::Resource resource = pTex->CreateMips(pTex->m_lowMip, pTex->m_lowData.data());
+			if (!resource.pSRV) { continue; }
+			videoBytes -= pTex->m_bytes;
+			pTex->Replace(resource);
+			videoBytes += pTex->m_bytes;
+			++m_stats.evictNum;
+		}
+	}
+
+	// ŋߎgꂽ̂Kvȃ~bvʃXbhœǂݍ
+	// 傫ꍇ͗\ZɎ܂Ƃ̂݁Aꍇ͗\Z𒴂ĂƂ̂ݍs
+	std::vector<StreamTexture*> order;
+	for (size_t i = 0; i < m_textures.size(); ++i)
+	{
+		StreamTexture* pTex = m_textures[i];
+		if (!pTex->m_load.valid() && pTex->m_targetMip != pTex->m_residentMip)
+			order.push_back(pTex);
+	}
+	std::sort(order.begin(), order.end(), [](const StreamTexture* a, const StreamTexture* b) {
+		if (a->m_lastUsedFrame != b->m_lastUsedFrame)
+			return a->m_lastUsedFrame > b->m_lastUsedFrame;
+		return a->m_targetMip < b->m_targetMip;
+	});
+	UINT64 pendingBytes = 0;
+	for (size_t i = 0; i < order.size() && loadingNum < LOAD_MAX; ++i)
+	{
+		StreamTexture* pTex = order[i];
+		UINT mip = pTex->m_targetMip;
+		UINT64 bytes = TextureCook::GetMipOffset(pTex->m_info, pTex->m_info.mipNum) -
+			TextureCook::GetMipOffset(pTex->m_info, mip);
+		if (mip < pTex->m_residentMip)
+		{
+			if (videoBytes + pendingBytes + bytes - pTex->m_bytes > m_budget) { continue; }
+			pendingBytes += bytes - pTex->m_bytes;
+		}
+		else if (videoBytes <= m_budget) { continue; }
+
+		pTex->m_load = std::async(std::launch::async, [pTex, mip]() {
+			return pTex->LoadMips(mip);
+		});
+		++loadingNum;
+	}
+
+	// Wv
+	m_stats.textureNum = static_cast<UINT>(m_textures.size());
+	m_stats.fullNum = 0;
+	m_stats.loadingNum = loadingNum;
+	m_stats.videoBytes = videoBytes;
+	m_stats.systemBytes = 0;
+	m_stats.budget = m_budget;
+	for (size_t i = 0; i < m_textures.size(); ++i)
+	{
+		const StreamTexture* pTex = m_textures[i];
+		if (pTex->m_residentMip <= pTex->m_targetMip)
+			++m_stats.fullNum;
+		m_stats.systemBytes += pTex->m_lowData.size();
+	}
+}
+
+void TextureStream::SetBudget(UINT64 budget)
+{
+	m_budget = budget;
+}
+UINT TextureStream::GetLowSize()
+{
+	return m_lowSize;
+}
+UINT TextureStream::GetFrame()
+{
+	return m_frame;
+}
+
+void TextureStream::Request(Texture* pTexture, float screenSize)
+{
+	StreamTexture* pStream = dynamic_cast<StreamTexture*>(pTexture);
+	if (pStream && pStream->IsStream())
+		pStream->Request(screenSize);
+}
+float TextureStream::CalcScreenSize(float radius, float distance, float fovY, float screenHeight)
+{
+	distance = std::max(distance, 0.001f);
+	return radius / (distance * tanf(fovY * 0.5f)) * screenHeight;
+}
+
+const TextureStream::Stats& TextureStream::GetStats()
+{
+	return m_stats;
+}
+
+void TextureStream::Register(StreamTexture* pTexture)
+{
+	m_textures.push_back(pTexture);
+}
+void TextureStream::Unregister(StreamTexture* pTexture)
+{
+	std::vector<StreamTexture*>::iterator it = std::find(m_textures.begin(), m_textures.end(), pTexture);
+	if (it != m_textures.end())
+		m_textures.erase(it);
+}
+
+// ʒmꂽ傫ȏɂȂł~bv
+// ʒm̂Ȃt[͌̂܂(΂炭ʒmȂΏɓǂݍł~bv
+UINT TextureStream::CalcTargetMip(const StreamTexture* pTexture)
+{
+	if (pTexture->m_requestSize <= 0.0f)
+	{
+		if (m_frame - pTexture->m_lastUsedFrame >= EVICT_FRAME) { return pTexture->m_lowMip; }
+		return pTexture->m_residentMip;
+	}
+
+	float size = static_cast<float>(std::max(pTexture->m_info.width, pTexture->m_info.height));
+	UINT mip = 0;
+	while (mip < pTexture->m_lowMip && size * 0.5f >= pTexture->m_requestSize)
+	{
+		size *= 0.5f;
+		++mip;
+	}
+	return mip;
+}
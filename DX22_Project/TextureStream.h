@@ -0,0 +1,119 @@
+#ifndef __TEXTURE_STREAM_H__
+#define __TEXTURE_STREAM_H__
+
+#include "Texture.h"
+#include <future>
+#include <string>
+#include <vector>
+
+// iKIɓǂݍރeNX`
+// 쐬͕ϊςDDS(Texture::CookFile)̏~bv݂̂ǂݍ݁A
+// 傫~bvTextureStreamʃXbhœǂݍ񂾃eNX`֍ւ
+// ϊςDDSpӂłȂꍇ͒ʏ̃eNX`ƂĂׂēǂݍ
+class StreamTexture : public Texture
+{
+	friend class TextureStream;
+public:
+	StreamTexture();
+	~StreamTexture();
+	HRESULT Create(const char* fileName);
+
+	// ʏŕKvȂ悻̑傫(sNZ)ʒm(t[̍őgp
+	// ʒm̂t[gpt[ƂċL^(ʒmȂΑ傫~bv͓ǂݍ܂Ȃ
+	void Request(float screenSize);
+
+	bool IsStream() const;			// iKIȓǂݍ݂̑Ώۂ
+	UINT GetMipNum() const;
+	UINT GetResidentMip() const;	// ǂݍݍς݂̍ł傫~bv(0̑傫
+	UINT GetTargetMip() const;		// KvƂĂ~bv
+	UINT64 GetResidentBytes() const;
+	UINT GetLastUsedFrame() const;
+
+private:
+	// 쐬eNX`(ʃXbhō쐬ĕ`Xbhōւ
+	struct Resource
+	{
+		ID3D11Texture2D*			pTex;
+		ID3D11ShaderResourceView*	pSRV;
+		UINT						mip;
+		UINT64						bytes;
+	};
+
+	Resource CreateMips(UINT mip, const uint8_t* pData) const;
+	Resource LoadMips(UINT mip) const;
+	void Replace(const Resource& resource);
+	void WaitLoad();
+
+private:
+	std::string				m_path;			// ϊςDDS̃pX
+	TextureCook::DDSInfo	m_info;
+	bool					m_isStream;
+	UINT					m_lowMip;		// ɓǂݍł~bv
+	UINT					m_residentMip;
+	UINT					m_targetMip;
+	UINT64					m_bytes;		// ǂݍݍς݂̃~bv̑傫
+	float					m_requestSize;	// t[Œʒmꂽ傫
+	UINT					m_lastUsedFrame;	// Ōɒʒm̂t[
+	std::vector<uint8_t>	m_lowData;		// ɓǂݍł~bv̓e(ǂoɎgp
+	std::future<Resource>	m_load;			// ǂݍݒ̏
+};
+
+// eNX`̒iKIȓǂݍ݂̊Ǘ
+// t[ƂUpdate
+// Eǂݍ݂IeNX`ւ
+// Eʒmꂽ傫Kvȃ~bv߁A
+// Egpʂ\Z𒴂Ă΁A΂炭gĂȂ̂珬~bv܂ŒǂoA
+// E\ZɎ܂͈͂ŁAŋߎgꂽ̂ʃXbhő傫~bvǂݍ
+// 쐬AjAUpdate͕`Xbhōs
+class TextureStream
+{
+public:
+	// Wv
+	struct Stats
+	{
+		UINT	textureNum;		// ǗĂeNX`
+		UINT	fullNum;		// Kvȃ~bv܂œǂݍݍς݂̐
+		UINT	loadingNum;		// ǂݍݒ̐
+		UINT	upgradeNum;		// OUpdateōւ
+		UINT	evictNum;		// OUpdateŒǂo
+		UINT64	videoBytes;		// ǂݍݍς݂̃~bv̍v
+		UINT64	systemBytes;	// ǂopɕێĂ鏬~bv̍v
+		UINT64	budget;			// \Z
+	};
+
+	static const UINT64 DEFAULT_BUDGET = 256ull * 1024 * 1024;
+	static const UINT DEFAULT_LOW_SIZE = 64;	// ŏɓǂݍރ~bv̑傫(c̑傫
+	static const UINT LOAD_MAX = 2;				// ɓǂݍސ
+	static const UINT EVICT_FRAME = 60;			// ̃t[ʒmȂΒǂȏΏ
+
+public:
+	static void Init(UINT64 budget = DEFAULT_BUDGET, UINT lowSize = DEFAULT_LOW_SIZE);
+	static void Uninit();
+	static void Update();
+
+	static void SetBudget(UINT64 budget);
+	static UINT GetLowSize();
+	static UINT GetFrame();
+
+	// iKIȓǂݍ݂̃eNX`łΕKvȑ傫ʒm
+	static void Request(Texture* pTexture, float screenSize);
+	// aradiuŝ̕distanceɂƂ̉ʏ̑傫(fovY͏c̉p
+	static float CalcScreenSize(float radius, float distance, float fovY, float screenHeight);
+
+	static const Stats& GetStats();
+
+private:
+	friend class StreamTexture;
+	static void Register(StreamTexture* pTexture);
+	static void Unregister(StreamTexture* pTexture);
+	static UINT CalcTargetMip(const StreamTexture* pTexture);
+
+private:
+	static std::vector<StreamTexture*>	m_textures;
+	static UINT64						m_budget;
+	static UINT							m_lowSize;
+	static UINT							m_frame;
+	static Stats						m_stats;
+};
+
+#endif // __TEXTURE_STREAM_H__
@@ -1,4 +1,6 @@
 #include "Geometory.h"
+#include <math.h>
+#include <utility>
 
 #define PI (3.141592)
 
@@ -175,9 +177,47 @@ void Geometory::MakeCylinder()
 
 void Geometory::MakeSphere()
 {
+	// ܓxCIRCLE_DETAIL / 2AoxCIRCLE_DETAILa0.5̋
+	const int ringNum = CIRCLE_DETAIL / 2;
+	const int segNum = CIRCLE_DETAIL;
+
 	//--- _̍쐬
+	std::vector<Vertex> vtx;
+	vtx.reserve((ringNum + 1) * (segNum + 1));
+	for (int i = 0; i <= ringNum; ++i)
+	{
+		float theta = static_cast<float>(PI * i / ringNum);
+		for (int j = 0; j <= segNum; ++j)
+		{
+			float phi = static_cast<float>(PI * 2.0 * j / segNum);
+			Vertex v = {
+				{ sinf(theta) * cosf(phi) * 0.5f, cosf(theta) * 0.5f, sinf(theta) * sinf(phi) * 0.5f },
+				{ static_cast<float>(j) / segNum, static_cast<float>(i) / ringNum }
+			};
+			vtx.push_back(v);
+		}
+	}
 
 	//--- CfbNX̍쐬
+	std::vector<int> idx;
+	idx.reserve(ringNum * segNum * 6);
+	for (int i = 0; i < ringNum; ++i)
+	{
+		for (int j = 0; j < segNum; ++j)
+		{
+			int v0 = i * (segNum + 1) + j;
+			int v1 = v0 + 1;
+			int v2 = v0 + segNum + 1;
+			int v3 = v2 + 1;
+			idx.push_back(v0); idx.push_back(v1); idx.push_back(v2);
+			idx.push_back(v1); idx.push_back(v3); idx.push_back(v2);
+		}
+	}
 
 	// obt@̍쐬
+	MeshBuffer::Description desc = {};
+	desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+	desc.isGPUOnly = true;
+	m_pSphere = new MeshBuffer();
+	m_pSphere->Create(desc, std::move(vtx), std::move(idx));
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Model.h"
+#include "TextureStream.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -41,6 +42,9 @@ void Model::MakeMesh(const void* ptr, float scale, Flip flip)
 			};
 		}
 
+		// E(AABB/)̌vZ
+		MakeBounds(&m_meshes[i]);
+
 		// {[
 		MakeWeight(pScene, i);
 
@@ -63,19 +67,70 @@ void Model::MakeMesh(const void* ptr, float scale, Flip flip)
 		m_meshes[i].materialID = pScene->mMeshes[i]->mMaterialIndex;
 
 		// _obt@ɕKvȃf[^ݒ
+		// (_ACfbNX̓Rs[MeshBufferֈړ
 		MeshBuffer::Description desc = {};
-		desc.pVtx		= m_meshes[i].vertices.data(); //  ݍς݂̒_f[^
-		desc.vtxSize	= sizeof(Vertex);    // 1_̃f[^TCY
-		desc.vtxCount	= m_meshes[i].vertices.size(); //  bVŎgpĂ钸_̐
-		desc.pIdx		= m_meshes[i].indices.data(); //  ݍς݂̃CfbNXf[^
-		desc.idxSize	= sizeof(unsigned long);   // 1CfbNX̃f[^TCY 
-		desc.idxCount	= m_meshes[i].indices.size(); //  bVŎgpĂCfbNX
 		desc.topology	= D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+		desc.isGPUOnly	= m_loadGPUOnly;
 		// _obt@쐬
 		m_meshes[i].pMesh = new MeshBuffer();
-		m_meshes[i].pMesh->Create(desc);
+		m_meshes[i].pMesh->Create(desc, std::move(m_meshes[i].vertices), std::move(m_meshes[i].indices));
+	}
+
+	// fŜ̋EebV̋EvZ
+	m_bounds = DirectX::BoundingBox();
+	m_boundingSphere = DirectX::BoundingSphere();
+	for (unsigned int i = 0; i < m_meshes.size(); ++i)
+	{
+		if (i == 0)
+		{
+			m_bounds = m_meshes[i].bounds;
+			m_boundingSphere = m_meshes[i].sphere;
+			continue;
+		}
+		DirectX::BoundingBox::CreateMerged(m_bounds, m_bounds, m_meshes[i].bounds);
+		DirectX::BoundingSphere::CreateMerged(m_boundingSphere, m_boundingSphere, m_meshes[i].sphere);
 	}
 }
+
+/*
+* @brief bV̋E(AABB/)𒸓_vZ
+*  Aj[VO(oCh|[Y)̒_ŌvZ
+* @param[in,out] pMesh vZΏۂ̃bV
+*/
+void Model::MakeBounds(Mesh* pMesh)
+{
+	const Vertices& vtx = pMesh->vertices;
+	if (vtx.empty())
+	{
+		pMesh->bounds = DirectX::BoundingBox();
+		pMesh->sphere = DirectX::BoundingSphere();
+		return;
+	}
+
+	// ŏlAőlSIMDł܂Ƃ߂ċ߂
+	DirectX::XMVECTOR vMin = DirectX::XMLoadFloat3(&vtx[0].pos);
+	DirectX::XMVECTOR vMax = vMin;
+	for (size_t i = 1; i < vtx.size(); ++i)
+	{
+		DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&vtx[i].pos);
+		vMin = DirectX::XMVectorMin(vMin, pos);
+		vMax = DirectX::XMVectorMax(vMax, pos);
+	}
+	DirectX::XMVECTOR vCenter = DirectX::XMVectorScale(DirectX::XMVectorAdd(vMin, vMax), 0.5f);
+	DirectX::XMVECTOR vExtents = DirectX::XMVectorScale(DirectX::XMVectorSubtract(vMax, vMin), 0.5f);
+	DirectX::XMStoreFloat3(&pMesh->bounds.Center, vCenter);
+	DirectX::XMStoreFloat3(&pMesh->bounds.Extents, vExtents);
+
+	// AABB̒Sł_܂ł̋𔼌aƂ
+	DirectX::XMVECTOR vRadiusSq = DirectX::XMVectorZero();
+	for (size_t i = 0; i < vtx.size(); ++i)
+	{
+		DirectX::XMVECTOR diff = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&vtx[i].pos), vCenter);
+		vRadiusSq = DirectX::XMVectorMax(vRadiusSq, DirectX::XMVector3LengthSq(diff));
+	}
+	pMesh->sphere.Center = pMesh->bounds.Center;
+	pMesh->sphere.Radius = DirectX::XMVectorGetX(DirectX::XMVectorSqrt(vRadiusSq));
+}
 void Model::MakeMaterial(const void* ptr, std::string directory)
 {
 	// O
@@ -116,15 +171,16 @@ void Model::MakeMaterial(const void* ptr, std::string directory)
 			continue;
 		}
 
-		// eNX`̈m
-		m_materials[i].pTexture = new Texture;
+		// eNX`̈m(iKIɓǂݍ
+		StreamTexture* pTexture = new StreamTexture;
+		m_materials[i].pTexture = pTexture;
 
 		// ̂܂ܓǂݍ
-		hr = m_materials[i].pTexture->Create(path.C_Str());
+		hr = pTexture->Create(path.C_Str());
 		if (SUCCEEDED(hr)) { continue; }
 
 		// fBNgƘAĒT
-		hr = m_materials[i].pTexture->Create((directory + path.C_Str()).c_str());
+		hr = pTexture->Create((directory + path.C_Str()).c_str());
 		if (SUCCEEDED(hr)) { continue; }
 
 		// fƓKwT
@@ -141,7 +197,7 @@ void Model::MakeMaterial(const void* ptr, std::string directory)
 		if (find != std::string::npos)
 			fileName = fileName.substr(find + 1);
 		// eNX`̓Ǎ
-		hr = m_materials[i].pTexture->Create((directory + fileName).c_str());
+		hr = pTexture->Create((directory + fileName).c_str());
 		if (SUCCEEDED(hr)) { continue; }
 
 		// eNX`Ȃ
@@ -151,4 +207,41 @@ void Model::MakeMaterial(const void* ptr, std::string directory)
 		m_errorStr += path.C_Str();
 #endif
 	}
+
+	// 萔obt@̍쐬
+	for (unsigned int i = 0; i < m_materials.size(); ++i)
+		MakeMaterialBuffer(&m_materials[i]);
+}
+
+/*
+* @brief }eA̒萔obt@쐬
+*  ShaderList̃sNZVF[_[Material(b0)Ɠzuō쐬Aȍ~͕ύXȂ
+* @param[in,out] pMaterial 쐬̃}eA
+*/
+HRESULT Model::MakeMaterialBuffer(Material* pMaterial)
+{
+	DirectX::XMFLOAT4 param[3];
+	MakeMaterialParam(*pMaterial, param);
+
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.ByteWidth	= sizeof(param);
+	bufDesc.Usage		= D3D11_USAGE_IMMUTABLE;
+	bufDesc.BindFlags	= D3D11_BIND_CONSTANT_BUFFER;
+	D3D11_SUBRESOURCE_DATA subResource = {};
+	subResource.pSysMem = param;
+
+	pMaterial->pBuffer = nullptr;
+	return GetDevice()->CreateBuffer(&bufDesc, &subResource, &pMaterial->pBuffer);
+}
+
+/*
+* @brief }eA̒萔(Material(b0)̔zu
+* @param[in] material ̃}eA
+* @param[out] pParam ݐ(3vf
+*/
+void Model::MakeMaterialParam(const Material& material, DirectX::XMFLOAT4* pParam)
+{
+	pParam[0] = material.diffuse;
+	pParam[1] = material.ambient;
+	pParam[2] = material.specular;
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef __COMPAT_DIRECTX_COLLISION_H__
+#define __COMPAT_DIRECTX_COLLISION_H__
+
+// Linuxł̃eXgpɁAgpĂDirectXCollisioň^𓯂Oŗpӂ
+#include "DirectXMath.h"
+
+namespace DirectX
+{
+	struct BoundingSphere
+	{
+		XMFLOAT3	Center;
+		float		Radius;
+
+		BoundingSphere() : Center(0.0f, 0.0f, 0.0f), Radius(1.0f) {}
+		BoundingSphere(const XMFLOAT3& center, float radius) : Center(center), Radius(radius) {}
+	};
+
+	struct BoundingBox
+	{
+		static const size_t CORNER_COUNT = 8;
+
+		XMFLOAT3	Center;
+		XMFLOAT3	Extents;
+
+		BoundingBox() : Center(0.0f, 0.0f, 0.0f), Extents(1.0f, 1.0f, 1.0f) {}
+		BoundingBox(const XMFLOAT3& center, const XMFLOAT3& extents) : Center(center), Extents(extents) {}
+
+		// 8_(DirectXCollisionƓ
+		void GetCorners(XMFLOAT3* pCorners) const
+		{
+			static const float OFFSETS[CORNER_COUNT][3] = {
+				{ -1.0f, -1.0f,  1.0f }, {  1.0f, -1.0f,  1.0f }, {  1.0f,  1.0f,  1.0f }, { -1.0f,  1.0f,  1.0f },
+				{ -1.0f, -1.0f, -1.0f }, {  1.0f, -1.0f, -1.0f }, {  1.0f,  1.0f, -1.0f }, { -1.0f,  1.0f, -1.0f },
+			};
+			for (size_t i = 0; i < CORNER_COUNT; ++i)
+			{
+				pCorners[i].x = Center.x + Extents.x * OFFSETS[i][0];
+				pCorners[i].y = Center.y + Extents.y * OFFSETS[i][1];
+				pCorners[i].z = Center.z + Extents.z * OFFSETS[i][2];
+			}
+		}
+	};
+}
+
+#endif // __COMPAT_DIRECTX_COLLISION_H__
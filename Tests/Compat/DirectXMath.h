@@ -0,0 +1,253 @@
+#ifndef __COMPAT_DIRECTX_MATH_H__
+#define __COMPAT_DIRECTX_MATH_H__
+
+// Linuxł̃eXgpɁAgpĂDirectXMath̊֐𓯂Oŗpӂ
+// v@Ƒ傫Ȃ悤AxNgZDirectXMathƓSSEōs
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace DirectX
+{
+	typedef __m128 XMVECTOR;
+	typedef const XMVECTOR FXMVECTOR;
+	typedef const XMVECTOR GXMVECTOR;
+	typedef const XMVECTOR HXMVECTOR;
+	typedef const XMVECTOR& CXMVECTOR;
+
+	struct XMMATRIX
+	{
+		XMVECTOR r[4];
+	};
+	typedef const XMMATRIX FXMMATRIX;
+	typedef const XMMATRIX& CXMMATRIX;
+
+	const float XM_PI = 3.141592654f;
+
+	struct XMFLOAT2
+	{
+		float x, y;
+		XMFLOAT2() = default;
+		XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+	};
+	struct XMFLOAT3
+	{
+		float x, y, z;
+		XMFLOAT3() = default;
+		XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+	};
+	struct XMFLOAT4
+	{
+		float x, y, z, w;
+		XMFLOAT4() = default;
+		XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+	};
+	struct XMFLOAT4X4
+	{
+		union
+		{
+			struct
+			{
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4];
+		};
+	};
+
+	inline float XMConvertToRadians(float degrees) { return degrees * (XM_PI / 180.0f); }
+
+	//--- ǂݏ
+	inline XMVECTOR XMVectorSet(float x, float y, float z, float w) { return _mm_set_ps(w, z, y, x); }
+	inline XMVECTOR XMVectorZero() { return _mm_setzero_ps(); }
+	inline XMVECTOR XMVectorReplicate(float value) { return _mm_set1_ps(value); }
+	inline XMVECTOR XMVectorTrueInt() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+	inline float XMVectorGetX(FXMVECTOR v) { return _mm_cvtss_f32(v); }
+	inline float XMVectorGetW(FXMVECTOR v) { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+	inline XMVECTOR XMVectorSetW(FXMVECTOR v, float w)
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, v);
+		f[3] = w;
+		return _mm_load_ps(f);
+	}
+	inline XMVECTOR XMVectorSplatX(FXMVECTOR v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)); }
+	inline XMVECTOR XMVectorSplatY(FXMVECTOR v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)); }
+	inline XMVECTOR XMVectorSplatZ(FXMVECTOR v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)); }
+	inline XMVECTOR XMVectorSplatW(FXMVECTOR v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+	inline XMVECTOR XMLoadFloat3(const XMFLOAT3* p) { return _mm_set_ps(0.0f, p->z, p->y, p->x); }
+	inline XMVECTOR XMLoadFloat4(const XMFLOAT4* p) { return _mm_loadu_ps(&p->x); }
+	inline void XMStoreFloat3(XMFLOAT3* p, FXMVECTOR v)
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, v);
+		p->x = f[0];
+		p->y = f[1];
+		p->z = f[2];
+	}
+	inline void XMStoreFloat4(XMFLOAT4* p, FXMVECTOR v) { _mm_storeu_ps(&p->x, v); }
+	inline void XMStoreInt4(uint32_t* p, FXMVECTOR v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_castps_si128(v)); }
+
+	//--- Z
+	inline XMVECTOR XMVectorAdd(FXMVECTOR a, FXMVECTOR b) { return _mm_add_ps(a, b); }
+	inline XMVECTOR XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) { return _mm_sub_ps(a, b); }
+	inline XMVECTOR XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) { return _mm_mul_ps(a, b); }
+	inline XMVECTOR XMVectorMultiplyAdd(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	inline XMVECTOR XMVectorScale(FXMVECTOR v, float scale) { return _mm_mul_ps(v, _mm_set1_ps(scale)); }
+	inline XMVECTOR XMVectorReciprocal(FXMVECTOR v) { return _mm_div_ps(_mm_set1_ps(1.0f), v); }
+	inline XMVECTOR XMVectorMin(FXMVECTOR a, FXMVECTOR b) { return _mm_min_ps(a, b); }
+	inline XMVECTOR XMVectorMax(FXMVECTOR a, FXMVECTOR b) { return _mm_max_ps(a, b); }
+	inline XMVECTOR XMVectorClamp(FXMVECTOR v, FXMVECTOR min, FXMVECTOR max) { return _mm_min_ps(_mm_max_ps(v, min), max); }
+	inline XMVECTOR XMVectorSaturate(FXMVECTOR v) { return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+	inline XMVECTOR XMVectorNegate(FXMVECTOR v) { return _mm_sub_ps(_mm_setzero_ps(), v); }
+	inline XMVECTOR XMVectorAbs(FXMVECTOR v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff))); }
+
+	//--- rArbgZ
+	inline XMVECTOR XMVectorLess(FXMVECTOR a, FXMVECTOR b) { return _mm_cmplt_ps(a, b); }
+	inline XMVECTOR XMVectorGreaterOrEqual(FXMVECTOR a, FXMVECTOR b) { return _mm_cmpge_ps(a, b); }
+	inline XMVECTOR XMVectorAndInt(FXMVECTOR a, FXMVECTOR b) { return _mm_and_ps(a, b); }
+	inline XMVECTOR XMVectorOrInt(FXMVECTOR a, FXMVECTOR b) { return _mm_or_ps(a, b); }
+	inline XMVECTOR XMVectorSelect(FXMVECTOR a, FXMVECTOR b, FXMVECTOR control)
+	{
+		return _mm_or_ps(_mm_andnot_ps(control, a), _mm_and_ps(b, control));
+	}
+	inline bool XMVector4EqualInt(FXMVECTOR a, FXMVECTOR b)
+	{
+		return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(a), _mm_castps_si128(b)))) == 0xf;
+	}
+	inline bool XMVector3Equal(FXMVECTOR a, FXMVECTOR b)
+	{
+		return (_mm_movemask_ps(_mm_cmpeq_ps(a, b)) & 0x7) == 0x7;
+	}
+
+	//--- xNg
+	inline XMVECTOR XMVector3Dot(FXMVECTOR a, FXMVECTOR b)
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _mm_mul_ps(a, b));
+		return _mm_set1_ps(f[0] + f[1] + f[2]);
+	}
+	inline XMVECTOR XMVector4Dot(FXMVECTOR a, FXMVECTOR b)
+	{
+		alignas(16) float f[4];
+		_mm_store_ps(f, _mm_mul_ps(a, b));
+		return _mm_set1_ps(f[0] + f[1] + f[2] + f[3]);
+	}
+	inline XMVECTOR XMVector3LengthSq(FXMVECTOR v) { return XMVector3Dot(v, v); }
+	inline XMVECTOR XMVector4LengthSq(FXMVECTOR v) { return XMVector4Dot(v, v); }
+	inline XMVECTOR XMVector3Normalize(FXMVECTOR v)
+	{
+		float length = sqrtf(XMVectorGetX(XMVector3LengthSq(v)));
+		return length > 0.0f ? XMVectorScale(v, 1.0f / length) : v;
+	}
+	inline XMVECTOR XMVector3Cross(FXMVECTOR a, FXMVECTOR b)
+	{
+		XMVECTOR a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		XMVECTOR b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		XMVECTOR a2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		XMVECTOR b2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		return _mm_sub_ps(_mm_mul_ps(a1, b1), _mm_mul_ps(a2, b2));
+	}
+	inline XMVECTOR XMPlaneNormalize(FXMVECTOR plane)
+	{
+		float length = sqrtf(XMVectorGetX(XMVector3LengthSq(plane)));
+		return XMVectorScale(plane, 1.0f / length);
+	}
+	// sxNg~s
+	inline XMVECTOR XMVector4Transform(FXMVECTOR v, FXMMATRIX m)
+	{
+		XMVECTOR result = _mm_mul_ps(XMVectorSplatX(v), m.r[0]);
+		result = _mm_add_ps(result, _mm_mul_ps(XMVectorSplatY(v), m.r[1]));
+		result = _mm_add_ps(result, _mm_mul_ps(XMVectorSplatZ(v), m.r[2]));
+		return _mm_add_ps(result, _mm_mul_ps(XMVectorSplatW(v), m.r[3]));
+	}
+	inline XMVECTOR XMVector3TransformCoord(FXMVECTOR v, FXMMATRIX m)
+	{
+		XMVECTOR result = XMVector4Transform(XMVectorSetW(v, 1.0f), m);
+		return _mm_div_ps(result, XMVectorSplatW(result));
+	}
+
+	//--- s
+	inline XMMATRIX XMMatrixSet(
+		float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23,
+		float m30, float m31, float m32, float m33)
+	{
+		XMMATRIX m;
+		m.r[0] = XMVectorSet(m00, m01, m02, m03);
+		m.r[1] = XMVectorSet(m10, m11, m12, m13);
+		m.r[2] = XMVectorSet(m20, m21, m22, m23);
+		m.r[3] = XMVectorSet(m30, m31, m32, m33);
+		return m;
+	}
+	inline XMMATRIX XMMatrixIdentity()
+	{
+		return XMMatrixSet(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+	}
+	inline XMMATRIX XMMatrixTranslation(float x, float y, float z)
+	{
+		return XMMatrixSet(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, x, y, z, 1);
+	}
+	inline XMMATRIX XMMatrixMultiply(FXMMATRIX a, CXMMATRIX b)
+	{
+		XMMATRIX m;
+		for (int i = 0; i < 4; ++i)
+			m.r[i] = XMVector4Transform(a.r[i], b);
+		return m;
+	}
+	inline XMMATRIX XMMatrixTranspose(FXMMATRIX m)
+	{
+		XMMATRIX t = m;
+		_MM_TRANSPOSE4_PS(t.r[0], t.r[1], t.r[2], t.r[3]);
+		return t;
+	}
+	inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* p)
+	{
+		XMMATRIX m;
+		for (int i = 0; i < 4; ++i)
+			m.r[i] = _mm_loadu_ps(p->m[i]);
+		return m;
+	}
+	inline void XMStoreFloat4x4(XMFLOAT4X4* p, FXMMATRIX m)
+	{
+		for (int i = 0; i < 4; ++i)
+			_mm_storeu_ps(p->m[i], m.r[i]);
+	}
+	// Wñr[s
+	inline XMMATRIX XMMatrixLookAtLH(FXMVECTOR eye, FXMVECTOR focus, FXMVECTOR up)
+	{
+		XMVECTOR z = XMVector3Normalize(XMVectorSubtract(focus, eye));
+		XMVECTOR x = XMVector3Normalize(XMVector3Cross(up, z));
+		XMVECTOR y = XMVector3Cross(z, x);
+		XMVECTOR negEye = XMVectorNegate(eye);
+		XMFLOAT3 fx, fy, fz;
+		XMStoreFloat3(&fx, x);
+		XMStoreFloat3(&fy, y);
+		XMStoreFloat3(&fz, z);
+		return XMMatrixSet(
+			fx.x, fy.x, fz.x, 0.0f,
+			fx.y, fy.y, fz.y, 0.0f,
+			fx.z, fy.z, fz.z, 0.0f,
+			XMVectorGetX(XMVector3Dot(x, negEye)), XMVectorGetX(XMVector3Dot(y, negEye)), XMVectorGetX(XMVector3Dot(z, negEye)), 1.0f);
+	}
+	// Wn̓e([x0`1
+	inline XMMATRIX XMMatrixPerspectiveFovLH(float fovY, float aspect, float nearZ, float farZ)
+	{
+		float h = 1.0f / tanf(fovY * 0.5f);
+		float w = h / aspect;
+		float range = farZ / (farZ - nearZ);
+		return XMMatrixSet(
+			w, 0, 0, 0,
+			0, h, 0, 0,
+			0, 0, range, 1,
+			0, 0, -range * nearZ, 0);
+	}
+}
+
+#endif // __COMPAT_DIRECTX_MATH_H__
@@ -0,0 +1,172 @@
+#ifndef __COMPAT_D3D11_1_H__
+#define __COMPAT_D3D11_1_H__
+
+// Linuxł̃eXgpɁAgpĂD3D11̌^𓯂Oŗpӂ
+// C^[tF[X͏z֐݂̂ŁA̓eXgŗpӂ
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef unsigned int	UINT;
+typedef int				INT;
+typedef float			FLOAT;
+typedef uint8_t			UINT8;
+typedef uint64_t		UINT64;
+typedef int				BOOL;
+typedef int32_t			HRESULT;
+
+#define S_OK			((HRESULT)0)
+#define E_FAIL			((HRESULT)0x80004005L)
+#define E_NOTIMPL		((HRESULT)0x80004001L)
+#define E_NOINTERFACE	((HRESULT)0x80004002L)
+#define SUCCEEDED(hr)	(((HRESULT)(hr)) >= 0)
+#define FAILED(hr)		(((HRESULT)(hr)) < 0)
+
+// C^[tF[X̎ʂ͍s킸AQueryInterface̎Ŕf
+struct IID {};
+#define IID_PPV_ARGS(pp) IID(), reinterpret_cast<void**>(pp)
+
+#define D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT	14
+#define D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT		128
+#define D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT				16
+#define D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT				4096
+
+enum D3D11_PRIMITIVE_TOPOLOGY
+{
+	D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED		= 0,
+	D3D11_PRIMITIVE_TOPOLOGY_LINELIST		= 2,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST	= 4,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP	= 5,
+};
+enum DXGI_FORMAT
+{
+	DXGI_FORMAT_UNKNOWN		= 0,
+	DXGI_FORMAT_R32_UINT	= 42,
+	DXGI_FORMAT_R16_UINT	= 57,
+};
+enum D3D11_MAP
+{
+	D3D11_MAP_READ					= 1,
+	D3D11_MAP_WRITE					= 2,
+	D3D11_MAP_READ_WRITE			= 3,
+	D3D11_MAP_WRITE_DISCARD			= 4,
+	D3D11_MAP_WRITE_NO_OVERWRITE	= 5,
+};
+enum D3D11_RESOURCE_DIMENSION
+{
+	D3D11_RESOURCE_DIMENSION_UNKNOWN	= 0,
+	D3D11_RESOURCE_DIMENSION_BUFFER		= 1,
+	D3D11_RESOURCE_DIMENSION_TEXTURE1D	= 2,
+	D3D11_RESOURCE_DIMENSION_TEXTURE2D	= 3,
+	D3D11_RESOURCE_DIMENSION_TEXTURE3D	= 4,
+};
+enum D3D11_CLEAR_FLAG
+{
+	D3D11_CLEAR_DEPTH	= 1,
+	D3D11_CLEAR_STENCIL	= 2,
+};
+
+struct D3D11_BOX
+{
+	UINT left, top, front, right, bottom, back;
+};
+struct D3D11_VIEWPORT
+{
+	FLOAT TopLeftX, TopLeftY, Width, Height, MinDepth, MaxDepth;
+};
+struct D3D11_MAPPED_SUBRESOURCE
+{
+	void*	pData;
+	UINT	RowPitch;
+	UINT	DepthPitch;
+};
+struct D3D11_BUFFER_DESC
+{
+	UINT ByteWidth;
+	UINT Usage;
+	UINT BindFlags;
+	UINT CPUAccessFlags;
+	UINT MiscFlags;
+	UINT StructureByteStride;
+};
+struct D3D11_TEXTURE2D_DESC
+{
+	UINT		Width;
+	UINT		Height;
+	UINT		MipLevels;
+	UINT		ArraySize;
+	DXGI_FORMAT	Format;
+};
+
+//--- C^[tF[X
+struct IUnknown
+{
+	virtual ~IUnknown() {}
+	virtual HRESULT QueryInterface(const IID& iid, void** ppObject) = 0;
+	virtual UINT AddRef() = 0;
+	virtual UINT Release() = 0;
+};
+struct ID3D11DeviceChild : public IUnknown {};
+
+struct ID3D11Resource : public ID3D11DeviceChild
+{
+	virtual void GetType(D3D11_RESOURCE_DIMENSION* pDimension) = 0;
+};
+struct ID3D11Buffer : public ID3D11Resource
+{
+	virtual void GetDesc(D3D11_BUFFER_DESC* pDesc) = 0;
+};
+struct ID3D11Texture2D : public ID3D11Resource
+{
+	virtual void GetDesc(D3D11_TEXTURE2D_DESC* pDesc) = 0;
+};
+
+// ݒ肷邾̃IuWFNg(AhX̔r̂
+struct ID3D11InputLayout : public ID3D11DeviceChild {};
+struct ID3D11VertexShader : public ID3D11DeviceChild {};
+struct ID3D11PixelShader : public ID3D11DeviceChild {};
+struct ID3D11ClassInstance : public ID3D11DeviceChild {};
+struct ID3D11ShaderResourceView : public ID3D11DeviceChild {};
+struct ID3D11SamplerState : public ID3D11DeviceChild {};
+struct ID3D11RasterizerState : public ID3D11DeviceChild {};
+struct ID3D11RenderTargetView : public ID3D11DeviceChild {};
+struct ID3D11DepthStencilView : public ID3D11DeviceChild {};
+struct ID3D11BlendState : public ID3D11DeviceChild {};
+struct ID3D11DepthStencilState : public ID3D11DeviceChild {};
+
+struct ID3D11DeviceContext : public ID3D11DeviceChild
+{
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+	virtual void IASetInputLayout(ID3D11InputLayout* pLayout) = 0;
+	virtual void IASetVertexBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pStrides, const UINT* pOffsets) = 0;
+	virtual void IASetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) = 0;
+	virtual void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum) = 0;
+	virtual void PSSetShader(ID3D11PixelShader* pShader, ID3D11ClassInstance* const* ppInstances, UINT instanceNum) = 0;
+	virtual void VSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers) = 0;
+	virtual void PSSetConstantBuffers(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers) = 0;
+	virtual void VSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews) = 0;
+	virtual void PSSetShaderResources(UINT slot, UINT num, ID3D11ShaderResourceView* const* ppViews) = 0;
+	virtual void PSSetSamplers(UINT slot, UINT num, ID3D11SamplerState* const* ppSamplers) = 0;
+	virtual void RSSetState(ID3D11RasterizerState* pState) = 0;
+	virtual void RSSetViewports(UINT num, const D3D11_VIEWPORT* pViewports) = 0;
+	virtual void OMSetRenderTargets(UINT num, ID3D11RenderTargetView* const* ppRTVs, ID3D11DepthStencilView* pDSV) = 0;
+	virtual void OMSetBlendState(ID3D11BlendState* pState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) = 0;
+	virtual void UpdateSubresource(ID3D11Resource* pResource, UINT subresource, const D3D11_BOX* pBox, const void* pData, UINT rowPitch, UINT depthPitch) = 0;
+	virtual HRESULT Map(ID3D11Resource* pResource, UINT subresource, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* pMapped) = 0;
+	virtual void Unmap(ID3D11Resource* pResource, UINT subresource) = 0;
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* pRTV, const FLOAT color[4]) = 0;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* pDSV, UINT flags, FLOAT depth, UINT8 stencil) = 0;
+	virtual void Draw(UINT vtxCount, UINT startVtx) = 0;
+	virtual void DrawIndexed(UINT idxCount, UINT startIdx, INT baseVtx) = 0;
+	virtual void DrawInstanced(UINT vtxCount, UINT instanceNum, UINT startVtx, UINT startInstance) = 0;
+	virtual void DrawIndexedInstanced(UINT idxCount, UINT instanceNum, UINT startIdx, INT baseVtx, UINT startInstance) = 0;
+	virtual void ClearState() = 0;
+};
+struct ID3D11DeviceContext1 : public ID3D11DeviceContext
+{
+	virtual void VSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants) = 0;
+	virtual void PSSetConstantBuffers1(UINT slot, UINT num, ID3D11Buffer* const* ppBuffers, const UINT* pFirstConstant, const UINT* pNumConstants) = 0;
+};
+
+#endif // __COMPAT_D3D11_1_H__
@@ -0,0 +1,243 @@
+// BVH̃eXgƌv
+// SIuWFNg𒲂ׂPȎƌʂrA\zACA䔻̎Ԃv
+#include "TestCommon.h"
+#include "BVH.h"
+#include "FrustumCull.h"
+#include <algorithm>
+#include <float.h>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+// AABBƎ̔(BVH::QueryFrustumƓ
+static bool IsBoxInFrustum(const XMFLOAT4* pPlanes, const BoundingBox& box)
+{
+	for (int i = 0; i < 6; ++i)
+	{
+		const XMFLOAT4& p = pPlanes[i];
+		float dist = p.x * box.Center.x + p.y * box.Center.y + p.z * box.Center.z + p.w;
+		float radius = fabsf(p.x) * box.Extents.x + fabsf(p.y) * box.Extents.y + fabsf(p.z) * box.Extents.z;
+		if (dist < -radius) { return false; }
+	}
+	return true;
+}
+
+// AABBƋ̔
+static bool IsBoxInSphere(const BoundingSphere& sphere, const BoundingBox& box)
+{
+	float distSq = 0.0f;
+	for (int i = 0; i < 3; ++i)
+	{
+		float c = (&sphere.Center.x)[i];
+		float min = (&box.Center.x)[i] - (&box.Extents.x)[i];
+		float max = (&box.Center.x)[i] + (&box.Extents.x)[i];
+		float d = std::min(std::max(c, min), max) - c;
+		distSq += d * d;
+	}
+	return distSq <= sphere.Radius * sphere.Radius;
+}
+
+// SIuWFNgƃC𔻒肵Ał߂̂Ԃ
+static uint32_t RaycastAll(const std::vector<BoundingBox>& boxes, const XMFLOAT3& origin, const XMFLOAT3& dir, float maxDist, float* pDist)
+{
+	uint32_t hit = BVH::NONE;
+	float hitDist = maxDist;
+	for (uint32_t i = 0; i < boxes.size(); ++i)
+	{
+		float enter = 0.0f;
+		float exit = maxDist;
+		for (int j = 0; j < 3; ++j)
+		{
+			float inv = 1.0f / (&dir.x)[j];
+			float t1 = ((&boxes[i].Center.x)[j] - (&boxes[i].Extents.x)[j] - (&origin.x)[j]) * inv;
+			float t2 = ((&boxes[i].Center.x)[j] + (&boxes[i].Extents.x)[j] - (&origin.x)[j]) * inv;
+			enter = std::max(enter, std::min(t1, t2));
+			exit = std::min(exit, std::max(t1, t2));
+		}
+		if (enter <= exit && (hit == BVH::NONE || enter < hitDist))
+		{
+			hit = i;
+			hitDist = enter;
+		}
+	}
+	*pDist = hitDist;
+	return hit;
+}
+
+static std::vector<BoundingBox> CreateBoxes(uint32_t num, std::mt19937* pRand)
+{
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> size(0.1f, 3.0f);
+	std::vector<BoundingBox> boxes(num);
+	for (uint32_t i = 0; i < num; ++i)
+	{
+		boxes[i] = BoundingBox(XMFLOAT3(pos(*pRand), pos(*pRand) * 0.2f, pos(*pRand)),
+			XMFLOAT3(size(*pRand), size(*pRand), size(*pRand)));
+	}
+	return boxes;
+}
+
+static void TestQuery(uint32_t num)
+{
+	std::mt19937 rand(num);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::vector<BoundingBox> boxes = CreateBoxes(num, &rand);
+	BVH bvh;
+	bvh.Build(boxes);
+	TEST_CHECK(bvh.GetObjectNum() == num);
+
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 10.0f, -60.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 120.0f);
+	XMFLOAT4 planes[6];
+	FrustumCull::MakePlanes(XMMatrixMultiply(view, proj), planes);
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		// (t̒Pʂŏo͂邽߁ÂׂĊ܂ݏdȂ
+		std::vector<uint32_t> out;
+		bvh.QueryFrustum(planes, &out);
+		std::sort(out.begin(), out.end());
+		TEST_CHECK(std::adjacent_find(out.begin(), out.end()) == out.end());
+		for (uint32_t i = 0; i < num; ++i)
+		{
+			if (IsBoxInFrustum(planes, boxes[i]))
+				TEST_CHECK(std::binary_search(out.begin(), out.end(), i));
+		}
+
+		// (IuWFNgPʂŔ肷邽߈v
+		BoundingSphere sphere(XMFLOAT3(10.0f, 0.0f, 10.0f), 15.0f);
+		bvh.QuerySphere(sphere, &out);
+		std::sort(out.begin(), out.end());
+		std::vector<uint32_t> expect;
+		for (uint32_t i = 0; i < num; ++i)
+		{
+			if (IsBoxInSphere(sphere, boxes[i]))
+				expect.push_back(i);
+		}
+		TEST_CHECK(out == expect);
+
+		// C
+		for (int i = 0; i < 200; ++i)
+		{
+			XMFLOAT3 origin(pos(rand), pos(rand), pos(rand));
+			XMFLOAT3 dir(pos(rand), pos(rand), pos(rand));
+			XMStoreFloat3(&dir, XMVector3Normalize(XMLoadFloat3(&dir)));
+			float dist = -1.0f;
+			float expectDist;
+			uint32_t hit = bvh.Raycast(XMLoadFloat3(&origin), XMLoadFloat3(&dir), 1000.0f, &dist);
+			uint32_t expectHit = RaycastAll(boxes, origin, dir, 1000.0f, &expectDist);
+			TEST_CHECK((hit == BVH::NONE) == (expectHit == BVH::NONE));
+			if (hit != BVH::NONE)
+				TEST_CHECK(fabsf(dist - expectDist) < 1e-3f);
+		}
+
+		// ꕔ𓮂ċEXVAxmF
+		for (uint32_t i = 0; i < std::min(num, 50u); ++i)
+		{
+			uint32_t index = rand() % num;
+			boxes[index] = BoundingBox(XMFLOAT3(pos(rand), pos(rand), pos(rand)), XMFLOAT3(1.0f, 1.0f, 1.0f));
+			bvh.Refit(index, boxes[index]);
+		}
+	}
+}
+
+// ̏ȂC(ǂ̃IuWFNgƂȂNONE
+static void TestUnboundedRay()
+{
+	// 10Ԋuɕׂ8x8̔(Ԃʂ郌C͂ǂɂȂ
+	std::vector<BoundingBox> boxes;
+	for (int i = 0; i < 64; ++i)
+		boxes.push_back(BoundingBox(XMFLOAT3((i % 8) * 10.0f, (i / 8) * 10.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f)));
+	BVH bvh;
+	bvh.Build(boxes);
+
+	XMVECTOR dir = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+	XMVECTOR between = XMVectorSet(5.0f, 5.0f, -100.0f, 1.0f);
+	const float MAX_DIST[] = { 1000.0f, FLT_MAX, INFINITY };
+	for (float maxDist : MAX_DIST)
+	{
+		float dist = -1.0f;
+		TEST_CHECK(bvh.Raycast(between, dir, maxDist, &dist) == BVH::NONE);
+		TEST_CHECK(dist == -1.0f);
+
+		// ꍇ͋̏Ɋ֌WȂ
+		TEST_CHECK(bvh.Raycast(XMVectorSet(10.5f, 0.5f, -100.0f, 1.0f), dir, maxDist, &dist) == 1);
+		TEST_CHECK(fabsf(dist - 99.0f) < 1e-4f);
+	}
+	// 艓ꍇ͓Ȃ
+	TEST_CHECK(bvh.Raycast(XMVectorSet(10.5f, 0.5f, -100.0f, 1.0f), dir, 98.0f) == BVH::NONE);
+
+	// 
+	BVH empty;
+	TEST_CHECK(empty.Raycast(between, dir, INFINITY) == BVH::NONE);
+}
+
+int main()
+{
+	const uint32_t SIZES[] = { 1, 3, 10, 1000, 20000 };
+	for (uint32_t num : SIZES)
+		TestQuery(num);
+	TestUnboundedRay();
+
+	//--- v(100000IuWFNg
+	const uint32_t OBJECT_NUM = 100000;
+	const int RAY_NUM = 10000;
+	std::mt19937 rand(1);
+	std::vector<BoundingBox> boxes = CreateBoxes(OBJECT_NUM, &rand);
+	BVH bvh;
+	double buildMs = TestMeasure(3, [&]() {
+		bvh.Build(boxes);
+	});
+
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::vector<XMFLOAT3> origins(RAY_NUM), dirs(RAY_NUM);
+	for (int i = 0; i < RAY_NUM; ++i)
+	{
+		origins[i] = XMFLOAT3(pos(rand), pos(rand), pos(rand));
+		XMStoreFloat3(&dirs[i], XMVector3Normalize(XMVectorSet(pos(rand), pos(rand), pos(rand), 0.0f)));
+	}
+	uint32_t hitNum = 0;
+	double rayMs = TestMeasure(3, [&]() {
+		hitNum = 0;
+		for (int i = 0; i < RAY_NUM; ++i)
+		{
+			if (bvh.Raycast(XMLoadFloat3(&origins[i]), XMLoadFloat3(&dirs[i]), INFINITY) != BVH::NONE)
+				++hitNum;
+		}
+	});
+	// S͎Ԃ邽100{Ōv
+	uint32_t hitAllNum = 0;
+	double rayAllMs = TestMeasure(1, [&]() {
+		float dist;
+		for (int i = 0; i < 100; ++i)
+		{
+			if (RaycastAll(boxes, origins[i], dirs[i], INFINITY, &dist) != BVH::NONE)
+				++hitAllNum;
+		}
+	}) * (RAY_NUM / 100);
+
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 10.0f, -60.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 120.0f);
+	XMFLOAT4 planes[6];
+	FrustumCull::MakePlanes(XMMatrixMultiply(view, proj), planes);
+	std::vector<uint32_t> out;
+	double frustumMs = TestMeasure(20, [&]() {
+		bvh.QueryFrustum(planes, &out);
+	});
+	double frustumAllMs = TestMeasure(20, [&]() {
+		uint32_t num = 0;
+		for (uint32_t i = 0; i < OBJECT_NUM; ++i)
+			num += IsBoxInFrustum(planes, boxes[i]) ? 1 : 0;
+		TEST_CHECK(num <= out.size());
+	});
+
+	printf("BVH: %u objects, %zu nodes\n", OBJECT_NUM, bvh.GetNodes().size());
+	printf("  build             : %.2f ms\n", buildMs);
+	printf("  raycast x%d    : %.2f ms, %u hits\n", RAY_NUM, rayMs, hitNum);
+	printf("  (all objects)     : %.0f ms, %u hits in first 100 rays\n", rayAllMs, hitAllNum);
+	printf("  frustum query     : %.3f ms (all objects: %.3f ms), %zu objects\n", frustumMs, frustumAllMs, out.size());
+
+	printf("TestBVH: OK\n");
+	return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef __TEST_COMMON_H__
+#define __TEST_COMMON_H__
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+// GPÛȂ(Linux)ŎsP̃eXgAv̋ʏ
+
+// 𖞂ȂΈʒu\ďI
+#define TEST_CHECK(cond) \
+	do { if (!(cond)) { printf("%s(%d): TEST_CHECK(%s) failed\n", __FILE__, __LINE__, #cond); exit(1); } } while (0)
+
+// oߎԂ̌v
+class TestTimer
+{
+public:
+	TestTimer() : m_start(std::chrono::steady_clock::now()) {}
+	// ̌oߎ(~b
+	double GetMs() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_start;
+};
+
+// numsAł̎(~b
+template<class Func>
+double TestMeasure(int num, Func func)
+{
+	double best = 1e30;
+	for (int i = 0; i < num; ++i)
+	{
+		TestTimer timer;
+		func();
+		double ms = timer.GetMs();
+		if (ms < best) { best = ms; }
+	}
+	return best;
+}
+
+#endif // __TEST_COMMON_H__
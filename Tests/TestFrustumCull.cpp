@@ -0,0 +1,137 @@
+// JÕeXgƌv
+// 1IuWFNg肷PȎƌʂv邱ƂmFA
+// 100000IuWFNg̔莞Ԃr
+#include "TestCommon.h"
+#include "FrustumCull.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+// Ώ(CullƓAAABB̓eaƋ̔ȁŔ肷
+struct Object
+{
+	XMFLOAT3	center;
+	XMFLOAT3	extents;
+	float		radius;
+	bool		enable;
+};
+
+// 1IuWFNg6ʂƔ
+static void CullScalar(const std::vector<Object>& objects, const XMFLOAT4* pPlanes, std::vector<uint32_t>* pVisible)
+{
+	pVisible->clear();
+	for (uint32_t i = 0; i < objects.size(); ++i)
+	{
+		const Object& obj = objects[i];
+		if (!obj.enable) { continue; }
+		bool outside = false;
+		for (int j = 0; j < 6 && !outside; ++j)
+		{
+			const XMFLOAT4& p = pPlanes[j];
+			float dist = p.x * obj.center.x + (p.y * obj.center.y + (p.z * obj.center.z + p.w));
+			float boxRadius = fabsf(p.x) * obj.extents.x + (fabsf(p.y) * obj.extents.y + fabsf(p.z) * obj.extents.z);
+			float radius = std::min(boxRadius, obj.radius);
+			outside = dist < -radius;
+		}
+		if (!outside)
+			pVisible->push_back(i);
+	}
+}
+
+int main()
+{
+	const uint32_t OBJECT_NUM = 100000;
+
+	// _t߂JƁA͂ɎU΂AAABB
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 20.0f, -150.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f);
+	XMMATRIX viewProj = XMMatrixMultiply(view, proj);
+
+	std::mt19937 rand(1);
+	std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> size(0.1f, 8.0f);
+	std::vector<Object> objects(OBJECT_NUM);
+	FrustumCull cull;
+	for (uint32_t i = 0; i < OBJECT_NUM; ++i)
+	{
+		Object& obj = objects[i];
+		obj.center = XMFLOAT3(pos(rand), pos(rand) * 0.2f, pos(rand));
+		obj.enable = true;
+		if (i % 2)
+		{
+			obj.radius = size(rand);
+			obj.extents = XMFLOAT3(obj.radius, obj.radius, obj.radius);
+			TEST_CHECK(cull.Add(BoundingSphere(obj.center, obj.radius)) == i);
+		}
+		else
+		{
+			obj.extents = XMFLOAT3(size(rand), size(rand), size(rand));
+			obj.radius = sqrtf(obj.extents.x * obj.extents.x + obj.extents.y * obj.extents.y + obj.extents.z * obj.extents.z);
+			TEST_CHECK(cull.Add(BoundingBox(obj.center, obj.extents)) == i);
+		}
+	}
+	TEST_CHECK(cull.GetNum() == OBJECT_NUM);
+
+	XMFLOAT4X4 fViewProj;
+	XMStoreFloat4x4(&fViewProj, viewProj);
+	cull.SetFrustum(fViewProj);
+	XMFLOAT4 planes[6];
+	FrustumCull::MakePlanes(viewProj, planes);
+
+	//--- PȎƈv
+	std::vector<uint32_t> visible, expect;
+	cull.Cull(&visible);
+	CullScalar(objects, planes, &expect);
+	TEST_CHECK(visible == expect);
+	TEST_CHECK(cull.GetStats().objectNum == OBJECT_NUM);
+	TEST_CHECK(cull.GetStats().visibleNum == visible.size());
+	TEST_CHECK(!visible.empty() && visible.size() < OBJECT_NUM / 2);
+
+	// SʓɂIuWFNg͕Kc
+	for (uint32_t i = 0; i < OBJECT_NUM; ++i)
+	{
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(XMVectorSetW(XMLoadFloat3(&objects[i].center), 1.0f), viewProj));
+		if (clip.w <= 0.0f) { continue; }
+		bool inside = fabsf(clip.x) < clip.w && fabsf(clip.y) < clip.w && clip.z > 0.0f && clip.z < clip.w;
+		if (inside)
+			TEST_CHECK(std::binary_search(visible.begin(), visible.end(), i));
+	}
+
+	//--- OAXV
+	uint32_t first = visible[0];
+	cull.Disable(first);
+	objects[first].enable = false;
+	uint32_t moved = (first + 1) % OBJECT_NUM;
+	objects[moved].center = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	cull.Set(moved, BoundingSphere(objects[moved].center, objects[moved].radius));
+	objects[moved].extents = XMFLOAT3(objects[moved].radius, objects[moved].radius, objects[moved].radius);
+	cull.Cull(&visible);
+	CullScalar(objects, planes, &expect);
+	TEST_CHECK(visible == expect);
+	TEST_CHECK(!std::binary_search(visible.begin(), visible.end(), first));
+	TEST_CHECK(std::binary_search(visible.begin(), visible.end(), moved));
+
+	// 4̔{łȂ(󂫗vf͏o͂Ȃ
+	FrustumCull small;
+	for (uint32_t i = 0; i < 5; ++i)
+		small.Add(BoundingSphere(XMFLOAT3(0.0f, 0.0f, 0.0f), 1.0f));
+	small.SetFrustum(fViewProj);
+	TEST_CHECK(small.Cull(&visible) == 5 && visible.back() == 4);
+
+	//--- v
+	double simdMs = TestMeasure(20, [&]() {
+		cull.Cull(&visible);
+	});
+	double scalarMs = TestMeasure(20, [&]() {
+		CullScalar(objects, planes, &expect);
+	});
+	printf("FrustumCull: %u objects, %zu visible\n", OBJECT_NUM, visible.size());
+	printf("  per object (scalar) : %.3f ms\n", scalarMs);
+	printf("  SoA x4 (FrustumCull): %.3f ms\n", simdMs);
+
+	printf("TestFrustumCull: OK\n");
+	return 0;
+}
@@ -0,0 +1,198 @@
+// ՕJÕeXgƌv
+// ǂ̉ɂ̂B邱ƁABꂽƔ肵AABB͈̔͂̐[xׂĎOł邱ƂmFA
+// n`ƕǂՕɂʂŕ`݂Ɣ̎Ԃv
+#include "TestCommon.h"
+#include "OcclusionCull.h"
+#include <algorithm>
+#include <float.h>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+static const uint32_t WIDTH = 320;
+static const uint32_t HEIGHT = 192;
+
+// lp`(2̎Op`)̎Օ
+static void AddQuad(OcclusionCull* pCull, const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2, const XMFLOAT3& v3)
+{
+	XMFLOAT3 vertices[4] = { v0, v1, v2, v3 };
+	uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixIdentity());
+	pCull->AddOccluder(vertices, 4, indices, 6, world);
+}
+
+// BĂƔ肳ꂽAABB́Aʏ͈̔͂̐[xׂAABB̍łOOɂ
+static bool IsHiddenByDepth(OcclusionCull* pCull, const XMFLOAT4X4& viewProj, const BoundingBox& box)
+{
+	XMMATRIX mat = XMLoadFloat4x4(&viewProj);
+	XMFLOAT3 corners[8];
+	box.GetCorners(corners);
+	float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+	for (int i = 0; i < 8; ++i)
+	{
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(corners[i].x, corners[i].y, corners[i].z, 1.0f), mat));
+		float x = (clip.x / clip.w * 0.5f + 0.5f) * WIDTH;
+		float y = (0.5f - clip.y / clip.w * 0.5f) * HEIGHT;
+		minX = std::min(minX, x);	maxX = std::max(maxX, x);
+		minY = std::min(minY, y);	maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip.z / clip.w);
+	}
+	// ʊO
+	if (maxX < 0.0f || maxY < 0.0f || minX >= WIDTH || minY >= HEIGHT) { return true; }
+
+	const float* pDepth = pCull->GetDepth();
+	uint32_t x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+	uint32_t y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+	uint32_t x1 = static_cast<uint32_t>(std::min(maxX, WIDTH - 1.0f));
+	uint32_t y1 = static_cast<uint32_t>(std::min(maxY, HEIGHT - 1.0f));
+	for (uint32_t y = y0; y <= y1; ++y)
+	{
+		for (uint32_t x = x0; x <= x1; ++x)
+		{
+			if (pDepth[y * pCull->GetWidth() + x] >= minZ)
+				return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	XMFLOAT4X4 viewProj;
+	XMStoreFloat4x4(&viewProj, XMMatrixPerspectiveFovLH(1.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f));
+
+	//--- InitO(`ݐ悪Ȃ߁AׂČĂ鈵
+	{
+		OcclusionCull cull;
+		cull.Begin(viewProj);
+		AddQuad(&cull, XMFLOAT3(-5, -5, 10), XMFLOAT3(5, -5, 10), XMFLOAT3(5, 5, 10), XMFLOAT3(-5, 5, 10));
+		cull.Render();
+		BoundingBox box(XMFLOAT3(0, 0, 20), XMFLOAT3(1, 1, 1));
+		std::vector<uint32_t> visible;
+		TEST_CHECK(cull.Test(&box, 1, &visible) == 1);
+		TEST_CHECK(cull.GetStats().triangleNum == 0);
+		TEST_CHECK(cull.IsVisible(box));
+	}
+
+	//--- ʂ̕
+	OcclusionCull cull;
+	cull.Init(WIDTH, HEIGHT);
+	TEST_CHECK(cull.GetWidth() % 64 == 0 && cull.GetWidth() >= WIDTH);
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		cull.Begin(viewProj);
+		AddQuad(&cull, XMFLOAT3(-5, -5, 10), XMFLOAT3(5, -5, 10), XMFLOAT3(5, 5, 10), XMFLOAT3(-5, 5, 10));
+		// J܂Op`͕`܂Ȃ
+		XMFLOAT3 cross[3] = { XMFLOAT3(-1, -1, -1), XMFLOAT3(1, -1, 5), XMFLOAT3(0, 1, 5) };
+		uint32_t crossIdx[3] = { 0, 1, 2 };
+		XMFLOAT4X4 world;
+		XMStoreFloat4x4(&world, XMMatrixIdentity());
+		cull.AddOccluder(cross, 3, crossIdx, 3, world);
+		cull.Render();
+		TEST_CHECK(cull.GetStats().triangleNum == 2);
+
+		// ǂ̐[x(z=10vWFNVŕϊl
+		float expectZ = 100.0f / (100.0f - 0.1f) * (1.0f - 0.1f / 10.0f);
+		float centerZ = cull.GetDepth()[(HEIGHT / 2) * cull.GetWidth() + WIDTH / 2];
+		TEST_CHECK(fabsf(centerZ - expectZ) < 1e-4f);
+		TEST_CHECK(cull.GetDepth()[0] == 1.0f);
+
+		BoundingBox boxes[] = {
+			BoundingBox(XMFLOAT3(0, 0, 20), XMFLOAT3(1, 1, 1)),		// ǂ̉: B
+			BoundingBox(XMFLOAT3(50, 0, 20), XMFLOAT3(1, 1, 1)),	// ʊO: B
+			BoundingBox(XMFLOAT3(0, 0, 5), XMFLOAT3(1, 1, 1)),		// ǂ̎O
+			BoundingBox(XMFLOAT3(9, 0, 20), XMFLOAT3(1, 1, 1)),		// ǂ̉
+			BoundingBox(XMFLOAT3(0, 0, 0), XMFLOAT3(1, 1, 1)),		// J܂
+		};
+		std::vector<uint32_t> visible;
+		TEST_CHECK(cull.Test(boxes, 5, &visible) == 3);
+		TEST_CHECK(visible[0] == 2 && visible[1] == 3 && visible[2] == 4);
+		TEST_CHECK(cull.GetStats().occludedNum == 2);
+	}
+
+	//--- n`ƕǂ̏
+	const uint32_t GRID = 64;
+	const uint32_t OBJECT_NUM = 100000;
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 3.0f, -40.0f, 1.0f), XMVectorSet(0.0f, 2.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX proj = XMMatrixPerspectiveFovLH(1.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 300.0f);
+	XMStoreFloat4x4(&viewProj, XMMatrixMultiply(view, proj));
+
+	std::vector<XMFLOAT3> terrain;
+	std::vector<uint32_t> terrainIdx;
+	for (uint32_t z = 0; z <= GRID; ++z)
+	{
+		for (uint32_t x = 0; x <= GRID; ++x)
+		{
+			float fx = (x - GRID * 0.5f) * 4.0f;
+			float fz = (z - GRID * 0.5f) * 4.0f;
+			terrain.push_back(XMFLOAT3(fx, sinf(fx * 0.1f) * cosf(fz * 0.1f) * 2.0f, fz));
+		}
+	}
+	for (uint32_t z = 0; z < GRID; ++z)
+	{
+		for (uint32_t x = 0; x < GRID; ++x)
+		{
+			uint32_t i = z * (GRID + 1) + x;
+			uint32_t quad[6] = { i, i + GRID + 1, i + GRID + 2, i, i + GRID + 2, i + 1 };
+			terrainIdx.insert(terrainIdx.end(), quad, quad + 6);
+		}
+	}
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixIdentity());
+	auto addScene = [&]() {
+		cull.Begin(viewProj);
+		cull.AddOccluder(terrain.data(), static_cast<uint32_t>(terrain.size()),
+			terrainIdx.data(), static_cast<uint32_t>(terrainIdx.size()), world);
+		for (int i = 0; i < 8; ++i)
+		{
+			float x = -40.0f + i * 10.0f;
+			AddQuad(&cull, XMFLOAT3(x, -2, -10 + i * 3.0f), XMFLOAT3(x + 8, -2, -10 + i * 3.0f),
+				XMFLOAT3(x + 8, 12, -10 + i * 3.0f), XMFLOAT3(x, 12, -10 + i * 3.0f));
+		}
+	};
+
+	std::mt19937 rand(1);
+	std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+	std::vector<BoundingBox> boxes(OBJECT_NUM);
+	for (uint32_t i = 0; i < OBJECT_NUM; ++i)
+		boxes[i] = BoundingBox(XMFLOAT3(pos(rand), size(rand) - 1.0f, pos(rand)), XMFLOAT3(size(rand), size(rand), size(rand)));
+
+	addScene();
+	cull.Render();
+	std::vector<uint32_t> visible;
+	cull.Test(boxes.data(), OBJECT_NUM, &visible);
+	uint32_t occluded = cull.GetStats().occludedNum;
+	TEST_CHECK(occluded > 0 && occluded < OBJECT_NUM);
+
+	// BĂƔ肵̂́A[xobt@łSɉBĂ
+	size_t next = 0;
+	for (uint32_t i = 0; i < OBJECT_NUM; ++i)
+	{
+		if (next < visible.size() && visible[next] == i)
+		{
+			++next;
+			continue;
+		}
+		TEST_CHECK(IsHiddenByDepth(&cull, viewProj, boxes[i]));
+	}
+
+	//--- v
+	double addMs = TestMeasure(10, addScene);
+	double renderMs = TestMeasure(10, [&]() {
+		cull.Render();
+	});
+	double testMs = TestMeasure(10, [&]() {
+		cull.Test(boxes.data(), OBJECT_NUM, &visible);
+	});
+	printf("OcclusionCull: %ux%u, %u occluder triangles, %u objects\n", WIDTH, HEIGHT, cull.GetStats().triangleNum, OBJECT_NUM);
+	printf("  add occluders : %.3f ms\n", addMs);
+	printf("  render + HiZ  : %.3f ms\n", renderMs);
+	printf("  test          : %.3f ms, %u occluded\n", testMs, occluded);
+
+	printf("TestOcclusionCull: OK\n");
+	return 0;
+}
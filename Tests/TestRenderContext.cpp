@@ -0,0 +1,217 @@
+// `R}h̋L^(RenderContextRecordARenderContextListARenderContextCache)̃eXgƌv
+// wbhXƓL^݂̂̍\ƁAD3D11ւ̓]͂\ŁA
+// ]ʂ񂾔͈͂Ő邱ƁAL^R}hĐ邱ƂmF
+#include "TestCommon.h"
+#include "RenderContext.h"
+#include <vector>
+
+//--- eXgp̃IuWFNg
+class FakeBuffer : public ID3D11Buffer
+{
+public:
+	FakeBuffer(UINT size) : data(size) {}
+	HRESULT QueryInterface(const IID&, void**) { return E_NOINTERFACE; }
+	UINT AddRef() { return 1; }
+	UINT Release() { return 1; }
+	void GetType(D3D11_RESOURCE_DIMENSION* pDimension) { *pDimension = D3D11_RESOURCE_DIMENSION_BUFFER; }
+	void GetDesc(D3D11_BUFFER_DESC* pDesc)
+	{
+		memset(pDesc, 0, sizeof(*pDesc));
+		pDesc->ByteWidth = static_cast<UINT>(data.size());
+	}
+
+	std::vector<char> data;
+};
+template<class T>
+class FakeState : public T
+{
+public:
+	HRESULT QueryInterface(const IID&, void**) { return E_NOINTERFACE; }
+	UINT AddRef() { return 1; }
+	UINT Release() { return 1; }
+};
+
+// @̃foCXReLXg̑(`搔Map̉񐔂𐔂AMap̓obt@֒ڏ܂
+class FakeContext : public ID3D11DeviceContext1
+{
+public:
+	FakeContext() : drawNum(0), mapNum(0), unmapNum(0), stateNum(0), clearNum(0), pVS(nullptr) {}
+	HRESULT QueryInterface(const IID&, void** ppObject) { *ppObject = this; return S_OK; }
+	UINT AddRef() { return 1; }
+	UINT Release() { return 1; }
+
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) { ++stateNum; }
+	void IASetInputLayout(ID3D11InputLayout*) { ++stateNum; }
+	void IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) { ++stateNum; }
+	void IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) { ++stateNum; }
+	void VSSetShader(ID3D11VertexShader* pShader, ID3D11ClassInstance* const*, UINT) { pVS = pShader; ++stateNum; }
+	void PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) { ++stateNum; }
+	void VSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) { ++stateNum; }
+	void PSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) { ++stateNum; }
+	void VSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) { ++stateNum; }
+	void PSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) { ++stateNum; }
+	void VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) { ++stateNum; }
+	void PSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) { ++stateNum; }
+	void PSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) { ++stateNum; }
+	void RSSetState(ID3D11RasterizerState*) { ++stateNum; }
+	void RSSetViewports(UINT, const D3D11_VIEWPORT*) { ++stateNum; }
+	void OMSetRenderTargets(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*) { ++stateNum; }
+	void OMSetBlendState(ID3D11BlendState*, const FLOAT[4], UINT) { ++stateNum; }
+	void OMSetDepthStencilState(ID3D11DepthStencilState*, UINT) { ++stateNum; }
+	void UpdateSubresource(ID3D11Resource*, UINT, const D3D11_BOX*, const void*, UINT, UINT) {}
+	HRESULT Map(ID3D11Resource* pResource, UINT, D3D11_MAP, UINT, D3D11_MAPPED_SUBRESOURCE* pMapped)
+	{
+		++mapNum;
+		FakeBuffer* pBuffer = static_cast<FakeBuffer*>(static_cast<ID3D11Buffer*>(pResource));
+		pMapped->pData = pBuffer->data.data();
+		pMapped->RowPitch = pMapped->DepthPitch = static_cast<UINT>(pBuffer->data.size());
+		return S_OK;
+	}
+	void Unmap(ID3D11Resource*, UINT) { ++unmapNum; }
+	void ClearRenderTargetView(ID3D11RenderTargetView*, const FLOAT[4]) {}
+	void ClearDepthStencilView(ID3D11DepthStencilView*, UINT, FLOAT, UINT8) {}
+	void Draw(UINT, UINT) { ++drawNum; }
+	void DrawIndexed(UINT, UINT, INT) { ++drawNum; }
+	void DrawInstanced(UINT, UINT, UINT, UINT) { ++drawNum; }
+	void DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) { ++drawNum; }
+	void ClearState() { ++clearNum; }
+
+	UINT drawNum;
+	UINT mapNum;
+	UINT unmapNum;
+	UINT stateNum;
+	UINT clearNum;
+	ID3D11VertexShader* pVS;
+};
+
+// Oobt@ւ̒ǋLƓ(NO_OVERWRITEňꕔ݁A͈͂w肵Unmap
+static bool WriteRange(RenderContext* pContext, FakeBuffer* pBuffer, UINT offset, UINT size, char value)
+{
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (FAILED(pContext->Map(pBuffer, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped))) { return false; }
+	memset(static_cast<char*>(mapped.pData) + offset, value, size);
+	pContext->UnmapRange(pBuffer, 0, offset, size);
+	return true;
+}
+
+// 1t[̕`(VF[_[ŕ`搔̒萔obt@̐؂ւƕ`
+static void DrawFrame(RenderContext* pContext, UINT drawNum, ID3D11VertexShader* pVS, ID3D11Buffer* pCB)
+{
+	pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	for (UINT i = 0; i < drawNum; ++i)
+	{
+		UINT first = (i % 256) * 16;
+		UINT num = 16;
+		pContext->VSSetShader(pVS, nullptr, 0);
+		pContext->VSSetConstantBuffers1(8, 1, &pCB, &first, &num);
+		pContext->DrawIndexed(36, 0, 0);
+	}
+}
+
+int main()
+{
+	FakeBuffer ring(64 * 1024);
+	FakeState<ID3D11VertexShader> vs;
+
+	//--- wbhX(L^̂)
+	{
+		RenderContextRecord record;
+		TEST_CHECK(WriteRange(&record, &ring, 256, 256, 1));
+		TEST_CHECK(WriteRange(&record, &ring, 512, 64, 2));
+		TEST_CHECK(record.GetStats().uploadNum == 2);
+		TEST_CHECK(record.GetStats().uploadBytes == 256 + 64);
+
+		// ͈͂̎w肪Ȃ΃obt@S
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		TEST_CHECK(SUCCEEDED(record.Map(&ring, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)));
+		record.Unmap(&ring, 0);
+		TEST_CHECK(record.GetStats().uploadBytes == 256 + 64 + ring.data.size());
+		TEST_CHECK(record.GetCommands().back().type == RenderContextRecord::CMD_MAP);
+	}
+
+	//--- ](L^D3D11֔s
+	{
+		FakeContext native;
+		RenderContextD3D11 d3d(&native);
+		RenderContextRecord record(&d3d);
+		RenderContextCache cache(&record);
+		TEST_CHECK(WriteRange(&cache, &ring, 1024, 128, 3));
+		TEST_CHECK(native.mapNum == 1 && native.unmapNum == 1);
+		TEST_CHECK(ring.data[1024] == 3 && ring.data[1024 + 127] == 3 && ring.data[1024 + 128] != 3);
+		TEST_CHECK(record.GetStats().uploadBytes == 128);
+
+		// ݒ͏ȗ
+		DrawFrame(&cache, 10, &vs, &ring);
+		TEST_CHECK(native.drawNum == 10);
+		TEST_CHECK(native.pVS == &vs);
+		TEST_CHECK(cache.GetStats().filteredNum == 9);
+	}
+
+	//--- L^čĐ
+	{
+		RenderContextList list;
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		TEST_CHECK(list.Map(&ring, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped) == E_NOTIMPL);
+		TEST_CHECK(SUCCEEDED(list.Map(&ring, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)));
+		memset(static_cast<char*>(mapped.pData) + 2048, 4, 32);
+		list.UnmapRange(&ring, 0, 2048, 32);
+		DrawFrame(&list, 3, &vs, &ring);
+		TEST_CHECK(list.GetStats().uploadBytes == 32);
+		TEST_CHECK(list.GetStats().drawNum == 3);
+
+		// ͈͕Đ̓ʒu֏܂
+		FakeContext native;
+		RenderContextD3D11 d3d(&native);
+		RenderContextRecord record(&d3d);
+		memset(ring.data.data(), 0, ring.data.size());
+		list.Execute(&record);
+		TEST_CHECK(native.drawNum == 3 && native.mapNum == 1);
+		TEST_CHECK(ring.data[2047] == 0 && ring.data[2048] == 4 && ring.data[2048 + 31] == 4 && ring.data[2048 + 32] == 0);
+		TEST_CHECK(record.GetStats().uploadBytes == 32);
+		TEST_CHECK(record.GetStats().drawNum == 3);
+	}
+
+	//--- ̂ȂR}hɂL^̍Đ
+	{
+		RenderContextList list;
+		list.ClearState();
+		FakeContext native;
+		RenderContextD3D11 d3d(&native);
+		list.Execute(&d3d);
+		TEST_CHECK(native.clearNum == 1 && native.stateNum == 0);
+
+		DrawFrame(&list, 2, &vs, &ring);
+		list.ClearState();
+		list.Execute(&d3d);
+		TEST_CHECK(native.clearNum == 3 && native.drawNum == 2);
+	}
+
+	//--- v(1t[10000`
+	const UINT DRAW_NUM = 10000;
+	RenderContextRecord headless;
+	RenderContextCache headlessCache(&headless);
+	double recordMs = TestMeasure(10, [&]() {
+		headless.Clear();
+		DrawFrame(&headlessCache, DRAW_NUM, &vs, &ring);
+	});
+	TEST_CHECK(headless.GetStats().drawNum == DRAW_NUM);
+
+	RenderContextList list;
+	double listMs = TestMeasure(10, [&]() {
+		list.Clear();
+		DrawFrame(&list, DRAW_NUM, &vs, &ring);
+	});
+	FakeContext native;
+	RenderContextD3D11 d3d(&native);
+	double executeMs = TestMeasure(10, [&]() {
+		list.Execute(&d3d);
+	});
+
+	printf("RenderContext: %u draws per frame\n", DRAW_NUM);
+	printf("  record (headless) : %.3f ms, %u commands\n", recordMs, headless.GetStats().commandNum);
+	printf("  list record       : %.3f ms, %llu bytes\n", listMs, static_cast<unsigned long long>(list.GetStats().streamBytes));
+	printf("  list execute      : %.3f ms\n", executeMs);
+
+	printf("TestRenderContext: OK\n");
+	return 0;
+}
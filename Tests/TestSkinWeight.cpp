@@ -0,0 +1,167 @@
+// _EFCg쐬̃eXgƁAq[vmۉ񐔂̌v
+// ύXO(_Ƃstd::vector)ƕύX(ArenaƋl߂z)œʂɂȂ邱ƂmFA
+// 50000_̃XLbVϊۂ̊mۉ񐔂ƎԂr
+#include "TestCommon.h"
+#include "SkinWeight.h"
+#include <assimp/mesh.h>
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <new>
+#include <random>
+#include <vector>
+
+//--- q[vmۉ񐔂̌v
+static std::atomic<size_t> g_allocNum(0);
+void* operator new(size_t size)
+{
+	++g_allocNum;
+	void* p = malloc(size ? size : 1);
+	if (!p) { throw std::bad_alloc(); }
+	return p;
+}
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+// ύXOModel::MakeWeightƓ
+static void MakeWeightVector(const aiMesh* pMesh, std::vector<SkinWeight::Weight>* pOut)
+{
+	struct WeightPair
+	{
+		unsigned int idx;
+		float weight;
+	};
+	std::vector<std::vector<WeightPair>> weights;
+	weights.resize(pMesh->mNumVertices);
+	for (unsigned int boneIdx = 0; boneIdx < pMesh->mNumBones; ++boneIdx)
+	{
+		const aiBone* assimpBone = pMesh->mBones[boneIdx];
+		for (unsigned int i = 0; i < assimpBone->mNumWeights; ++i)
+		{
+			aiVertexWeight weight = assimpBone->mWeights[i];
+			weights[weight.mVertexId].push_back({ boneIdx, weight.mWeight });
+		}
+	}
+	pOut->assign(pMesh->mNumVertices, SkinWeight::Weight());
+	for (size_t i = 0; i < weights.size(); ++i)
+	{
+		if (weights[i].size() >= 4)
+		{
+			std::sort(weights[i].begin(), weights[i].end(), [](WeightPair& a, WeightPair& b) {
+				return a.weight > b.weight;
+			});
+			float total = 0.0f;
+			for (int j = 0; j < 4; ++j)
+				total += weights[i][j].weight;
+			for (int j = 0; j < 4; ++j)
+				weights[i][j].weight /= total;
+		}
+		for (size_t j = 0; j < weights[i].size() && j < 4; ++j)
+		{
+			(*pOut)[i].index[j] = weights[i][j].idx;
+			(*pOut)[i].weight[j] = weights[i][j].weight;
+		}
+	}
+}
+
+// _Ƃ1`6{̃{[e郁bV쐬
+static aiMesh* CreateMesh(unsigned int vtxNum, unsigned int boneNum)
+{
+	std::mt19937 rand(1);
+	std::vector<std::vector<aiVertexWeight>> boneWeights(boneNum);
+	for (unsigned int i = 0; i < vtxNum; ++i)
+	{
+		unsigned int num = 1 + rand() % 6;
+		unsigned int first = rand() % boneNum;
+		for (unsigned int j = 0; j < num; ++j)
+		{
+			// בւ̌ʂӂɂȂ悤d݂͏dȂ
+			float weight = 0.05f + 0.15f * j + (rand() % 1000) * 1e-5f;
+			boneWeights[(first + j * 7) % boneNum].push_back(aiVertexWeight(i, weight));
+		}
+	}
+
+	aiMesh* pMesh = new aiMesh();
+	pMesh->mNumVertices = vtxNum;
+	pMesh->mNumBones = boneNum;
+	pMesh->mBones = new aiBone*[boneNum];
+	for (unsigned int i = 0; i < boneNum; ++i)
+	{
+		aiBone* pBone = new aiBone();
+		pBone->mNumWeights = static_cast<unsigned int>(boneWeights[i].size());
+		pBone->mWeights = new aiVertexWeight[pBone->mNumWeights];
+		std::copy(boneWeights[i].begin(), boneWeights[i].end(), pBone->mWeights);
+		pMesh->mBones[i] = pBone;
+	}
+	return pMesh;
+}
+
+int main()
+{
+	const unsigned int VTX_NUM = 50000;
+	const unsigned int BONE_NUM = 64;
+	aiMesh* pMesh = CreateMesh(VTX_NUM, BONE_NUM);
+
+	// ύXO
+	size_t allocStart = g_allocNum;
+	std::vector<SkinWeight::Weight> expect;
+	MakeWeightVector(pMesh, &expect);
+	size_t vectorAllocNum = g_allocNum - allocStart;
+
+	// ύX(Model::LoadƓǂݍݑŜňArenag
+	allocStart = g_allocNum;
+	Arena arena;
+	const SkinWeight::Weight* pWeights = SkinWeight::Make(&arena, pMesh, nullptr);
+	size_t arenaAllocNum = g_allocNum - allocStart;
+	TEST_CHECK(arenaAllocNum == arena.GetAllocNum());
+
+	// ʂ̔r
+	for (unsigned int i = 0; i < VTX_NUM; ++i)
+	{
+		float total = 0.0f;
+		for (int j = 0; j < 4; ++j)
+		{
+			TEST_CHECK(pWeights[i].index[j] == expect[i].index[j]);
+			TEST_CHECK(fabsf(pWeights[i].weight[j] - expect[i].weight[j]) < 1e-6f);
+			total += pWeights[i].weight[j];
+		}
+		TEST_CHECK(total > 0.0f);
+	}
+
+	// gpȂ{[͖
+	bool valid[BONE_NUM];
+	std::fill(valid, valid + BONE_NUM, true);
+	valid[3] = false;
+	Arena arena2;
+	const SkinWeight::Weight* pSkip = SkinWeight::Make(&arena2, pMesh, valid);
+	for (unsigned int i = 0; i < VTX_NUM; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+			TEST_CHECK(pSkip[i].weight[j] == 0.0f || pSkip[i].index[j] != 3);
+	}
+
+	// 
+	double vectorMs = TestMeasure(5, [&]() {
+		std::vector<SkinWeight::Weight> out;
+		MakeWeightVector(pMesh, &out);
+	});
+	double arenaMs = TestMeasure(5, [&]() {
+		Arena temp;
+		SkinWeight::Make(&temp, pMesh, nullptr);
+	});
+
+	printf("SkinWeight: %u vertices, %u bones\n", VTX_NUM, BONE_NUM);
+	printf("  vector per vertex : %7zu allocations, %.2f ms\n", vectorAllocNum, vectorMs);
+	printf("  arena + offsets   : %7zu allocations, %.2f ms\n", arenaAllocNum, arenaMs);
+	TEST_CHECK(arenaAllocNum * 100 < vectorAllocNum);
+
+	delete pMesh;
+	printf("TestSkinWeight: OK\n");
+	return 0;
+}
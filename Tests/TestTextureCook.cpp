@@ -0,0 +1,329 @@
+// eNX`̎Oϊ̃eXgƌv
+// ~bv}bv(K}AAt@ATCY)AubNǩ덷ADDS̃wb_[ƎʒlmFA
+// 1024x1024̉摜̕ϊԂv
+#include "TestCommon.h"
+#include "TextureCook.h"
+#include <math.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+//--- kubN̓WJ(4x4sNZARGBA8
+static void Decode565(uint16_t c, int* pRGB)
+{
+	int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+	pRGB[0] = (r << 3) | (r >> 2);
+	pRGB[1] = (g << 2) | (g >> 4);
+	pRGB[2] = (b << 3) | (b >> 2);
+}
+// BC1(isBC3: BC3̐FƂēWJAAt@͏Ȃ
+static void DecodeBC1(const uint8_t* pBlock, uint8_t out[16][4], bool isBC3)
+{
+	uint16_t c0 = pBlock[0] | (pBlock[1] << 8);
+	uint16_t c1 = pBlock[2] | (pBlock[3] << 8);
+	int color[4][4];
+	Decode565(c0, color[0]);
+	Decode565(c1, color[1]);
+	color[0][3] = color[1][3] = 255;
+	for (int c = 0; c < 3; ++c)
+	{
+		if (c0 > c1 || isBC3)
+		{
+			color[2][c] = (2 * color[0][c] + color[1][c]) / 3;
+			color[3][c] = (color[0][c] + 2 * color[1][c]) / 3;
+		}
+		else
+		{
+			color[2][c] = (color[0][c] + color[1][c]) / 2;
+			color[3][c] = 0;
+		}
+	}
+	color[2][3] = 255;
+	color[3][3] = (c0 > c1 || isBC3) ? 255 : 0;
+
+	uint32_t bits = pBlock[4] | (pBlock[5] << 8) | (pBlock[6] << 16) | (static_cast<uint32_t>(pBlock[7]) << 24);
+	int channelNum = isBC3 ? 3 : 4;
+	for (int i = 0; i < 16; ++i)
+	{
+		int index = (bits >> (i * 2)) & 3;
+		for (int c = 0; c < channelNum; ++c)
+			out[i][c] = static_cast<uint8_t>(color[index][c]);
+	}
+}
+// BC3̃At@
+static void DecodeBC3Alpha(const uint8_t* pBlock, uint8_t out[16][4])
+{
+	int a0 = pBlock[0], a1 = pBlock[1];
+	int alpha[8] = { a0, a1 };
+	if (a0 > a1)
+	{
+		for (int i = 1; i < 7; ++i)
+			alpha[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+	}
+	else
+	{
+		for (int i = 1; i < 5; ++i)
+			alpha[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+		alpha[6] = 0;
+		alpha[7] = 255;
+	}
+	uint64_t bits = 0;
+	for (int i = 0; i < 6; ++i)
+		bits |= static_cast<uint64_t>(pBlock[2 + i]) << (i * 8);
+	for (int i = 0; i < 16; ++i)
+		out[i][3] = static_cast<uint8_t>(alpha[(bits >> (i * 3)) & 7]);
+}
+// BC7([h6̂
+static bool DecodeBC7(const uint8_t* pBlock, uint8_t out[16][4])
+{
+	static const int WEIGHT[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	int pos = 0;
+	auto read = [&](int num) {
+		uint32_t value = 0;
+		for (int i = 0; i < num; ++i, ++pos)
+			value |= ((pBlock[pos >> 3] >> (pos & 7)) & 1u) << i;
+		return static_cast<int>(value);
+	};
+	if (read(7) != 64) { return false; }
+	int endpoint[2][4];
+	for (int c = 0; c < 4; ++c)
+	{
+		endpoint[0][c] = read(7) << 1;
+		endpoint[1][c] = read(7) << 1;
+	}
+	int p0 = read(1), p1 = read(1);
+	for (int c = 0; c < 4; ++c)
+	{
+		endpoint[0][c] |= p0;
+		endpoint[1][c] |= p1;
+	}
+	for (int i = 0; i < 16; ++i)
+	{
+		int w = WEIGHT[read(i == 0 ? 3 : 4)];
+		for (int c = 0; c < 4; ++c)
+			out[i][c] = static_cast<uint8_t>(((64 - w) * endpoint[0][c] + w * endpoint[1][c] + 32) >> 6);
+	}
+	return pos == 128;
+}
+
+// kOƂ̌덷(PSNRAchannelNum: r`l
+static double CalcPSNR(const TextureCook::Image& src, const TextureCook::Image& blocks, TextureCook::Format format, int channelNum)
+{
+	uint32_t blockX = (src.width + 3) / 4;
+	uint32_t blockY = (src.height + 3) / 4;
+	uint32_t blockSize = TextureCook::GetBlockSize(format);
+	TEST_CHECK(blocks.data.size() == static_cast<size_t>(blockX) * blockY * blockSize);
+	double error = 0.0;
+	size_t num = 0;
+	for (uint32_t by = 0; by < blockY; ++by)
+	{
+		for (uint32_t bx = 0; bx < blockX; ++bx)
+		{
+			const uint8_t* pBlock = &blocks.data[(by * blockX + bx) * blockSize];
+			uint8_t decoded[16][4];
+			switch (format)
+			{
+			case TextureCook::FORMAT_BC1:	DecodeBC1(pBlock, decoded, false);	break;
+			case TextureCook::FORMAT_BC3:	DecodeBC3Alpha(pBlock, decoded);	DecodeBC1(pBlock + 8, decoded, true);	break;
+			default:						TEST_CHECK(DecodeBC7(pBlock, decoded));	break;
+			}
+			for (int i = 0; i < 16; ++i)
+			{
+				uint32_t x = bx * 4 + (i & 3);
+				uint32_t y = by * 4 + (i >> 2);
+				if (x >= src.width || y >= src.height) { continue; }
+				const uint8_t* pSrc = &src.data[(y * src.width + x) * 4];
+				for (int c = 0; c < channelNum; ++c)
+				{
+					double diff = static_cast<double>(pSrc[c]) - decoded[i][c];
+					error += diff * diff;
+					++num;
+				}
+			}
+		}
+	}
+	if (error == 0.0) { return 100.0; }
+	return 10.0 * log10(255.0 * 255.0 / (error / num));
+}
+
+// Ȃ߂炩ȐF̕ωƔ̎s͗lAmCY܂މ摜
+static std::vector<uint8_t> CreateImage(uint32_t width, uint32_t height, bool hasAlpha)
+{
+	std::mt19937 rand(1);
+	std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			uint8_t* p = &image[(static_cast<size_t>(y) * width + x) * 4];
+			p[0] = static_cast<uint8_t>(128 + 127 * sinf(x * 0.05f));
+			p[1] = static_cast<uint8_t>(y * 255 / height);
+			p[2] = static_cast<uint8_t>(128 + 127 * cosf((x + y) * 0.03f));
+			p[3] = hasAlpha && ((x / 32 + y / 32) & 1) ? static_cast<uint8_t>(x * 255 / width) : 255;
+			if ((x / 8 + y / 8) % 7 == 0)
+				p[0] = static_cast<uint8_t>(rand() & 0xff);
+		}
+	}
+	return image;
+}
+
+int main()
+{
+	//--- ~bv}bv
+	{
+		// 1x1܂ō쐬Aei͔(͐؂̂āAŏ1
+		std::vector<uint8_t> odd(7 * 5 * 4, 200);
+		std::vector<TextureCook::Image> mips;
+		TextureCook::GenerateMips(odd.data(), 7, 5, true, &mips);
+		const uint32_t SIZE[][2] = { { 7, 5 }, { 3, 2 }, { 1, 1 } };
+		TEST_CHECK(mips.size() == 3);
+		for (size_t i = 0; i < mips.size(); ++i)
+		{
+			TEST_CHECK(mips[i].width == SIZE[i][0] && mips[i].height == SIZE[i][1]);
+			TEST_CHECK(mips[i].data.size() == mips[i].width * mips[i].height * 4);
+			TEST_CHECK(mips[i].data[0] == 200);
+		}
+		TEST_CHECK(mips[0].data == odd);
+
+		// ̎s͗l(K}lƒԂ128薾邢
+		std::vector<uint8_t> checker(4 * 4 * 4);
+		for (int i = 0; i < 16; ++i)
+		{
+			uint8_t v = ((i & 1) ^ ((i >> 2) & 1)) ? 255 : 0;
+			checker[i * 4 + 0] = checker[i * 4 + 1] = checker[i * 4 + 2] = v;
+			checker[i * 4 + 3] = 255;
+		}
+		TextureCook::GenerateMips(checker.data(), 4, 4, true, &mips);
+		TEST_CHECK(mips.size() == 3);
+		TEST_CHECK(abs(mips[1].data[0] - 188) <= 1);
+		TextureCook::GenerateMips(checker.data(), 4, 4, false, &mips);
+		TEST_CHECK(abs(mips[1].data[0] - 128) <= 1);
+
+		// ȃsNZ̐F͍Ȃ
+		uint8_t alpha[2 * 2 * 4] = {
+			255, 0, 0, 255,		0, 255, 0, 0,
+			255, 0, 0, 255,		0, 255, 0, 0,
+		};
+		TextureCook::GenerateMips(alpha, 2, 2, true, &mips);
+		TEST_CHECK(mips[1].data[0] == 255 && mips[1].data[1] == 0 && mips[1].data[2] == 0);
+		TEST_CHECK(abs(mips[1].data[3] - 128) <= 1);
+	}
+
+	//--- ubNk
+	{
+		const uint32_t WIDTH = 256, HEIGHT = 128;
+		std::vector<uint8_t> opaque = CreateImage(WIDTH, HEIGHT, false);
+		std::vector<uint8_t> alpha = CreateImage(WIDTH, HEIGHT, true);
+		TEST_CHECK(!TextureCook::HasAlpha(opaque.data(), WIDTH, HEIGHT));
+		TEST_CHECK(TextureCook::HasAlpha(alpha.data(), WIDTH, HEIGHT));
+		TextureCook::Image src = { WIDTH, HEIGHT, opaque };
+		TextureCook::Image srcAlpha = { WIDTH, HEIGHT, alpha };
+		TextureCook::Image blocks;
+
+		TextureCook::Compress(src, TextureCook::FORMAT_BC1, &blocks);
+		TEST_CHECK(CalcPSNR(src, blocks, TextureCook::FORMAT_BC1, 3) > 30.0);
+		TextureCook::Compress(srcAlpha, TextureCook::FORMAT_BC3, &blocks);
+		TEST_CHECK(CalcPSNR(srcAlpha, blocks, TextureCook::FORMAT_BC3, 4) > 30.0);
+		TextureCook::Compress(srcAlpha, TextureCook::FORMAT_BC7, &blocks);
+		TEST_CHECK(CalcPSNR(srcAlpha, blocks, TextureCook::FORMAT_BC7, 4) > 33.0);
+
+		// 4̔{ɖȂ[̃ubN
+		TextureCook::Image small = { 6, 3, std::vector<uint8_t>(alpha.begin(), alpha.begin() + 6 * 3 * 4) };
+		TextureCook::Compress(small, TextureCook::FORMAT_BC7, &blocks);
+		TEST_CHECK(CalcPSNR(small, blocks, TextureCook::FORMAT_BC7, 4) > 25.0);
+
+		// PF̃ubN͂قڂ̂܂
+		std::vector<uint8_t> flat(16 * 4);
+		for (int i = 0; i < 16; ++i)
+		{
+			flat[i * 4 + 0] = 10;	flat[i * 4 + 1] = 200;
+			flat[i * 4 + 2] = 77;	flat[i * 4 + 3] = 255;
+		}
+		TextureCook::Image flatSrc = { 4, 4, flat };
+		const TextureCook::Format FORMAT[] = { TextureCook::FORMAT_BC1, TextureCook::FORMAT_BC3, TextureCook::FORMAT_BC7 };
+		for (TextureCook::Format format : FORMAT)
+		{
+			TextureCook::Compress(flatSrc, format, &blocks);
+			TEST_CHECK(CalcPSNR(flatSrc, blocks, format, 4) > 40.0);
+		}
+	}
+
+	//--- DDS
+	{
+		std::vector<uint8_t> image(96 * 40 * 4, 0x80);
+		std::vector<uint8_t> dds;
+		const TextureCook::Format FORMAT[] = { TextureCook::FORMAT_RGBA8, TextureCook::FORMAT_BC1, TextureCook::FORMAT_BC3, TextureCook::FORMAT_BC7 };
+		for (TextureCook::Format format : FORMAT)
+		{
+			for (int srgb = 0; srgb < 2; ++srgb)
+			{
+				uint64_t key = TextureCook::MakeKey("Assets/Model/tex.png", format, srgb != 0);
+				TEST_CHECK(TextureCook::Cook(image.data(), 96, 40, format, true, srgb != 0, &dds, key) == format);
+				TextureCook::DDSInfo info;
+				TEST_CHECK(TextureCook::ReadDDSHeader(dds.data(), dds.size(), &info));
+				TEST_CHECK(info.width == 96 && info.height == 40 && info.mipNum == 7);
+				TEST_CHECK(info.format == format && info.isSRGB == (srgb != 0));
+				TEST_CHECK(info.key == key);
+				TEST_CHECK(TextureCook::GetMipOffset(info, 0) == TextureCook::DDS_HEADER_SIZE);
+				TEST_CHECK(TextureCook::GetMipOffset(info, info.mipNum) == dds.size());
+				TEST_CHECK(TextureCook::GetMipSize(info, 1) == TextureCook::GetRowPitch(format, 48) * (TextureCook::GetBlockSize(format) ? 5 : 20));
+			}
+		}
+
+		// I(sBC1ABC3)A4̔{łȂRGBA8
+		TEST_CHECK(TextureCook::Cook(image.data(), 96, 40, TextureCook::FORMAT_AUTO, true, false, &dds) == TextureCook::FORMAT_BC3);
+		std::vector<uint8_t> opaque = CreateImage(96, 40, false);
+		TEST_CHECK(TextureCook::Cook(opaque.data(), 96, 40, TextureCook::FORMAT_AUTO, true, false, &dds) == TextureCook::FORMAT_BC1);
+		TEST_CHECK(TextureCook::Cook(opaque.data(), 94, 40, TextureCook::FORMAT_BC7, true, false, &dds) == TextureCook::FORMAT_RGBA8);
+		TextureCook::DDSInfo info;
+		TEST_CHECK(TextureCook::ReadDDSHeader(dds.data(), dds.size(), &info));
+		TEST_CHECK(info.format == TextureCook::FORMAT_RGBA8 && info.key == 0);
+
+		// ꂽwb_[
+		TEST_CHECK(!TextureCook::ReadDDSHeader(dds.data(), TextureCook::DDS_HEADER_SIZE - 1, &info));
+		dds[0] = 'X';
+		TEST_CHECK(!TextureCook::ReadDDSHeader(dds.data(), dds.size(), &info));
+	}
+
+	//--- ϊς݃t@C̎ʒl
+	{
+		// ؂A啶Ə͋ʂȂ
+		TEST_CHECK(TextureCook::HashPath("Assets/Model/Tex.png") == TextureCook::HashPath("assets\\model\\tex.PNG"));
+		// ؂uƓɂȂpXʂ
+		TEST_CHECK(TextureCook::HashPath("a/b_c.png") != TextureCook::HashPath("a_b/c.png"));
+		TEST_CHECK(TextureCook::HashPath("a/b.png") != TextureCook::HashPath("a:b.png"));
+
+		const char* PATH = "Assets/Model/tex.png";
+		uint64_t key = TextureCook::MakeKey(PATH, TextureCook::FORMAT_AUTO, false);
+		TEST_CHECK(key != 0);
+		TEST_CHECK(key == TextureCook::MakeKey("assets\\model\\tex.png", TextureCook::FORMAT_AUTO, false));
+		TEST_CHECK(key != TextureCook::MakeKey(PATH, TextureCook::FORMAT_AUTO, true));
+		TEST_CHECK(key != TextureCook::MakeKey(PATH, TextureCook::FORMAT_BC7, false));
+		TEST_CHECK(key != TextureCook::MakeKey("Assets/Model/tex2.png", TextureCook::FORMAT_AUTO, false));
+	}
+
+	//--- v(1024x1024
+	const uint32_t SIZE = 1024;
+	std::vector<uint8_t> image = CreateImage(SIZE, SIZE, true);
+	std::vector<TextureCook::Image> mips;
+	double mipMs = TestMeasure(3, [&]() {
+		TextureCook::GenerateMips(image.data(), SIZE, SIZE, true, &mips);
+	});
+	printf("TextureCook: %ux%u, %zu mips\n", SIZE, SIZE, mips.size());
+	printf("  mips  : %.2f ms\n", mipMs);
+	const TextureCook::Format FORMAT[] = { TextureCook::FORMAT_BC1, TextureCook::FORMAT_BC3, TextureCook::FORMAT_BC7 };
+	const char* NAME[] = { "BC1", "BC3", "BC7" };
+	for (int i = 0; i < 3; ++i)
+	{
+		TextureCook::Image blocks;
+		double ms = TestMeasure(3, [&]() {
+			for (const TextureCook::Image& mip : mips)
+				TextureCook::Compress(mip, FORMAT[i], &blocks);
+		});
+		TextureCook::Compress(mips[0], FORMAT[i], &blocks);
+		printf("  %s   : %.2f ms, %.2f dB\n", NAME[i], ms, CalcPSNR(mips[0], blocks, FORMAT[i], i == 0 ? 3 : 4));
+	}
+
+	printf("TestTextureCook: OK\n");
+	return 0;
+}